@@ -0,0 +1,150 @@
+/// \file ChargedParticleTracking/calo_block_grid.cc
+
+// Ourselves:
+#include <ChargedParticleTracking/calo_block_grid.h>
+
+// Standard library:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    namespace {
+      /// Largest number of cells along an axis
+      const int kMaxCells = 256;
+    }
+
+    void calo_block_grid::clear()
+    {
+      _blocks_.clear();
+      _cell_offsets_.clear();
+      _cell_blocks_.clear();
+      _nx_ = 0;
+      _ny_ = 0;
+      return;
+    }
+
+    uint32_t calo_block_grid::add_block(double xmin_, double xmax_, double ymin_, double ymax_)
+    {
+      _blocks_.push_back(bounds{xmin_, xmax_, ymin_, ymax_});
+      return _blocks_.size() - 1;
+    }
+
+    std::size_t calo_block_grid::size() const
+    {
+      return _blocks_.size();
+    }
+
+    int calo_block_grid::_cell_index_(double coord_, double origin_, double cell_size_, int ncells_)
+    {
+      double index = std::floor((coord_ - origin_) / cell_size_);
+      if (index < 0.0) return 0;
+      if (index >= ncells_) return ncells_ - 1;
+      return (int) index;
+    }
+
+    void calo_block_grid::build()
+    {
+      _cell_offsets_.clear();
+      _cell_blocks_.clear();
+      _nx_ = 0;
+      _ny_ = 0;
+      if (_blocks_.empty()) return;
+
+      double xmin = std::numeric_limits<double>::max();
+      double ymin = xmin;
+      double xmax = std::numeric_limits<double>::lowest();
+      double ymax = xmax;
+      double meanSize = 0.0;
+      for (const bounds & b : _blocks_) {
+        xmin = std::min(xmin, b.xmin);
+        xmax = std::max(xmax, b.xmax);
+        ymin = std::min(ymin, b.ymin);
+        ymax = std::max(ymax, b.ymax);
+        meanSize += std::max(b.xmax - b.xmin, b.ymax - b.ymin);
+      }
+      meanSize /= _blocks_.size();
+      // Cells about the size of a block, so that a block overlaps few cells:
+      _cell_size_ = std::max({meanSize,
+                              (xmax - xmin) / kMaxCells,
+                              (ymax - ymin) / kMaxCells,
+                              std::numeric_limits<double>::min()});
+      _x0_ = xmin;
+      _y0_ = ymin;
+      _nx_ = std::max(1, (int) std::ceil((xmax - xmin) / _cell_size_));
+      _ny_ = std::max(1, (int) std::ceil((ymax - ymin) / _cell_size_));
+      _nx_ = std::min(_nx_, kMaxCells);
+      _ny_ = std::min(_ny_, kMaxCells);
+
+      // Count then fill the blocks of each cell:
+      std::vector<uint32_t> counts(_nx_ * _ny_ + 1, 0);
+      for (const bounds & b : _blocks_) {
+        int ix0 = _cell_index_(b.xmin, _x0_, _cell_size_, _nx_);
+        int ix1 = _cell_index_(b.xmax, _x0_, _cell_size_, _nx_);
+        int iy0 = _cell_index_(b.ymin, _y0_, _cell_size_, _ny_);
+        int iy1 = _cell_index_(b.ymax, _y0_, _cell_size_, _ny_);
+        for (int ix = ix0; ix <= ix1; ix++) {
+          for (int iy = iy0; iy <= iy1; iy++) {
+            counts[ix * _ny_ + iy + 1]++;
+          }
+        }
+      }
+      _cell_offsets_.assign(counts.size(), 0);
+      for (std::size_t i = 1; i < counts.size(); i++) {
+        _cell_offsets_[i] = _cell_offsets_[i - 1] + counts[i];
+      }
+      _cell_blocks_.resize(_cell_offsets_.back());
+      std::vector<uint32_t> fill(_cell_offsets_.begin(), _cell_offsets_.end() - 1);
+      for (uint32_t iblock = 0; iblock < _blocks_.size(); iblock++) {
+        const bounds & b = _blocks_[iblock];
+        int ix0 = _cell_index_(b.xmin, _x0_, _cell_size_, _nx_);
+        int ix1 = _cell_index_(b.xmax, _x0_, _cell_size_, _nx_);
+        int iy0 = _cell_index_(b.ymin, _y0_, _cell_size_, _ny_);
+        int iy1 = _cell_index_(b.ymax, _y0_, _cell_size_, _ny_);
+        for (int ix = ix0; ix <= ix1; ix++) {
+          for (int iy = iy0; iy <= iy1; iy++) {
+            _cell_blocks_[fill[ix * _ny_ + iy]++] = iblock;
+          }
+        }
+      }
+      return;
+    }
+
+    void calo_block_grid::find_blocks(double x_, double y_, double r_,
+                                      std::vector<uint32_t> & indexes_) const
+    {
+      indexes_.clear();
+      if (_nx_ == 0) return;
+      // Cells overlapping the square around the point (clamping keeps the border
+      // cells, which hold every block outside the square anyway):
+      int ix0 = _cell_index_(x_ - r_, _x0_, _cell_size_, _nx_);
+      int ix1 = _cell_index_(x_ + r_, _x0_, _cell_size_, _nx_);
+      int iy0 = _cell_index_(y_ - r_, _y0_, _cell_size_, _ny_);
+      int iy1 = _cell_index_(y_ + r_, _y0_, _cell_size_, _ny_);
+      const double r2 = r_ * r_;
+      for (int ix = ix0; ix <= ix1; ix++) {
+        for (int iy = iy0; iy <= iy1; iy++) {
+          const int icell = ix * _ny_ + iy;
+          for (uint32_t i = _cell_offsets_[icell]; i < _cell_offsets_[icell + 1]; i++) {
+            const bounds & b = _blocks_[_cell_blocks_[i]];
+            // Distance from the point to the bounding box:
+            const double dx = std::max({b.xmin - x_, 0.0, x_ - b.xmax});
+            const double dy = std::max({b.ymin - y_, 0.0, y_ - b.ymax});
+            if (dx * dx + dy * dy <= r2) {
+              indexes_.push_back(_cell_blocks_[i]);
+            }
+          }
+        }
+      }
+      // Blocks overlapping several cells are found several times:
+      std::sort(indexes_.begin(), indexes_.end());
+      indexes_.erase(std::unique(indexes_.begin(), indexes_.end()), indexes_.end());
+      return;
+    }
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
@@ -0,0 +1,77 @@
+/// \file ChargedParticleTracking/calo_block_grid.h
+/*
+ * Description:
+ *
+ *   Uniform grid over the bounding boxes of the calorimeter blocks in the
+ *   XY plane of the world frame, used to select the blocks that a track
+ *   extrapolation can reach.
+ *
+ */
+
+#ifndef FALAISE_CHARGEDPARTICLETRACKING_PLUGIN_RECONSTRUCTION_CALO_BLOCK_GRID_H
+#define FALAISE_CHARGEDPARTICLETRACKING_PLUGIN_RECONSTRUCTION_CALO_BLOCK_GRID_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace snemo {
+
+  namespace reconstruction {
+
+    /// \brief Uniform grid of block bounding boxes in the XY plane
+    ///
+    /// Blocks are registered with their bounding box in the XY plane and
+    /// identified by their rank of registration. Each grid cell lists the
+    /// blocks overlapping it, so that the blocks near a point are found by
+    /// visiting the few cells around it rather than all the blocks.
+    class calo_block_grid
+    {
+    public:
+
+      /// Remove all blocks
+      void clear();
+
+      /// Register a block with its bounding box in the XY plane, return its index
+      uint32_t add_block(double xmin_, double xmax_, double ymin_, double ymax_);
+
+      /// Build the grid once all blocks are registered
+      void build();
+
+      /// Return the number of blocks
+      std::size_t size() const;
+
+      /// Return the indexes, in increasing order, of the blocks whose bounding
+      /// box is at a distance lower than r_ from the point (x_, y_)
+      void find_blocks(double x_, double y_, double r_, std::vector<uint32_t> & indexes_) const;
+
+    private:
+
+      /// Bounding box of a block
+      struct bounds
+      {
+        double xmin;
+        double xmax;
+        double ymin;
+        double ymax;
+      };
+
+      /// Return the cell index of a coordinate along an axis, clamped to the grid
+      static int _cell_index_(double coord_, double origin_, double cell_size_, int ncells_);
+
+      std::vector<bounds> _blocks_;        //!< Bounding boxes of the blocks
+      double _x0_ = 0.0;                   //!< X-origin of the grid
+      double _y0_ = 0.0;                   //!< Y-origin of the grid
+      double _cell_size_ = 1.0;            //!< Size of the square cells
+      int _nx_ = 0;                        //!< Number of cells along X
+      int _ny_ = 0;                        //!< Number of cells along Y
+      std::vector<uint32_t> _cell_offsets_; //!< First entry of each cell in _cell_blocks_
+      std::vector<uint32_t> _cell_blocks_;  //!< Blocks of all cells, cell by cell
+    };
+
+  }  // end of namespace reconstruction
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_CHARGEDPARTICLETRACKING_PLUGIN_RECONSTRUCTION_CALO_BLOCK_GRID_H
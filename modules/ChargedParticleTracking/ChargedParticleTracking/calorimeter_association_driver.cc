@@ -128,13 +128,13 @@ namespace snemo {
         const snedm::calibrated_calorimeter_hit & i_calo_hit = icalo->get();
         const geomtools::geom_id & a_current_gid = i_calo_hit.get_geom_id();
 
-        std::vector<geomtools::geom_id> neighbour_ids;
+        snemo::geometry::geom_id_range neighbour_ids;
         if (calo_locator.isCaloBlockInThisModule(a_current_gid)) {
-          neighbour_ids = calo_locator.getNeighbourGIDs(a_current_gid);
+          neighbour_ids = calo_locator.getNeighbourRange(a_current_gid);
         } else if (xcalo_locator.isCaloBlockInThisModule(a_current_gid)) {
-          neighbour_ids = xcalo_locator.getNeighbourGIDs(a_current_gid);
+          neighbour_ids = xcalo_locator.getNeighbourRange(a_current_gid);
         } else if (gveto_locator.isCaloBlockInThisModule(a_current_gid)) {
-          neighbour_ids = gveto_locator.getNeighbourGIDs(a_current_gid);
+          neighbour_ids = gveto_locator.getNeighbourRange(a_current_gid);
         }
 
         for (auto jcalo = std::next(icalo); jcalo != calorimeter_hits_.end(); ++jcalo) {
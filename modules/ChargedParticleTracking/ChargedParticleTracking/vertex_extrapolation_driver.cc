@@ -4,6 +4,9 @@
 #include <ChargedParticleTracking/vertex_extrapolation_driver.h>
 
 // Standard library:
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <sstream>
 
 // Third party:
@@ -273,6 +276,9 @@ namespace snemo {
       }
       DT_LOG_DEBUG(logPriority_, "Calorimeter block type = " << _caloBlockType_);
       DT_LOG_DEBUG(logPriority_, "Found " << _caloBlockGids_.size() << " main calo blocks (front)");
+      if (_effectiveCaloBlockBoxPtr_) {
+        _build_calo_block_grid_(_caloBlockGids_, *_effectiveCaloBlockBoxPtr_, _caloBlockGrid_);
+      }
    
       // Identify xcalo blocks:
       _xcaloBlockType_ = geomtools::geom_id::INVALID_TYPE;
@@ -310,6 +316,9 @@ namespace snemo {
       }
       DT_LOG_DEBUG(logPriority_, "X-calorimeter block type = " << _xcaloBlockType_);
       DT_LOG_DEBUG(logPriority_, "Found " << _xcaloBlockGids_.size() << " X-calo blocks");
+      if (_effectiveXcaloBlockBoxPtr_) {
+        _build_calo_block_grid_(_xcaloBlockGids_, *_effectiveXcaloBlockBoxPtr_, _xcaloBlockGrid_);
+      }
  
       // Identify gveto blocks:
       _gvetoBlockType_ = geomtools::geom_id::INVALID_TYPE;
@@ -328,6 +337,64 @@ namespace snemo {
       return;
     }
 
+    void vertex_extrapolation_driver::_build_calo_block_grid_(const std::vector<geomtools::geom_id> & block_gids_,
+                                                              const geomtools::box & effective_box_,
+                                                              calo_block_grid & grid_) const
+    {
+      grid_.clear();
+      const double hx = effective_box_.get_half_x();
+      const double hy = effective_box_.get_half_y();
+      const double hz = effective_box_.get_half_z();
+      for (const geomtools::geom_id & blockGid : block_gids_) {
+        const geomtools::placement & blockPlacement
+          = geoManager().get_mapping().get_geom_info(blockGid).get_world_placement();
+        // Bounding box of the corners of the effective block in the world frame:
+        double xmin = std::numeric_limits<double>::max();
+        double ymin = xmin;
+        double xmax = std::numeric_limits<double>::lowest();
+        double ymax = xmax;
+        for (int iCorner = 0; iCorner < 8; iCorner++) {
+          geomtools::vector_3d corner((iCorner & 1) ? hx : -hx,
+                                      (iCorner & 2) ? hy : -hy,
+                                      (iCorner & 4) ? hz : -hz);
+          geomtools::vector_3d worldCorner;
+          blockPlacement.child_to_mother(corner, worldCorner);
+          xmin = std::min(xmin, worldCorner.x());
+          xmax = std::max(xmax, worldCorner.x());
+          ymin = std::min(ymin, worldCorner.y());
+          ymax = std::max(ymax, worldCorner.y());
+        }
+        grid_.add_block(xmin, xmax, ymin, ymax);
+      }
+      grid_.build();
+      return;
+    }
+
+    double vertex_extrapolation_driver::_calo_block_search_radius_(double dist_ref_to_end_) const
+    {
+      // An accepted intercept is at most at the maximum XY-extrapolation length from the
+      // reference point (line) or from the last step of the helix finder, each of them
+      // being close to the end point:
+      return _max_calo_extrapolation_xy_length_ + 2 * dist_ref_to_end_ + _finder_step_
+        + 2 * _intercept_tolerance_;
+    }
+
+    void vertex_extrapolation_driver::_find_calo_blocks_(const calo_block_grid & grid_,
+                                                         std::size_t nblocks_,
+                                                         const geomtools::vector_3d & end_point_,
+                                                         double radius_,
+                                                         std::vector<uint32_t> & indexes_) const
+    {
+      if (grid_.size() != nblocks_) {
+        // No grid was built for these blocks, scan them all:
+        indexes_.resize(nblocks_);
+        std::iota(indexes_.begin(), indexes_.end(), 0);
+        return;
+      }
+      grid_.find_blocks(end_point_.x(), end_point_.y(), radius_, indexes_);
+      return;
+    }
+
     void vertex_extrapolation_driver::process(const snemo::datamodel::tracker_trajectory & trajectory_,
                                               snemo::datamodel::particle_track & particle_)
     {
@@ -406,10 +473,12 @@ namespace snemo {
         for (int iBlockType : blockTypes) {
           DT_LOG_DEBUG(logPrio, "Scanning block type=" << iBlockType << "...");
           const std::vector<geomtools::geom_id> * blockGidsPtr = nullptr;
+          const calo_block_grid * blockGridPtr = nullptr;
           snemo::geometry::vertex_info::category_type vtxType
             = snemo::geometry::vertex_info::CATEGORY_UNDEF;
           if (iBlockType == CALO_MAIN) {
             blockGidsPtr = &_caloBlockGids_;  // Main walls
+            blockGridPtr = &_caloBlockGrid_;
             vtxType = snemo::geometry::vertex_info::CATEGORY_ON_MAIN_CALORIMETER;
             DT_LOG_DEBUG(logPrio, "to main calo blocks");
             // Optimization for main walls:
@@ -423,6 +492,7 @@ namespace snemo {
             }
           } else if (iBlockType == CALO_XCALO) {
             blockGidsPtr = &_xcaloBlockGids_; // X-calo walls
+            blockGridPtr = &_xcaloBlockGrid_;
             vtxType = snemo::geometry::vertex_info::CATEGORY_ON_X_CALORIMETER;
             DT_LOG_DEBUG(logPrio, "to X-calo blocks");
           }    
@@ -550,7 +620,15 @@ namespace snemo {
             DT_LOG_DEBUG(logPrio, "Skip scanning process for blocks of type=" << iBlockType);
           } else {
             DT_LOG_DEBUG(logPrio, "Start scanning process for blocks of type=" << iBlockType);
-            for (uint32_t iBlock = 0; iBlock < blockGidsPtr->size(); iBlock++) {
+            // Only blocks close enough to the end point can have an accepted intercept:
+            std::vector<uint32_t> blockIndexes;
+            _find_calo_blocks_(*blockGridPtr,
+                               blockGidsPtr->size(),
+                               endPoint,
+                               _calo_block_search_radius_(distRef2End),
+                               blockIndexes);
+            DT_LOG_DEBUG(logPrio, "Number of blocks close to the end point=" << blockIndexes.size());
+            for (uint32_t iBlock : blockIndexes) {
               const geomtools::geom_id & blockGid = (*blockGidsPtr)[iBlock];
               if (blockGid.get(0) != _module_id_ or blockGid.get(1) != track_side_ ) {
                 // Reject blocks in other modules and sides:
@@ -775,10 +853,12 @@ namespace snemo {
         for (int iBlockType : blockTypes) {
           DT_LOG_DEBUG(logPrio, "Scanning block type=" << iBlockType << "...");
           const std::vector<geomtools::geom_id> * blockGidsPtr = nullptr;
+          const calo_block_grid * blockGridPtr = nullptr;
           snemo::geometry::vertex_info::category_type vtxType
             = snemo::geometry::vertex_info::CATEGORY_UNDEF;
           if (iBlockType == CALO_MAIN) {
             blockGidsPtr = &_caloBlockGids_;  // Main walls
+            blockGridPtr = &_caloBlockGrid_;
             vtxType = snemo::geometry::vertex_info::CATEGORY_ON_MAIN_CALORIMETER;
             // Optimization for main walls:
             if (refPoint.x() > 0.0 and direction.x() <= 0.0) {
@@ -791,6 +871,7 @@ namespace snemo {
             }
           } else if (iBlockType == CALO_XCALO) {
             blockGidsPtr = &_xcaloBlockGids_; // X-calo walls
+            blockGridPtr = &_xcaloBlockGrid_;
             vtxType = snemo::geometry::vertex_info::CATEGORY_ON_X_CALORIMETER;
           }    
           DT_LOG_DEBUG(logPrio, "Number of blocks to be scanned=" << blockGidsPtr->size());
@@ -866,7 +947,15 @@ namespace snemo {
           if (not process) {
             DT_LOG_DEBUG(logPrio, "Skip scanning process for blocks of type=" << iBlockType);
           } else {
-            for (uint32_t iBlock = 0; iBlock < blockGidsPtr->size(); iBlock++) {
+            // Only blocks close enough to the end point can have an accepted intercept:
+            std::vector<uint32_t> blockIndexes;
+            _find_calo_blocks_(*blockGridPtr,
+                               blockGidsPtr->size(),
+                               endPoint,
+                               _calo_block_search_radius_(distRef2End),
+                               blockIndexes);
+            DT_LOG_DEBUG(logPrio, "Number of blocks close to the end point=" << blockIndexes.size());
+            for (uint32_t iBlock : blockIndexes) {
               const geomtools::geom_id & blockGid = (*blockGidsPtr)[iBlock];
               if (blockGid.get(0) != _module_id_ or blockGid.get(1) != track_side_ ) {
                 // Reject blocks in other modules and sides:
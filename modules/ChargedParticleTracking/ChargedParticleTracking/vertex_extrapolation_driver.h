@@ -49,6 +49,7 @@
 #include "falaise/snemo/datamodels/line_trajectory_pattern.h"
 #include "falaise/snemo/datamodels/helix_trajectory_pattern.h"
 #include "falaise/snemo/geometry/utils.h"
+#include <ChargedParticleTracking/calo_block_grid.h>
 
 namespace geomtools {
   class manager;
@@ -136,6 +137,23 @@ namespace snemo {
       void _post_process_source_vertex_(snemo::geometry::vertex_info_list & src_vertexes_) const;
 
       void _post_process_calo_vertex_(snemo::geometry::vertex_info_list & calo_vertexes_) const;
+
+      /// Register the XY bounding boxes of some calo blocks with a given effective shape in a grid
+      void _build_calo_block_grid_(const std::vector<geomtools::geom_id> & block_gids_,
+                                   const geomtools::box & effective_box_,
+                                   calo_block_grid & grid_) const;
+
+      /// Return the radius around the end point of a track, in the XY plane, beyond which
+      /// no calo block intercept can be accepted
+      double _calo_block_search_radius_(double dist_ref_to_end_) const;
+
+      /// Return the indexes of the calo blocks to scan for a track end point, all the
+      /// blocks if they have no grid (no effective block shape)
+      void _find_calo_blocks_(const calo_block_grid & grid_,
+                              std::size_t nblocks_,
+                              const geomtools::vector_3d & end_point_,
+                              double radius_,
+                              std::vector<uint32_t> & indexes_) const;
       
     private:
       
@@ -200,6 +218,8 @@ namespace snemo {
       std::unique_ptr<geomtools::box> _effectiveCaloBlockBoxPtr2_;
       std::unique_ptr<geomtools::box> _effectiveXcaloBlockBoxPtr_;
       std::unique_ptr<geomtools::box> _effectiveXcaloBlockBoxPtr2_;
+      calo_block_grid _caloBlockGrid_;  //!< XY grid of the main calo blocks (indexes in _caloBlockGids_)
+      calo_block_grid _xcaloBlockGrid_; //!< XY grid of the X-calo blocks (indexes in _xcaloBlockGids_)
 
       // Specific dimensions about the positioning of main calo blocks (world frame)
       double _main_calo_y_first_;
@@ -0,0 +1,113 @@
+// Catch
+#include "catch.hpp"
+
+#include <ChargedParticleTracking/calo_block_grid.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+struct box_xy {
+  double xmin;
+  double xmax;
+  double ymin;
+  double ymax;
+};
+
+// Reference: scan all the blocks
+std::vector<uint32_t> scan_blocks(const std::vector<box_xy>& blocks, double x, double y,
+                                  double r) {
+  std::vector<uint32_t> indexes;
+  for (uint32_t i = 0; i < blocks.size(); i++) {
+    const box_xy& b = blocks[i];
+    const double dx = std::max({b.xmin - x, 0.0, x - b.xmax});
+    const double dy = std::max({b.ymin - y, 0.0, y - b.ymax});
+    if (dx * dx + dy * dy <= r * r) {
+      indexes.push_back(i);
+    }
+  }
+  return indexes;
+}
+}  // namespace
+
+TEST_CASE("Grid search agrees with a full scan", "") {
+  // Two walls of 20x13 blocks facing each other along X, as the main calorimeter,
+  // plus blocks of various sizes anywhere, some of them overlapping several cells
+  std::vector<box_xy> blocks;
+  for (double x0 : {-500.0, 450.0}) {
+    for (int col = 0; col < 20; col++) {
+      const double y0 = -2500.0 + 259.0 * col;
+      blocks.push_back({x0, x0 + 50.0, y0, y0 + 256.0});
+    }
+  }
+  std::mt19937_64 rng(1234);
+  std::uniform_real_distribution<double> position(-3000.0, 3000.0);
+  std::uniform_real_distribution<double> size(1.0, 800.0);
+  for (int i = 0; i < 200; i++) {
+    const double x0 = position(rng);
+    const double y0 = position(rng);
+    blocks.push_back({x0, x0 + size(rng), y0, y0 + size(rng)});
+  }
+
+  snemo::reconstruction::calo_block_grid grid;
+  for (const box_xy& b : blocks) {
+    grid.add_block(b.xmin, b.xmax, b.ymin, b.ymax);
+  }
+  grid.build();
+  REQUIRE(grid.size() == blocks.size());
+
+  std::uniform_real_distribution<double> query(-4000.0, 4000.0);
+  std::uniform_real_distribution<double> radius(0.0, 1500.0);
+  std::vector<uint32_t> indexes;
+  for (int i = 0; i < 5000; i++) {
+    const double x = query(rng);
+    const double y = query(rng);
+    const double r = radius(rng);
+    grid.find_blocks(x, y, r, indexes);
+    REQUIRE(indexes == scan_blocks(blocks, x, y, r));
+  }
+
+  // Far outside the grid, with a radius reaching it or not
+  grid.find_blocks(1.0e5, 0.0, 1.0e6, indexes);
+  REQUIRE(indexes.size() == blocks.size());
+  grid.find_blocks(1.0e5, 0.0, 10.0, indexes);
+  REQUIRE(indexes.empty());
+}
+
+TEST_CASE("Blocks at exactly the search radius are found", "") {
+  snemo::reconstruction::calo_block_grid grid;
+  REQUIRE(grid.add_block(0.0, 10.0, 0.0, 10.0) == 0);
+  REQUIRE(grid.add_block(20.0, 30.0, 0.0, 10.0) == 1);
+  REQUIRE(grid.add_block(0.0, 10.0, 40.0, 50.0) == 2);
+  grid.build();
+
+  std::vector<uint32_t> indexes;
+  // Point inside block 0, at 10 from block 1 and 30 from block 2
+  grid.find_blocks(10.0, 10.0, 10.0, indexes);
+  REQUIRE(indexes == std::vector<uint32_t>{0, 1});
+  grid.find_blocks(10.0, 10.0, 30.0, indexes);
+  REQUIRE(indexes == std::vector<uint32_t>{0, 1, 2});
+  // Corner distance: 3-4-5 triangle from the corner (30, 10) of block 1
+  grid.find_blocks(33.0, 14.0, 5.0, indexes);
+  REQUIRE(indexes == std::vector<uint32_t>{1});
+  grid.find_blocks(33.0, 14.0, 4.999, indexes);
+  REQUIRE(indexes.empty());
+}
+
+TEST_CASE("Empty or cleared grids find no block", "") {
+  snemo::reconstruction::calo_block_grid grid;
+  std::vector<uint32_t> indexes{7};
+  grid.find_blocks(0.0, 0.0, 1.0e9, indexes);
+  REQUIRE(indexes.empty());
+
+  grid.add_block(0.0, 1.0, 0.0, 1.0);
+  grid.build();
+  grid.find_blocks(0.0, 0.0, 1.0, indexes);
+  REQUIRE(indexes.size() == 1);
+  grid.clear();
+  REQUIRE(grid.size() == 0);
+  grid.find_blocks(0.0, 0.0, 1.0e9, indexes);
+  REQUIRE(indexes.empty());
+}
@@ -200,14 +200,14 @@ namespace snemo {
       const snemo::geometry::calo_locator  & calo_locator = base_gamma_builder::get_calo_locator();
       const snemo::geometry::xcalo_locator & xcalo_locator = base_gamma_builder::get_xcalo_locator();
       const snemo::geometry::gveto_locator & gveto_locator = base_gamma_builder::get_gveto_locator();
-      gid_list_type the_neighbours;
+      snemo::geometry::geom_id_range the_neighbours;
 
       if (calo_locator.isCaloBlockInThisModule(a_gid)) {
-        the_neighbours = calo_locator.getNeighbourGIDs(a_gid, mask);
+        the_neighbours = calo_locator.getNeighbourRange(a_gid, mask);
       } else if (xcalo_locator.isCaloBlockInThisModule(a_gid)) {
-        the_neighbours = xcalo_locator.getNeighbourGIDs(a_gid, mask);
+        the_neighbours = xcalo_locator.getNeighbourRange(a_gid, mask);
       } else if (gveto_locator.isCaloBlockInThisModule(a_gid)) {
-        the_neighbours = gveto_locator.getNeighbourGIDs(a_gid, mask);
+        the_neighbours = gveto_locator.getNeighbourRange(a_gid, mask);
       } else {
         DT_THROW(std::logic_error,
                  "Current geom id '" << a_gid << "' does not match any scintillator block !");
@@ -1,6 +1,11 @@
 // This Project
 #include "FLpCDToCpCDAlgo.h"
 
+// Standard library:
+#include <iomanip>
+#include <map>
+#include <set>
+
 // This project:
 #include <bayeux/datatools/exception.h>
 #include <falaise/snemo/datamodels/data_model.h>
@@ -10,6 +15,47 @@
 
 namespace FLpCDToCpCD {
 
+  namespace {
+
+    //! Options of the printer of input/output data records in debug mode
+    const boost::property_tree::ptree & debug_printer_options()
+    {
+      static const boost::property_tree::ptree printerOpts = [] {
+        boost::property_tree::ptree opts;
+        opts.put("indent", "[debug] ");
+        opts.put("title", "Input data record");
+        opts.put("eh.list_properties", true);
+        opts.put("udd.list_hits", true);
+        opts.put("udd.hit_details", true);
+        opts.put("udd.list_properties", true);
+        opts.put("pcd.list_hits", true);
+        opts.put("pcd.list_properties", true);
+        opts.put("cd.list_hits", true);
+        opts.put("cd.list_properties", true);
+        opts.put("tcd.list_solutions", true);
+        opts.put("tcd.solutions.list_clusters", true);
+        opts.put("tcd.solutions.list_unclustered_hits", false);
+        opts.put("tcd.solutions.list_properties", true);
+        opts.put("tcd.list_properties", true);
+        return opts;
+      }();
+      return printerOpts;
+    }
+
+    //! Index the ranks of UDD hits by geometry ID, in their original order
+    template <typename HitHandleCollection>
+    std::map<geomtools::geom_id, std::vector<std::size_t>>
+    index_by_geom_id(const HitHandleCollection & hits_)
+    {
+      std::map<geomtools::geom_id, std::vector<std::size_t>> index;
+      for (std::size_t ihit = 0; ihit < hits_.size(); ihit++) {
+        index[hits_[ihit]->get_geom_id()].push_back(ihit);
+      }
+      return index;
+    }
+
+  } // namespace
+
   FLpCDToCpCDAlgorithm::FLpCDToCpCDAlgorithm()
   {
     _eh_tag_ = snedm::labels::event_header();
@@ -53,28 +99,47 @@ namespace FLpCDToCpCD {
 
   void FLpCDToCpCDAlgorithm::process(datatools::things & input_data_record_,
 				     data_records_col & output_data_records_)
+  {
+    split(input_data_record_, output_data_records_);
+    number_events(output_data_records_);
+    return;
+  }
+
+  void FLpCDToCpCDAlgorithm::number_events(data_records_col & output_data_records_)
+  {
+    for (auto & odr : output_data_records_) {
+      if (_current_event_number_ == datatools::event_id::INVALID_EVENT_NUMBER) {
+	_current_event_number_ = 0;
+      }
+      auto & ehData = odr->grab<snemo::datamodel::event_header>(_eh_tag_);
+      ehData.get_id().set_event_number(_current_event_number_);
+      _current_event_number_++;
+    }
+
+    if (datatools::logger::is_debug(verbosity())) {
+      DT_LOG_DEBUG(verbosity(), "Output data records : " << output_data_records_.size());
+      int odrCount = 0;
+      for (const auto & odr : output_data_records_) {
+	snedm::data_record_printer oPrinter(*odr);
+	// Copy the input printer options:
+	boost::property_tree::ptree oPrinterOpts = debug_printer_options();
+	// But update the title:
+	oPrinterOpts.put("title", "Ouput data record #" + std::to_string(odrCount));
+	oPrinter.print(std::cerr, oPrinterOpts);
+	odrCount++;
+      }
+    }
+    return;
+  }
+
+  void FLpCDToCpCDAlgorithm::split(datatools::things & input_data_record_,
+				   data_records_col & output_data_records_) const
   {
     DT_LOG_DEBUG(verbosity(), "Processing input data record...");
-    boost::property_tree::ptree iPrinterOpts;
-    iPrinterOpts.put("indent", "[debug] ");
-    iPrinterOpts.put("title", "Input data record");
-    iPrinterOpts.put("eh.list_properties", true);
-    iPrinterOpts.put("udd.list_hits", true);
-    iPrinterOpts.put("udd.hit_details", true);
-    iPrinterOpts.put("udd.list_properties", true);
-    iPrinterOpts.put("pcd.list_hits", true);
-    iPrinterOpts.put("pcd.list_properties", true);
-    iPrinterOpts.put("cd.list_hits", true);
-    iPrinterOpts.put("cd.list_properties", true);
-    iPrinterOpts.put("tcd.list_solutions", true);
-    iPrinterOpts.put("tcd.solutions.list_clusters", true);
-    iPrinterOpts.put("tcd.solutions.list_unclustered_hits", false);
-    iPrinterOpts.put("tcd.solutions.list_properties", true);
-    iPrinterOpts.put("tcd.list_properties", true);
     output_data_records_.clear();
     if (datatools::logger::is_debug(verbosity())) {
       snedm::data_record_printer iPrinter(input_data_record_);
-      iPrinter.print(std::cerr, iPrinterOpts);
+      iPrinter.print(std::cerr, debug_printer_options());
     }
     
     if (not input_data_record_.has(_pcd_tag_)) {
@@ -106,10 +171,6 @@ namespace FLpCDToCpCD {
     auto & inputPcdData
       = input_data_record_.grab<snemo::datamodel::precalibrated_data>(_pcd_tag_);
      
-    // Update run number:
-    if (_current_run_number_ != inputEhData.get_id().get_run_number()) {
-      _current_run_number_ = inputEhData.get_id().get_run_number();
-    }
     // Extract the number of clusters:
     size_t nb_clusters = 0;
     if (inputPcdData.get_properties().has_key("pCD.clustering.nclusters")) {
@@ -119,19 +180,17 @@ namespace FLpCDToCpCD {
     if (nb_clusters == 0) return;
     // Populate output data records:
     output_data_records_.clear();
+    output_data_records_.reserve(nb_clusters);
     for (unsigned int i = 0; i < nb_clusters; i++) {
-      if (_current_event_number_ == datatools::event_id::INVALID_EVENT_NUMBER) {
-	_current_event_number_ = 0;
-      }
-      output_data_records_.push_back(datatools::make_handle<datatools::things>());
+      output_data_records_.emplace_back(new datatools::things);
       
-      auto & newRecord = output_data_records_.back().grab();
+      auto & newRecord = *output_data_records_.back();
 
       DT_LOG_DEBUG(verbosity(), "making a new output event header for cluster #" << i);
       auto & newEhData = snedm::addToEvent<snemo::datamodel::event_header>(_eh_tag_, newRecord);
       newEhData = inputEhData;
-      newEhData.get_id().set_run_number(_current_run_number_);
-      newEhData.get_id().set_event_number(_current_event_number_);
+      // Numbered by number_events:
+      newEhData.get_id().set_event_number(datatools::event_id::INVALID_EVENT_NUMBER);
       newEhData.get_properties().store_flag(snedm::labels::event_builder_key());
       newEhData.get_properties().store_string(snedm::labels::event_builder_model_key(), "pcd2cpcd");
       newEhData.get_properties().store_integer("daq.run_number", inputEhData.get_id().get_run_number());
@@ -154,12 +213,11 @@ namespace FLpCDToCpCD {
       auto & pcdTrackerHits = newPcdData.tracker_hits();
       DT_LOG_DEBUG(verbosity(), "  # new pCD calo hits    = " << pcdCaloHits.size());
       DT_LOG_DEBUG(verbosity(), "  # new pCD tracker hits = " << pcdTrackerHits.size());
-
-      // Update event number:
-      _current_event_number_++;
     }
 
     // Split input DAQ-based UDD and pCD hits in several cluster-based events:
+    auto & inputUddCaloHits = inputUddData.grab_calorimeter_hits();
+    const auto inputUddCaloHitsByGid = index_by_geom_id(inputUddCaloHits);
     auto & inputPcdCaloHits = inputPcdData.calorimeter_hits();
     std::set<int> unclusterizedPcdCaloHitIndexes;
     DT_LOG_DEBUG(verbosity(), "Processing " << inputPcdCaloHits.size() << " input calo hits...");
@@ -173,23 +231,27 @@ namespace FLpCDToCpCD {
       int clusterId = inputPcdCaloHit->get_auxiliaries().fetch_integer("pCD.clustering.cluster_id");
       DT_LOG_DEBUG(verbosity(), "  Calo hit #" << iPcdCaloHit << " is clusterized with cluster ID=" << clusterId);
       snemo::datamodel::precalibrated_data & clusterPcdData
-	= output_data_records_[clusterId].grab().grab<snemo::datamodel::precalibrated_data>(_pcd_tag_);
+	= output_data_records_[clusterId]->grab<snemo::datamodel::precalibrated_data>(_pcd_tag_);
       clusterPcdData.calorimeter_hits().push_back(inputPcdCaloHit);
       clusterPcdData.calorimeter_hits().back()->grab_auxiliaries().erase_all_starting_with("pCD.clustering.");
 
       // Populate UDD bank with UDD calo hits associated to pCD calo hit:
       auto inputPcdCaloHitGid = inputPcdCaloHit->get_geom_id();
       snemo::datamodel::unified_digitized_data & clusterUddData
-	= output_data_records_[clusterId].grab().grab<snemo::datamodel::unified_digitized_data>(_udd_tag_);
+	= output_data_records_[clusterId]->grab<snemo::datamodel::unified_digitized_data>(_udd_tag_);
       auto & clusterUddCaloHits = clusterUddData.grab_calorimeter_hits();
-      for (auto & inputUddCaloHit : inputUddData.grab_calorimeter_hits()) {
-	if (inputUddCaloHit->get_geom_id() == inputPcdCaloHitGid) {
+      auto foundUddCaloHits = inputUddCaloHitsByGid.find(inputPcdCaloHitGid);
+      if (foundUddCaloHits != inputUddCaloHitsByGid.end()) {
+	for (std::size_t iUddCaloHit : foundUddCaloHits->second) {
+	  auto & inputUddCaloHit = inputUddCaloHits[iUddCaloHit];
 	  clusterUddCaloHits.push_back(inputUddCaloHit);
 	  clusterUddData.add_origin_trigger_id(inputUddCaloHit->get_origin().get_trigger_id()); 
 	}
       }
     }
 
+    auto & inputUddTrackerHits = inputUddData.grab_tracker_hits();
+    const auto inputUddTrackerHitsByGid = index_by_geom_id(inputUddTrackerHits);
     auto & inputPcdTrackerHits = inputPcdData.tracker_hits();
     std::set<int> unclusterizedPcdTrackerHitIndexes;
     DT_LOG_DEBUG(verbosity(), "Processing " << inputPcdTrackerHits.size() << " input tracker hits...");
@@ -203,17 +265,19 @@ namespace FLpCDToCpCD {
       int clusterId = inputPcdTrackerHit->get_auxiliaries().fetch_integer("pCD.clustering.cluster_id");
       DT_LOG_DEBUG(verbosity(), "  Tracker hit #" << iPcdTrackerHit << " is clusterized with cluster ID=" << clusterId);
       snemo::datamodel::precalibrated_data & clusterPcdData
-	= output_data_records_[clusterId].grab().grab<snemo::datamodel::precalibrated_data>(_pcd_tag_);
+	= output_data_records_[clusterId]->grab<snemo::datamodel::precalibrated_data>(_pcd_tag_);
       clusterPcdData.tracker_hits().push_back(inputPcdTrackerHit);
       clusterPcdData.tracker_hits().back()->grab_auxiliaries().erase_all_starting_with("pCD.clustering.");
 
       // Populate UDD bank with UDD tracker hits associated to pCD tracker hit:
       auto inputPcdTrackerHitGid = inputPcdTrackerHit->get_geom_id();
       snemo::datamodel::unified_digitized_data & clusterUddData
-	= output_data_records_[clusterId].grab().grab<snemo::datamodel::unified_digitized_data>(_udd_tag_);
+	= output_data_records_[clusterId]->grab<snemo::datamodel::unified_digitized_data>(_udd_tag_);
       auto & clusterUddTrackerHits = clusterUddData.grab_tracker_hits();
-      for (auto & inputUddTrackerHit : inputUddData.grab_tracker_hits()) {
-	if (inputUddTrackerHit->get_geom_id() == inputPcdTrackerHitGid) {
+      auto foundUddTrackerHits = inputUddTrackerHitsByGid.find(inputPcdTrackerHitGid);
+      if (foundUddTrackerHits != inputUddTrackerHitsByGid.end()) {
+	for (std::size_t iUddTrackerHit : foundUddTrackerHits->second) {
+	  auto & inputUddTrackerHit = inputUddTrackerHits[iUddTrackerHit];
 	  clusterUddTrackerHits.push_back(inputUddTrackerHit);
 	  for (const snemo::datamodel::tracker_digitized_hit::gg_times & tdht: inputUddTrackerHit->get_times()) {
 	    for (auto i = 0u; i < 5; i++) {
@@ -232,19 +296,6 @@ namespace FLpCDToCpCD {
       }
     }
 
-    if (datatools::logger::is_debug(verbosity())) {
-      DT_LOG_DEBUG(verbosity(), "Output data records : " << output_data_records_.size());
-      int odrCount = 0;
-      for (const auto & odr : output_data_records_) {
-	snedm::data_record_printer oPrinter(*odr);
-	// Copy the input printer options:
-	boost::property_tree::ptree oPrinterOpts = iPrinterOpts;
-	// But update the title:
-	oPrinterOpts.put("title", "Ouput data record #" + std::to_string(odrCount));
-	oPrinter.print(std::cerr, oPrinterOpts);
-	odrCount++;
-      }
-    }
     DT_LOG_DEBUG(verbosity(), "Input data record has been processed.");
     return;
   }
@@ -14,12 +14,13 @@
 #define FLPCDTOCPCDALGO_H
 
 // Standard library:
+#include <memory>
 #include <string>
 #include <vector>
 
 // Third Party
 // - Bayeux
-#include <bayeux/datatools/handle.h>
+#include <bayeux/datatools/logger.h>
 #include <bayeux/datatools/things.h>
 #include <bayeux/datatools/event_id.h>
 
@@ -30,7 +31,7 @@ namespace FLpCDToCpCD {
   {
 	public:
  
-    typedef std::vector<datatools::handle<datatools::things>> data_records_col;
+    typedef std::vector<std::unique_ptr<datatools::things>> data_records_col;
 		
 		FLpCDToCpCDAlgorithm();
 
@@ -45,10 +46,22 @@ namespace FLpCDToCpCD {
 		const std::string & pcd_tag() const;
 
 		bool skip_cluster_without_calo_hits() const;
-		
+
+    /// Split an input data record in cluster-based event records and number them
     void process(datatools::things & input_data_record_,
 								 data_records_col & output_data_records_);
 
+    /// Split an input data record in cluster-based event records
+    ///
+    /// The output event records are not numbered. This method does not
+    /// change the state of the algorithm and can be called concurrently
+    /// from several threads on distinct input data records.
+    void split(datatools::things & input_data_record_,
+               data_records_col & output_data_records_) const;
+
+    /// Assign consecutive event numbers to split event records, following the order of the calls
+    void number_events(data_records_col & output_data_records_);
+
   private:
 
 		datatools::logger::priority _verbosity_ = datatools::logger::PRIO_FATAL;
@@ -59,7 +72,6 @@ namespace FLpCDToCpCD {
 		bool _skip_cluster_without_calo_hits_ = false;
 
 		// Working data:
-		int _current_run_number_   = datatools::event_id::INVALID_RUN_NUMBER;
 		int _current_event_number_ = datatools::event_id::INVALID_EVENT_NUMBER;
    
   };
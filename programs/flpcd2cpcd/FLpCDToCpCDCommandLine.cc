@@ -3,6 +3,7 @@
 
 // Standard Library
 #include <set>
+#include <string>
 #include <vector>
 
 // Third Party
@@ -21,6 +22,7 @@
 
 // This project
 #include "FLpCDToCpCDErrors.h"
+#include "FLpCDToCpCDParams.h"
 #include "falaise/user_level.h"
 #include "falaise/detail/falaise_sys.h"
 #include "falaise/resource.h"
@@ -37,6 +39,8 @@ namespace FLpCDToCpCD {
     frArgs.logLevel = datatools::logger::PRIO_FATAL;
     frArgs.maxNumberOfEvents = 0;
     frArgs.moduloEvents = 0;
+    frArgs.numberOfThreads = 1;
+    frArgs.benchmark = false;
     frArgs.userProfile = "normal";
     frArgs.mountPoints.clear();
     frArgs.configScript = "";
@@ -57,6 +61,8 @@ namespace FLpCDToCpCD {
          << std::endl;
     out_ << tag << "maxNumberOfEvents            = " << maxNumberOfEvents << std::endl;
     out_ << tag << "moduloEvents                 = " << moduloEvents << std::endl;
+    out_ << tag << "numberOfThreads              = " << numberOfThreads << std::endl;
+    out_ << tag << "benchmark                    = " << std::boolalpha << benchmark << std::endl;
     out_ << tag << "userProfile                  = '" << userProfile << "'" << std::endl;
     out_ << tag << "mountPoints                  = " << mountPoints.size() << std::endl;
     for (unsigned int i = 0; i < mountPoints.size(); i++) {
@@ -158,6 +164,16 @@ namespace FLpCDToCpCD {
        ->value_name("period"),
        "progress modulo on number of events")
 
+      ("threads,t",
+       bpo::value<int>(&clArgs.numberOfThreads)
+       ->default_value(1)
+       ->value_name("N"),
+       "number of worker threads splitting input data records in parallel")
+
+      ("benchmark",
+       bpo::bool_switch(&clArgs.benchmark),
+       "report the number of processed input data records per second")
+
       ("user-profile,u",
        bpo::value<std::string>(&clArgs.userProfile)
        ->value_name("name")
@@ -236,6 +252,13 @@ namespace FLpCDToCpCD {
       }
     }
 
+    if (clArgs.numberOfThreads < 1 ||
+        clArgs.numberOfThreads > static_cast<int>(FLpCDToCpCDParams::maxNumberOfThreads)) {
+      do_error(std::cerr, "Invalid number of threads (must be from 1 to " +
+               std::to_string(FLpCDToCpCDParams::maxNumberOfThreads) + ")!");
+      return DIALOG_ERROR;
+    }
+
     if (falaise::validUserLevels().count(clArgs.userProfile) == 0u) {
       do_error(std::cerr, "Invalid user profile '" + clArgs.userProfile + "'!");
       return DIALOG_ERROR;
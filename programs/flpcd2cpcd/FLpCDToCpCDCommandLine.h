@@ -41,6 +41,8 @@ namespace FLpCDToCpCD {
     datatools::logger::priority logLevel;  //!< Verbosity level
     uint32_t maxNumberOfEvents;            //!< Maximum number of processed input data events
     uint32_t moduloEvents;                 //!< Event modulo
+    int numberOfThreads;                   //!< Number of event builder worker threads
+    bool benchmark;                        //!< Flag to report the processing rate
     std::string userProfile;               //!< User profile
     std::vector<std::string> mountPoints;  //!< Directory mount directives
     std::string configScript;              //!< Path of the main pcdtocpcd configuration script
@@ -113,6 +113,8 @@ namespace FLpCDToCpCD {
     flProcessParameters.processConfig = clArgs.configScript;
     flProcessParameters.numberOfEvents = clArgs.maxNumberOfEvents;
     flProcessParameters.moduloEvents = clArgs.moduloEvents;
+    flProcessParameters.numberOfThreads = static_cast<unsigned int>(clArgs.numberOfThreads);
+    flProcessParameters.benchmark = clArgs.benchmark;
     flProcessParameters.userProfile = clArgs.userProfile;
     flProcessParameters.inputMetadataFile = clArgs.inputMetadataFile;
     flProcessParameters.inputFile = clArgs.inputFile;
@@ -204,6 +206,16 @@ namespace FLpCDToCpCD {
 	flProcessParameters.moduloEvents =
 	  basicSystem.get<int>("moduloEvents", flProcessParameters.moduloEvents);
 
+	// Number of event builder worker threads:
+	int numberOfThreads =
+	  basicSystem.get<int>("numberOfThreads", static_cast<int>(flProcessParameters.numberOfThreads));
+	DT_THROW_IF(numberOfThreads < 1 ||
+		    numberOfThreads > static_cast<int>(FLpCDToCpCDParams::maxNumberOfThreads),
+		    FLConfigUserError,
+		    "Invalid number of threads " << numberOfThreads << " (must be from 1 to "
+		    << FLpCDToCpCDParams::maxNumberOfThreads << ")!");
+	flProcessParameters.numberOfThreads = static_cast<unsigned int>(numberOfThreads);
+
 	// Printing rate for events:
 	flProcessParameters.userProfile =
 	  basicSystem.get<std::string>("userprofile", flProcessParameters.userProfile);
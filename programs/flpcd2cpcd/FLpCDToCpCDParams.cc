@@ -13,6 +13,8 @@ namespace FLpCDToCpCD {
     params.userProfile = "normal";
     params.numberOfEvents = 0; // 0 == no limit on event loop
     params.moduloEvents = 0; // 0 == no print
+    params.numberOfThreads = 1; // 1 == sequential event loop
+    params.benchmark = false;
     params.preserveUnclusteredEvents = true;
     params.preserveUnclusteredHits = true;
     
@@ -71,6 +73,8 @@ namespace FLpCDToCpCD {
     out_ << tag << "userProfile             = '" << userProfile << "'" << std::endl;
     out_ << tag << "numberOfEvents         = " << numberOfEvents << std::endl;
     out_ << tag << "moduloEvents           = " << moduloEvents << std::endl;
+    out_ << tag << "numberOfThreads        = " << numberOfThreads << std::endl;
+    out_ << tag << "benchmark              = " << std::boolalpha << benchmark << std::endl;
     out_ << tag << "experimentalSetupUrn    = '" << experimentalSetupUrn  << "'"<< std::endl;
     out_ << tag << "variantConfigUrn        = '" << variantConfigUrn << "'" << std::endl;
     out_ << tag << "variantProfileUrn       = '" << variantProfileUrn << "'" << std::endl;
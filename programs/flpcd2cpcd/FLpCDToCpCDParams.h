@@ -41,6 +41,8 @@ namespace FLpCDToCpCD {
     std::vector<std::string> mountPoints;  //!< Directory mount directives
     unsigned int numberOfEvents;           //!< Number of events to be processed
     unsigned int moduloEvents;             //!< Number of events progress modulo
+    unsigned int numberOfThreads;          //!< Number of event builder worker threads
+    bool benchmark = false;                //!< Flag to report the processing rate
 		bool preserveUnclusteredEvents = false;
 		bool preserveUnclusteredHits = false; // unused
 		
@@ -69,6 +71,9 @@ namespace FLpCDToCpCD {
     // Metadata container:
     datatools::multi_properties inputMetadata;  //!< Metadata imported from the input
 
+    //! Maximum number of event builder worker threads
+    static const unsigned int maxNumberOfThreads = 256;
+
     //! Build a default arguments set:
     static FLpCDToCpCDParams makeDefault();
 
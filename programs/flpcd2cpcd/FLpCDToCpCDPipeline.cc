@@ -2,6 +2,7 @@
 #include "FLpCDToCpCDPipeline.h"
 
 // Standard Library
+#include <chrono>
 #include <exception>
 #include <memory>
 
@@ -26,6 +27,8 @@
 // This Project:
 #include "FLpCDToCpCDImpl.h"
 #include "FLpCDToCpCDAlgo.h"
+#include "FLpCDToCpCDWorkers.h"
+#include "falaise/async_writer.h"
 #include "falaise/resource.h"
 #include "falaise/snemo/services/services.h"
 
@@ -122,59 +125,42 @@ namespace FLpCDToCpCD {
       FLpCDToCpCDAlgorithm pcd2cpcdAlgo;
       DT_LOG_TRACE(datatools::logger::PRIO_TRACE, "Verbosity = " << datatools::logger::get_priority_label(flAppParameters_.logLevel));
       pcd2cpcdAlgo.set_verbosity(flAppParameters_.logLevel);
-      
+
+      // With worker threads, output events are written from a dedicated thread:
+      std::unique_ptr<falaise::async_writer> flAppWriter;
+      if (recOutputHandle != nullptr && flAppParameters_.numberOfThreads > 1) {
+        flAppWriter.reset(new falaise::async_writer(*recOutputHandle, 4 * flAppParameters_.numberOfThreads));
+      }
+
       // - Now the actual event loop
       DT_LOG_DEBUG(flAppParameters_.logLevel, "Begin event loop");
-      datatools::things inputDataEvent;
+      using benchmark_clock = std::chrono::steady_clock;
+      const benchmark_clock::time_point loopStart = benchmark_clock::now();
       std::size_t inputEventCounter = 0;
       std::size_t outputClusteredEventCounter = 0;
       std::size_t outputUnclusteredEventCounter = 0;
-      while (true) {
-        // Prepare and read work:
-        inputDataEvent.clear();
-        if (recInput->is_terminated()) {
-          DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Input module is terminated");
-          break;
-        }
-        if (recInput->process(inputDataEvent) != dpp::base_module::PROCESS_OK) {
-          DT_LOG_FATAL(flAppParameters_.logLevel, "Failed to read data event from input source");
-          code = falaise::EXIT_UNAVAILABLE;
-          break;
-        }
 
-	FLpCDToCpCDAlgorithm::data_records_col outputDataEvents;
-        pcd2cpcdAlgo.process(inputDataEvent, outputDataEvents);
+      // Check if the input data record of given rank is to be processed:
+      auto acceptInput = [&flAppParameters_](std::size_t inputRank_) {
+        return flAppParameters_.numberOfEvents == 0 || inputRank_ <= flAppParameters_.numberOfEvents;
+      };
 
-        // Write item:
+      // Number and write the events split from an input data record, in input order:
+      auto buildEvents = [&](FLpCDToCpCDAlgorithm::data_records_col & outputDataEvents_) -> bool {
+        pcd2cpcdAlgo.number_events(outputDataEvents_);
+        outputClusteredEventCounter += outputDataEvents_.size();
         if (recOutputHandle != nullptr) {
-	  DT_THROW_IF(outputDataEvents.size() == 0, std::logic_error,
-		      "No identified cluster events");
-	  if (outputDataEvents.size()) {
-	    for (auto & outputDataEventHandle : outputDataEvents) {
-	      auto & outputDataEvent = outputDataEventHandle.grab();
-	      // if (outputDataEvent.has(pcd2cpcdAlgo.pcd_tag())) {
-	      // }
-	      auto pStatus = recOutputHandle->process(outputDataEvent);
-	      outputClusteredEventCounter++;
-	      if (pStatus != dpp::base_module::PROCESS_OK) {
-		DT_LOG_FATAL(flAppParameters_.logLevel, "Failed to write event to output sink");
-		code = falaise::EXIT_UNAVAILABLE;
-		break;
-	      }
-	    }
-	  }
-	  // else {
-	  //   if (flAppParameters_.preserveUnclusteredEvents) {
-	  //     // No found clusters : the event data record is saved as is:
-	  //     auto pStatus = recOutputHandle->process(inputDataEvent);
-	  //     outputUnclusteredEventCounter++;
-	  //     if (pStatus != dpp::base_module::PROCESS_OK) {
-	  // 	DT_LOG_FATAL(flAppParameters_.logLevel, "Failed to write unclustered event to output sink");
-	  // 	code = falaise::EXIT_UNAVAILABLE;
-	  // 	break;
-	  //     }
-	  //   }
-	  // }
+          DT_THROW_IF(outputDataEvents_.size() == 0, std::logic_error,
+                      "No identified cluster events");
+          for (auto & outputDataEvent : outputDataEvents_) {
+            const bool written = flAppWriter
+              ? flAppWriter->write(std::move(outputDataEvent))
+              : recOutputHandle->process(*outputDataEvent) == dpp::base_module::PROCESS_OK;
+            if (!written) {
+              DT_LOG_FATAL(flAppParameters_.logLevel, "Failed to write event to output sink");
+              return false;
+            }
+          }
         }
         if (flAppParameters_.moduloEvents > 0) {
           if (inputEventCounter % flAppParameters_.moduloEvents == 0) {
@@ -182,9 +168,92 @@ namespace FLpCDToCpCD {
           }
         }
         inputEventCounter++;
-        if (flAppParameters_.numberOfEvents > 0 && inputEventCounter > flAppParameters_.numberOfEvents) {
-          break;
+        return true;
+      };
+
+      if (flAppParameters_.numberOfThreads > 1) {
+        DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE,
+                      "Splitting input data records in " << flAppParameters_.numberOfThreads << " worker threads");
+        SplitWorkers workers(pcd2cpcdAlgo, flAppParameters_.numberOfThreads, flAppParameters_.logLevel);
+        std::size_t submittedEventCounter = 0;
+        bool inputDone = false;
+        while (true) {
+          // Keep the worker threads busy with data records read in advance
+          while (!inputDone && workers.in_flight() < workers.capacity()) {
+            if (!acceptInput(submittedEventCounter)) {
+              inputDone = true;
+              break;
+            }
+            if (recInput->is_terminated()) {
+              DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Input module is terminated");
+              inputDone = true;
+              break;
+            }
+            std::unique_ptr<datatools::things> inputDataEvent(new datatools::things);
+            if (recInput->process(*inputDataEvent) != dpp::base_module::PROCESS_OK) {
+              DT_LOG_FATAL(flAppParameters_.logLevel, "Failed to read data event from input source");
+              code = falaise::EXIT_UNAVAILABLE;
+              inputDone = true;
+              break;
+            }
+            workers.submit(std::move(inputDataEvent));
+            submittedEventCounter++;
+          }
+
+          // Collect split data records in input order
+          SplitRecord record;
+          if (!workers.next(record)) {
+            break;
+          }
+          DT_THROW_IF(record.failed, std::logic_error,
+                      "Input data record #" << record.index << ": " << record.error);
+          if (!buildEvents(record.outputs)) {
+            code = falaise::EXIT_UNAVAILABLE;
+            break;
+          }
         }
+        workers.stop();
+      } else {
+        datatools::things inputDataEvent;
+        while (acceptInput(inputEventCounter)) {
+          // Prepare and read work:
+          inputDataEvent.clear();
+          if (recInput->is_terminated()) {
+            DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Input module is terminated");
+            break;
+          }
+          if (recInput->process(inputDataEvent) != dpp::base_module::PROCESS_OK) {
+            DT_LOG_FATAL(flAppParameters_.logLevel, "Failed to read data event from input source");
+            code = falaise::EXIT_UNAVAILABLE;
+            break;
+          }
+
+          FLpCDToCpCDAlgorithm::data_records_col outputDataEvents;
+          pcd2cpcdAlgo.split(inputDataEvent, outputDataEvents);
+          if (!buildEvents(outputDataEvents)) {
+            code = falaise::EXIT_UNAVAILABLE;
+            break;
+          }
+        }
+      }
+      if (flAppWriter) {
+        // Flush pending output events before the output module is reset
+        if (!flAppWriter->finish()) {
+          DT_LOG_FATAL(flAppParameters_.logLevel,
+                       "Failed to write event to output sink: " << flAppWriter->error_message());
+          code = falaise::EXIT_UNAVAILABLE;
+        }
+        flAppWriter.reset();
+      }
+      if (flAppParameters_.benchmark) {
+        const std::chrono::duration<double> loopTime = benchmark_clock::now() - loopStart;
+        const double seconds = loopTime.count();
+        DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE,
+                      "Benchmark: " << inputEventCounter << " input data records split in "
+                      << outputClusteredEventCounter << " events in " << seconds << " s with "
+                      << flAppParameters_.numberOfThreads << " thread(s): "
+                      << (seconds > 0.0 ? inputEventCounter / seconds : 0.0) << " records/s, "
+                      << (seconds > 0.0 ? outputClusteredEventCounter / seconds : 0.0) << " events/s");
       }
       DT_LOG_DEBUG(flAppParameters_.logLevel, "Event loop completed");
       DT_LOG_DEBUG(flAppParameters_.logLevel, "Number of processed input data records : " << inputEventCounter);
@@ -0,0 +1,80 @@
+// Ourselves
+#include "FLpCDToCpCDWorkers.h"
+
+// Standard Library
+#include <exception>
+#include <stdexcept>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/exception.h"
+
+namespace FLpCDToCpCD {
+
+  SplitWorkers::SplitWorkers(const FLpCDToCpCDAlgorithm & algorithm_, std::size_t nthreads_,
+                             datatools::logger::priority priority_)
+    : algo_(algorithm_)
+    , logLevel_(priority_)
+  {
+    DT_THROW_IF(nthreads_ == 0, std::logic_error, "No worker thread!");
+    // Two records per worker: one being processed, one waiting
+    workers_.reset(new falaise::ordered_workers<SplitRecord>(
+      nthreads_, 2, [this](std::size_t, SplitRecord & record) { process_(record); }));
+    DT_LOG_DEBUG(logLevel_, "Started " << workers_->size() << " event builder worker threads");
+    return;
+  }
+
+  SplitWorkers::~SplitWorkers()
+  {
+    stop();
+    return;
+  }
+
+  std::size_t SplitWorkers::size() const
+  {
+    return workers_->size();
+  }
+
+  std::size_t SplitWorkers::capacity() const
+  {
+    return workers_->capacity();
+  }
+
+  std::size_t SplitWorkers::in_flight() const
+  {
+    return workers_->in_flight();
+  }
+
+  void SplitWorkers::submit(std::unique_ptr<datatools::things> input_)
+  {
+    SplitRecord record;
+    record.index = workers_->submitted();
+    record.input = std::move(input_);
+    workers_->submit(std::move(record));
+    return;
+  }
+
+  bool SplitWorkers::next(SplitRecord & record_)
+  {
+    return workers_->next(record_);
+  }
+
+  void SplitWorkers::stop()
+  {
+    workers_->stop();
+    return;
+  }
+
+  void SplitWorkers::process_(SplitRecord & record_) const
+  {
+    try {
+      algo_.split(*record_.input, record_.outputs);
+    } catch (std::exception & e) {
+      record_.failed = true;
+      record_.error = e.what();
+      record_.outputs.clear();
+    }
+    return;
+  }
+
+} // namespace FLpCDToCpCD
@@ -0,0 +1,95 @@
+// FLpCDToCpCDWorkers.h - Interface for FLpCDToCpCD event builder worker threads
+//
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLPCDTOCPCDWORKERS_H
+#define FLPCDTOCPCDWORKERS_H
+
+// Standard Library:
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/logger.h"
+#include "bayeux/datatools/things.h"
+
+// This project
+#include "FLpCDToCpCDAlgo.h"
+#include "falaise/ordered_workers.h"
+
+namespace FLpCDToCpCD {
+
+  //! Input data record travelling through the threaded event builder
+  struct SplitRecord
+  {
+    std::size_t index = 0;                             //!< Rank of the record in the input stream
+    std::unique_ptr<datatools::things> input;          //!< The input data record
+    FLpCDToCpCDAlgorithm::data_records_col outputs;    //!< The cluster-based event records split from the input
+    bool failed = false;                               //!< Flag set if the split threw
+    std::string error;                                 //!< Description of the failure
+  };
+
+  //! \brief Pool of threads splitting input data records in cluster-based event records
+  //!
+  //! All worker threads share the same algorithm, whose split step is stateless.
+  //! Records are dispatched and retrieved in input order by a falaise::ordered_workers
+  //! pool, so that the event numbers assigned afterwards do not depend on scheduling.
+  class SplitWorkers
+  {
+  public:
+    //! Start the worker threads
+    SplitWorkers(const FLpCDToCpCDAlgorithm & algorithm_, std::size_t nthreads_,
+                 datatools::logger::priority priority_);
+
+    //! Stop and join the worker threads
+    ~SplitWorkers();
+
+    SplitWorkers(const SplitWorkers &) = delete;
+    SplitWorkers & operator=(const SplitWorkers &) = delete;
+
+    //! Return the number of worker threads
+    std::size_t size() const;
+
+    //! Return the maximum number of records that may be in flight
+    std::size_t capacity() const;
+
+    //! Return the number of submitted records not yet retrieved
+    std::size_t in_flight() const;
+
+    //! Queue an input data record for splitting
+    void submit(std::unique_ptr<datatools::things> input_);
+
+    //! Wait for the next record in submission order
+    //! \return false if no record is in flight
+    bool next(SplitRecord & record_);
+
+    //! Discard pending records and join the worker threads
+    void stop();
+
+  private:
+    //! Split a record in the thread of a worker
+    void process_(SplitRecord & record_) const;
+
+  private:
+    const FLpCDToCpCDAlgorithm & algo_;               //!< Event builder algorithm
+    datatools::logger::priority logLevel_;            //!< Logging priority threshold
+    //! Worker threads
+    std::unique_ptr<falaise::ordered_workers<SplitRecord>> workers_;
+  };
+
+} // namespace FLpCDToCpCD
+
+#endif // FLPCDTOCPCDWORKERS_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
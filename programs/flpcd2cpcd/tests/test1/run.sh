@@ -11,6 +11,7 @@
 #
 #  * ``udd2pcd.conf`` : main configuration file for flreconstruct UDD->pCD processing
 #  * ``flpcd2cpcd-test1.conf`` : main configuration file for flpcd2cpcd
+#  * ``dump.conf`` : flreconstruct pipeline dumping the output event records
 #  * ``variant.profile`` : variant profile
 #  * ``run.sh`` : test script
 #
@@ -142,6 +143,63 @@ if [ $? -ne 0 ]; then
 fi
 echo >&2 ""
 
+echo >&2 "[info] Running flpcd2cpcd with worker threads..."
+flpcd2cpcd \
+    --threads 4 \
+    --benchmark \
+    -i ${FLWORKDIR}/pCD.brio \
+    -o ${FLWORKDIR}/epCD-mt.brio
+if [ $? -ne 0 ]; then
+    my_exit 1 "flpcd2cpcd with worker threads failed! Abort!"
+fi
+echo >&2 ""
+
+# Print the event numbers and the numbers of hits of the event records of a data file
+function event_summary()
+{
+    local data_file="$1"
+    local summary_file="$2"
+    flreconstruct \
+	-p ${cfg_dir}/dump.conf \
+	-i ${data_file} > ${data_file}.dump
+    if [ $? -ne 0 ]; then
+	return 1
+    fi
+    grep -E "Event number|PreCalibratedCalorimeterHits :|PreCalibratedTrackerHits :" \
+	 ${data_file}.dump \
+	| sed -e 's/^[^A-Za-z]*//' > ${summary_file}
+    return 0
+}
+
+echo >&2 "[info] Comparing the outputs of flpcd2cpcd without and with worker threads..."
+event_summary ${FLWORKDIR}/epCD.brio ${FLWORKDIR}/epCD.summary
+if [ $? -ne 0 ]; then
+    my_exit 1 "Cannot dump the flpcd2cpcd output! Abort!"
+fi
+event_summary ${FLWORKDIR}/epCD-mt.brio ${FLWORKDIR}/epCD-mt.summary
+if [ $? -ne 0 ]; then
+    my_exit 1 "Cannot dump the flpcd2cpcd output with worker threads! Abort!"
+fi
+nevents=$(grep -c "^Event number" ${FLWORKDIR}/epCD.summary)
+nevents_mt=$(grep -c "^Event number" ${FLWORKDIR}/epCD-mt.summary)
+echo >&2 "[info] Number of events: ${nevents} (sequential), ${nevents_mt} (worker threads)"
+if [ ${nevents} -eq 0 ]; then
+    my_exit 1 "No event found in the flpcd2cpcd output! Abort!"
+fi
+if [ ${nevents_mt} -ne ${nevents} ]; then
+    my_exit 1 "Numbers of events differ with worker threads! Abort!"
+fi
+# Each event must have its calorimeter and tracker hit counts
+nhitlines=$(grep -c "^PreCalibrated" ${FLWORKDIR}/epCD.summary)
+if [ ${nhitlines} -ne $((2 * nevents)) ]; then
+    my_exit 1 "Missing hit counts in the flpcd2cpcd output dump! Abort!"
+fi
+diff ${FLWORKDIR}/epCD.summary ${FLWORKDIR}/epCD-mt.summary >&2
+if [ $? -ne 0 ]; then
+    my_exit 1 "Event numbers or hit counts differ with worker threads! Abort!"
+fi
+echo >&2 ""
+
 # if [ ${with_visu} -eq 1 ]; then
 #     echo >&2 "[info] Running flvisualize..."
 #     flvisualize \
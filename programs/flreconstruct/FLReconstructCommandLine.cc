@@ -21,6 +21,7 @@
 
 // This project
 #include "FLReconstructErrors.h"
+#include "FLReconstructParams.h"
 #include "falaise/user_level.h"
 #include "falaise/detail/falaise_sys.h"
 #include "falaise/resource.h"
@@ -37,6 +38,13 @@ namespace FLReconstruct {
     frArgs.logLevel = datatools::logger::PRIO_FATAL;
     frArgs.maxNumberOfEvents = 0;
     frArgs.moduloEvents = 0;
+    frArgs.firstEvent = 0;
+    frArgs.endEvent = 0;
+    frArgs.numberOfThreads = 1;
+    frArgs.inputPrefetch = 0;
+    frArgs.outputQueue = 0;
+    frArgs.serve = false;
+    frArgs.profileFile = "";
     frArgs.userProfile = "normal";
     frArgs.mountPoints.clear();
     frArgs.configScript = "";
@@ -57,6 +65,13 @@ namespace FLReconstruct {
          << std::endl;
     out_ << tag << "maxNumberOfEvents            = " << maxNumberOfEvents << std::endl;
     out_ << tag << "moduloEvents                 = " << moduloEvents << std::endl;
+    out_ << tag << "firstEvent                   = " << firstEvent << std::endl;
+    out_ << tag << "endEvent                     = " << endEvent << std::endl;
+    out_ << tag << "numberOfThreads              = " << numberOfThreads << std::endl;
+    out_ << tag << "inputPrefetch                = " << inputPrefetch << std::endl;
+    out_ << tag << "outputQueue                  = " << outputQueue << std::endl;
+    out_ << tag << "serve                        = " << std::boolalpha << serve << std::endl;
+    out_ << tag << "profileFile                  = '" << profileFile << "'" << std::endl;
     out_ << tag << "userProfile                  = '" << userProfile << "'" << std::endl;
     out_ << tag << "mountPoints                  = " << mountPoints.size() << std::endl;
     for (unsigned int i = 0; i < mountPoints.size(); i++) {
@@ -196,6 +211,7 @@ namespace FLReconstruct {
 
     // Bind command line parser to exposed parameters
     std::string verbosityLabel;
+    std::string eventRange;
     // Application specific options:
     // clang-format off
     bpo::options_description optDesc("Options");
@@ -228,6 +244,40 @@ namespace FLReconstruct {
        ->value_name("period"),
        "progress modulo on number of events")
 
+      ("first-event",
+       bpo::value<uint32_t>(&clArgs.firstEvent)
+       ->default_value(0)
+       ->value_name("A"),
+       "index of the first input data record to be processed")
+
+      ("event-range",
+       bpo::value<std::string>(&eventRange)
+       ->value_name("A:B"),
+       "process input data records A to B-1 only (\"A:\" for A to the end of input)")
+
+      ("threads,t",
+       bpo::value<uint32_t>(&clArgs.numberOfThreads)
+       ->default_value(1)
+       ->value_name("N"),
+       "number of pipeline worker threads processing events in parallel")
+
+      ("input-prefetch",
+       bpo::value<uint32_t>(&clArgs.inputPrefetch)
+       ->default_value(0)
+       ->value_name("K"),
+       "number of input data records read ahead in a background thread (0: no read-ahead)")
+
+      ("output-queue",
+       bpo::value<uint32_t>(&clArgs.outputQueue)
+       ->default_value(0)
+       ->value_name("K"),
+       "number of output data records queued for a background writer thread (0: synchronous writing)")
+
+      ("profile",
+       bpo::value<std::string>(&clArgs.profileFile)
+       ->value_name("file"),
+       "profile the pipeline modules and store the report in file (CSV if named *.csv, JSON otherwise)")
+
       ("user-profile,u",
        bpo::value<std::string>(&clArgs.userProfile)
        ->value_name("name")
@@ -263,10 +313,14 @@ namespace FLReconstruct {
 
       ("input-file,i",
        bpo::value<std::string>(&clArgs.inputFile)
-       ->required()
        ->value_name("file"),
        "file from which to read input data (simulation, real)")
 
+      ("serve",
+       bpo::bool_switch(&clArgs.serve),
+       "keep the pipeline initialized and process the jobs \"<input> [<output>]\" read "
+       "line by line from the standard input")
+
       ("output-file,o",
        bpo::value<std::string>(&clArgs.outputFile)
        ->value_name("file"),
@@ -326,6 +380,41 @@ namespace FLReconstruct {
       }
     }
 
+    if (clArgs.inputFile.empty() && !clArgs.serve) {
+      do_error(std::cerr, "the option '--input-file' is required but missing");
+      return DIALOG_ERROR;
+    }
+
+    if (vMap.count("event-range") != 0u) {
+      if (!vMap["first-event"].defaulted()) {
+        do_error(std::cerr, "Options --first-event and --event-range are mutually exclusive!");
+        return DIALOG_ERROR;
+      }
+      if (!parse_event_range(eventRange, clArgs.firstEvent, clArgs.endEvent)) {
+        do_error(std::cerr, "Invalid event range '" + eventRange + "' (expected A:B with A < B, or A:)!");
+        return DIALOG_ERROR;
+      }
+    }
+
+    if (clArgs.numberOfThreads == 0 ||
+        clArgs.numberOfThreads > FLReconstructParams::maxNumberOfThreads) {
+      do_error(std::cerr, "Invalid number of threads (must be from 1 to " +
+               std::to_string(FLReconstructParams::maxNumberOfThreads) + ")!");
+      return DIALOG_ERROR;
+    }
+
+    if (clArgs.inputPrefetch > FLReconstructParams::maxInputPrefetch) {
+      do_error(std::cerr, "Invalid number of input data records read ahead (must be from 0 to " +
+               std::to_string(FLReconstructParams::maxInputPrefetch) + ")!");
+      return DIALOG_ERROR;
+    }
+
+    if (clArgs.outputQueue > FLReconstructParams::maxOutputQueue) {
+      do_error(std::cerr, "Invalid number of output data records queued for writing (must be from 0 to " +
+               std::to_string(FLReconstructParams::maxOutputQueue) + ")!");
+      return DIALOG_ERROR;
+    }
+
     if (falaise::validUserLevels().count(clArgs.userProfile) == 0u) {
       do_error(std::cerr, "Invalid user profile '" + clArgs.userProfile + "'!");
       return DIALOG_ERROR;
@@ -41,6 +41,13 @@ namespace FLReconstruct {
     datatools::logger::priority logLevel;  //!< Verbosity level
     uint32_t maxNumberOfEvents;            //!< Maximum number of processed events
     uint32_t moduloEvents;                 //!< Event modulo
+    uint32_t firstEvent;                   //!< Index of the first input data record to be processed
+    uint32_t endEvent;                     //!< Index past the last input data record to be processed (0: end of input)
+    uint32_t numberOfThreads;              //!< Number of pipeline worker threads
+    uint32_t inputPrefetch;                //!< Number of input data records read ahead
+    uint32_t outputQueue;                  //!< Number of output data records queued for writing
+    bool serve;                            //!< Flag to process successive jobs read from the standard input
+    std::string profileFile;               //!< Path of the module profile report
     std::string userProfile;               //!< User profile
     std::vector<std::string> mountPoints;  //!< Directory mount directives
     std::string configScript;              //!< Path of the main reconstruction configuration script
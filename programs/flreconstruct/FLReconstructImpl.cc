@@ -109,6 +109,13 @@ namespace FLReconstruct {
     flRecParameters.reconstructionConfig = clArgs.configScript;
     flRecParameters.numberOfEvents = clArgs.maxNumberOfEvents;
     flRecParameters.moduloEvents = clArgs.moduloEvents;
+    flRecParameters.firstEvent = clArgs.firstEvent;
+    flRecParameters.endEvent = clArgs.endEvent;
+    flRecParameters.numberOfThreads = clArgs.numberOfThreads;
+    flRecParameters.inputPrefetch = clArgs.inputPrefetch;
+    flRecParameters.outputQueue = clArgs.outputQueue;
+    flRecParameters.serve = clArgs.serve;
+    flRecParameters.profileFile = clArgs.profileFile;
     flRecParameters.userProfile = clArgs.userProfile;
     flRecParameters.inputMetadataFile = clArgs.inputMetadataFile;
     flRecParameters.inputFile = clArgs.inputFile;
@@ -199,6 +206,55 @@ namespace FLReconstruct {
         flRecParameters.moduloEvents =
           basicSystem.get<int>("moduloEvents", flRecParameters.moduloEvents);
 
+        // Range of input data records to be processed:
+        if (basicSystem.has_key("eventRange")) {
+          DT_THROW_IF(basicSystem.has_key("firstEvent"), FLConfigUserError,
+                      "Properties 'firstEvent' and 'eventRange' are mutually exclusive!");
+          auto eventRange = basicSystem.get<std::string>("eventRange");
+          DT_THROW_IF(!parse_event_range(eventRange, flRecParameters.firstEvent, flRecParameters.endEvent),
+                      FLConfigUserError, "Invalid event range '" << eventRange << "'!");
+        }
+        if (basicSystem.has_key("firstEvent")) {
+          auto firstEvent = basicSystem.get<int>("firstEvent");
+          DT_THROW_IF(firstEvent < 0, FLConfigUserError,
+                      "Invalid first event " << firstEvent << " (must be at least 0)!");
+          flRecParameters.firstEvent = static_cast<unsigned int>(firstEvent);
+        }
+
+        // Number of pipeline worker threads:
+        int numberOfThreads =
+          basicSystem.get<int>("numberOfThreads", static_cast<int>(flRecParameters.numberOfThreads));
+        DT_THROW_IF(numberOfThreads < 1 ||
+                    numberOfThreads > static_cast<int>(FLReconstructParams::maxNumberOfThreads),
+                    FLConfigUserError,
+                    "Invalid number of threads " << numberOfThreads << " (must be from 1 to "
+                    << FLReconstructParams::maxNumberOfThreads << ")!");
+        flRecParameters.numberOfThreads = static_cast<unsigned int>(numberOfThreads);
+
+        // Number of input data records read ahead:
+        int inputPrefetch =
+          basicSystem.get<int>("inputPrefetch", static_cast<int>(flRecParameters.inputPrefetch));
+        DT_THROW_IF(inputPrefetch < 0 ||
+                    inputPrefetch > static_cast<int>(FLReconstructParams::maxInputPrefetch),
+                    FLConfigUserError,
+                    "Invalid number of input data records read ahead " << inputPrefetch
+                    << " (must be from 0 to " << FLReconstructParams::maxInputPrefetch << ")!");
+        flRecParameters.inputPrefetch = static_cast<unsigned int>(inputPrefetch);
+
+        // Number of output data records queued for writing:
+        int outputQueue =
+          basicSystem.get<int>("outputQueue", static_cast<int>(flRecParameters.outputQueue));
+        DT_THROW_IF(outputQueue < 0 ||
+                    outputQueue > static_cast<int>(FLReconstructParams::maxOutputQueue),
+                    FLConfigUserError,
+                    "Invalid number of output data records queued for writing " << outputQueue
+                    << " (must be from 0 to " << FLReconstructParams::maxOutputQueue << ")!");
+        flRecParameters.outputQueue = static_cast<unsigned int>(outputQueue);
+
+        // Module profile report:
+        flRecParameters.profileFile =
+          basicSystem.get<std::string>("profile", flRecParameters.profileFile);
+
         // Printing rate for events:
         flRecParameters.userProfile =
           basicSystem.get<std::string>("userprofile", flRecParameters.userProfile);
@@ -396,6 +452,42 @@ namespace FLReconstruct {
     do_postprocess(flRecParameters);
   }
 
+  namespace {
+
+    //! Check that input metadata are compatible with the reconstruction parameters
+    void check_input_metadata(const FLReconstructParams & flRecParameters_,
+                              const falaise::app::metadata_input & iMeta_)
+    {
+      // Check the user profile:
+      if (flRecParameters_.userProfile == "production") {
+        DT_THROW_IF(iMeta_.userProfile != "production", FLConfigUserError,
+                    "User profile '"
+                    << flRecParameters_.userProfile << "' "
+                    << "is not compatible with input metadata production user profile '"
+                    << iMeta_.userProfile << "'!");
+      } else if (flRecParameters_.userProfile == "normal") {
+        DT_THROW_IF(iMeta_.userProfile == "expert", FLConfigUserError,
+                    "User profile '"
+                    << flRecParameters_.userProfile << "' "
+                    << "is not compatible with input metadata production user profile '"
+                    << iMeta_.userProfile << "'!");
+      }
+
+      // Check the experimental setup identifier:
+      if (!flRecParameters_.experimentalSetupUrn.empty()) {
+        DT_THROW_IF(!iMeta_.experimentalSetupUrn.empty() &&
+                    (iMeta_.experimentalSetupUrn != flRecParameters_.experimentalSetupUrn),
+                    std::logic_error,
+                    "Experimental setup URN='" << flRecParameters_.experimentalSetupUrn
+                    << "' conflicts with experimental setup URN='"
+                    << iMeta_.experimentalSetupUrn
+                    << "' extracted from input metadata!");
+      }
+      return;
+    }
+
+  } // namespace
+
   void do_postprocess_input_metadata(FLReconstructParams & flRecParameters_)
   {
     DT_LOG_DEBUG(flRecParameters_.logLevel, "Collect input metadata from input files");
@@ -446,34 +538,7 @@ namespace FLReconstruct {
     }
 
     // Checks:
-    {
-      // Check the user profile:
-      if (flRecParameters_.userProfile == "production") {
-        DT_THROW_IF(iMeta.userProfile != "production", FLConfigUserError,
-                    "User profile '"
-                    << flRecParameters_.userProfile << "' "
-                    << "is not compatible with input metadata production user profile '"
-                    << iMeta.userProfile << "'!");
-      } else if (flRecParameters_.userProfile == "normal") {
-        DT_THROW_IF(iMeta.userProfile == "expert", FLConfigUserError,
-                    "User profile '"
-                    << flRecParameters_.userProfile << "' "
-                    << "is not compatible with input metadata production user profile '"
-                    << iMeta.userProfile << "'!");
-      }
-
-      // Check the experimental setup identifier:
-      if (!flRecParameters_.experimentalSetupUrn.empty()) {
-        DT_THROW_IF(!iMeta.experimentalSetupUrn.empty() &&
-                    (iMeta.experimentalSetupUrn != flRecParameters_.experimentalSetupUrn),
-                    std::logic_error,
-                    "Experimental setup URN='" << flRecParameters_.experimentalSetupUrn
-                    << "' conflicts with experimental setup URN='"
-                    << iMeta.experimentalSetupUrn
-                    << "' extracted from input metadata!");
-      }
-      
-    } // End of checks.
+    check_input_metadata(flRecParameters_, iMeta);
 
     // Settings:
     {
@@ -489,6 +554,31 @@ namespace FLReconstruct {
     return;
   }
 
+  void do_check_job_input_metadata(const FLReconstructParams & flRecParameters_,
+                                   const std::string & inputFile_)
+  {
+    std::string inputFile = inputFile_;
+    datatools::fetch_path_with_env(inputFile);
+    falaise::app::metadata_collector mc;
+    mc.set_input_data_file(inputFile);
+    datatools::multi_properties inputMetadata = mc.get_metadata_from_data_file();
+    if (inputMetadata.empty()) {
+      DT_LOG_WARNING(flRecParameters_.logLevel,
+                     "No input metadata in '" << inputFile_ << "'. There is no way to check compatibility of the input data context and the configuration of the reconstruction setup!");
+      return;
+    }
+    falaise::app::metadata_input iMeta;
+    iMeta.scan(inputMetadata);
+    check_input_metadata(flRecParameters_, iMeta);
+    // Services (geometry...) are already set up: an input from an identified setup
+    // can only be processed if the same setup was loaded
+    DT_THROW_IF(!iMeta.experimentalSetupUrn.empty() && flRecParameters_.experimentalSetupUrn.empty(),
+                std::logic_error,
+                "Input experimental setup URN='" << iMeta.experimentalSetupUrn
+                << "' does not match the unidentified setup of the running reconstruction!");
+    return;
+  }
+
   void do_configure_variant(FLReconstructApplication & recApplication_)
   {
     datatools::kernel& dtk = datatools::kernel::instance();
@@ -41,6 +41,10 @@ namespace FLReconstruct {
   ///! Post process input metadata
   void do_postprocess_input_metadata(FLReconstructParams &flRecParameters_);
 
+  ///! Check that the metadata of an input file match the setup of a running reconstruction
+  void do_check_job_input_metadata(const FLReconstructParams &flRecParameters_,
+                                   const std::string &inputFile_);
+
   ///! Post process reconstruction parameters
   void do_postprocess(FLReconstructParams &flRecParameters_);
 
@@ -1,6 +1,10 @@
 // Ourselves
 #include "FLReconstructParams.h"
 
+// Standard Library
+#include <exception>
+#include <limits>
+
 namespace FLReconstruct {
 
   // static
@@ -13,6 +17,13 @@ namespace FLReconstruct {
     params.userProfile = "normal";
     params.numberOfEvents = 0;  // 0 == no limit on event loop
     params.moduloEvents = 0;    // 0 == no print
+    params.firstEvent = 0;      // 0 == start of input
+    params.endEvent = 0;        // 0 == end of input
+    params.numberOfThreads = 1; // 1 == sequential event loop
+    params.inputPrefetch = 0;   // 0 == no read-ahead
+    params.outputQueue = 0;     // 0 == synchronous writing
+    params.serve = false;       // false == single input file
+    params.profileFile = "";    // empty == no profiling
 
     // Experimental setup:
     params.experimentalSetupUrn = "";  // "urn:snemo:demonstrator:setup:2.0"
@@ -70,6 +81,13 @@ namespace FLReconstruct {
     out_ << tag << "userProfile                  = '" << userProfile << "'" << std::endl;
     out_ << tag << "numberOfEvents               = " << numberOfEvents << std::endl;
     out_ << tag << "moduloEvents                 = " << moduloEvents << std::endl;
+    out_ << tag << "firstEvent                   = " << firstEvent << std::endl;
+    out_ << tag << "endEvent                     = " << endEvent << std::endl;
+    out_ << tag << "numberOfThreads              = " << numberOfThreads << std::endl;
+    out_ << tag << "inputPrefetch                = " << inputPrefetch << std::endl;
+    out_ << tag << "outputQueue                  = " << outputQueue << std::endl;
+    out_ << tag << "serve                        = " << std::boolalpha << serve << std::endl;
+    out_ << tag << "profileFile                  = '" << profileFile << "'" << std::endl;
     out_ << tag << "experimentalSetupUrn         = '" << experimentalSetupUrn  << "'"<< std::endl;
     out_ << tag << "reconstructionPipelineUrn    = '" << reconstructionPipelineUrn << "'" << std::endl;
     out_ << tag << "reconstructionPipelineConfig = '" << reconstructionPipelineConfig << "'" << std::endl;
@@ -87,4 +105,37 @@ namespace FLReconstruct {
     return;
   }
 
+  bool parse_event_range(const std::string & range_, unsigned int & first_, unsigned int & end_)
+  {
+    std::size_t sep = range_.find(':');
+    if (sep == std::string::npos || sep == 0) {
+      return false;
+    }
+    try {
+      std::size_t pos = 0;
+      std::string firstToken = range_.substr(0, sep);
+      std::string endToken = range_.substr(sep + 1);
+      unsigned long first = std::stoul(firstToken, &pos);
+      if (pos != firstToken.size() || firstToken[0] == '-') {
+        return false;
+      }
+      unsigned long end = 0;
+      if (!endToken.empty()) {
+        end = std::stoul(endToken, &pos);
+        if (pos != endToken.size() || endToken[0] == '-' || end <= first) {
+          return false;
+        }
+      }
+      if (first > std::numeric_limits<unsigned int>::max() ||
+          end > std::numeric_limits<unsigned int>::max()) {
+        return false;
+      }
+      first_ = first;
+      end_ = end;
+    } catch (std::exception &) {
+      return false;
+    }
+    return true;
+  }
+
 } // namespace FLReconstruct
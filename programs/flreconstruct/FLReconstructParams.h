@@ -38,6 +38,13 @@ namespace FLReconstruct {
     std::vector<std::string> mountPoints;  //!< Directory mount directives
     unsigned int numberOfEvents;           //!< Number of events to be processed in the pipeline
     unsigned int moduloEvents;             //!< Number of events progress modulo
+    unsigned int firstEvent;               //!< Index of the first input data record to be processed
+    unsigned int endEvent;                 //!< Index past the last input data record to be processed (0: end of input)
+    unsigned int numberOfThreads;          //!< Number of pipeline worker threads
+    unsigned int inputPrefetch;            //!< Number of input data records read ahead
+    unsigned int outputQueue;              //!< Number of output data records queued for writing
+    bool serve;                            //!< Flag to process successive jobs read from the standard input
+    std::string profileFile;               //!< Path of the module profile report (empty: no profiling)
 
     // Required experimental setup and versioning:
     std::string experimentalSetupUrn;  //!< The URN of the experimental setup
@@ -73,6 +80,15 @@ namespace FLReconstruct {
     // Processing pipeline modules configuration:
     datatools::multi_properties modulesConfig;  //!< Main configuration for plugins loader
 
+    //! Maximum number of pipeline worker threads
+    static const unsigned int maxNumberOfThreads = 256;
+
+    //! Maximum number of input data records read ahead
+    static const unsigned int maxInputPrefetch = 1024;
+
+    //! Maximum number of output data records queued for writing
+    static const unsigned int maxOutputQueue = 1024;
+
     //! Build a default arguments set:
     static FLReconstructParams makeDefault();
 
@@ -80,6 +96,10 @@ namespace FLReconstruct {
     void print(std::ostream &) const;
   };
 
+  //! Parse an input data record range of the form "A:B" (records A to B-1) or "A:" (from A to the end)
+  //! \return false if the range is malformed or empty
+  bool parse_event_range(const std::string & range_, unsigned int & first_, unsigned int & end_);
+
 } // namespace FLReconstruct
 
 #endif // FLRECONSTRUCTPARAMS_H
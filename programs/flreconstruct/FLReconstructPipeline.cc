@@ -2,8 +2,11 @@
 #include "FLReconstructPipeline.h"
 
 // Standard Library
+#include <algorithm>
 #include <exception>
 #include <memory>
+#include <string>
+#include <vector>
 
 // Third Party
 // - Boost
@@ -25,238 +28,549 @@
 
 // This Project:
 #include "FLReconstructImpl.h"
+#include "FLReconstructProfiler.h"
+#include "FLReconstructReader.h"
+#include "FLReconstructWorkers.h"
+#include "falaise/async_writer.h"
 #include "falaise/resource.h"
 #include "falaise/snemo/services/services.h"
 
 namespace FLReconstruct {
 
-  //! Configure and run the pipeline
-  falaise::exit_code do_pipeline(const FLReconstructParams & flRecParameters_)
-  {
-    DT_LOG_TRACE_ENTERING(flRecParameters_.logLevel);
+  namespace {
 
-    // - Run:
-    falaise::exit_code code = falaise::EXIT_OK;
-    try {
-      // Load plugins:
-      datatools::library_loader libLoader(flRecParameters_.userLibConfig);
+    //! Fate of a data record after it went through the pipeline
+    enum record_action { RECORD_SAVE, RECORD_SKIP, RECORD_ABORT };
 
-      // Setup services:
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Starting reconstruction services...");
-      uint32_t servicesFlags = datatools::service_manager::BLANK;
-      servicesFlags |= datatools::service_manager::ALLOW_DYNAMIC_SERVICES;
-      datatools::service_manager recServices("flReconstructionServices",
-                                             "SuperNEMO Reconstruction Services", servicesFlags);
-      if (!flRecParameters_.servicesSubsystemConfig.empty()) {
-        // Load services:
-        std::string services_config_file = flRecParameters_.servicesSubsystemConfig;
-        datatools::fetch_path_with_env(services_config_file);
-        datatools::properties services_config;
-        services_config.read_configuration(services_config_file);
-        recServices.initialize(services_config);
-      } else {
-        recServices.initialize();
+    //! Interpret the status returned by the pipeline for a data record
+    record_action check_pipeline_status(const dpp::base_module & pipeline_,
+                                        dpp::base_module::process_status status_)
+    {
+      DT_THROW_IF(status_ == dpp::base_module::PROCESS_INVALID, std::logic_error,
+                  "Module '" << pipeline_.get_name() << "' did not return a valid processing status!");
+
+      // FATAL, ERROR and ERROR_STOP status triggers the abortion of the processing loop.
+      // This is a very conservative approach, but it is compatible with the default behaviour of
+      // the bxdpp_processing executable.
+      if (status_ == dpp::base_module::PROCESS_FATAL) {
+        return RECORD_ABORT;
+      }
+      if (status_ == dpp::base_module::PROCESS_ERROR) {
+        return RECORD_ABORT;
       }
-      if (datatools::logger::is_debug(flRecParameters_.logLevel)) {
-        recServices.tree_dump(std::cerr, "Reconstruction services: ", "[debug] ");
+      if (status_ == dpp::base_module::PROCESS_ERROR_STOP) {
+        return RECORD_ABORT;
       }
 
-      // Make sure some core services are setup and started (geometry, electronics, database...):
-      falaise::exit_code safeServicesCode = ensure_core_services(flRecParameters_, recServices);
-      DT_THROW_IF(safeServicesCode != falaise::EXIT_OK, std::logic_error,
-                  "Cannot start core services!");
+      // STOP means the current data record/event should not be processed anymore nor saved
+      // but the loop can continue with other items
+      if (status_ == dpp::base_module::PROCESS_STOP) {
+        return RECORD_SKIP;
+      }
+      return RECORD_SAVE;
+    }
 
-      // - Start up the module manager
+    //! Send a processed data record to the output sink, if any
+    //!
+    //! With an asynchronous writer, ownership of the data record is transferred
+    //! to the writer thread.
+    bool write_record(dpp::base_module * output_, falaise::async_writer * writer_,
+                      std::unique_ptr<datatools::things> & record_)
+    {
+      if (writer_ != nullptr) {
+        return writer_->write(std::move(record_));
+      }
+      if (output_ != nullptr) {
+        return output_->process(*record_) == dpp::base_module::PROCESS_OK;
+      }
+      return true;
+    }
+
+    //! Build a module manager loaded with the pipeline modules (not initialized)
+    std::unique_ptr<dpp::module_manager> make_module_manager(const FLReconstructParams & flRecParameters_,
+                                                             datatools::service_manager & recServices_)
+    {
       // Dual strategy here
       //  - If they supplied a script, use that, otherwise default to
       //  a single dump module.
       std::unique_ptr<dpp::module_manager> moduleManager(new dpp::module_manager);
-      moduleManager->set_service_manager(recServices);
+      moduleManager->set_service_manager(recServices_);
 
       // Configure the modules themselves
+      // When profiling, each module is wrapped by a profiling module of the same name
+      const bool profiling = !flRecParameters_.profileFile.empty();
       if (!flRecParameters_.modulesConfig.empty()) {
         DT_LOG_DEBUG(flRecParameters_.logLevel, "Loading modules from modules definition...");
         // << flRecParameters_.modulesConfig << "'...");
-        moduleManager->load_modules(flRecParameters_.modulesConfig);
+        if (profiling) {
+          moduleManager->load_modules(make_profiled_modules_config(flRecParameters_.modulesConfig));
+        } else {
+          moduleManager->load_modules(flRecParameters_.modulesConfig);
+        }
       } else {
         // Hand configure a dumb dump module
         DT_LOG_DEBUG(flRecParameters_.logLevel, "Dump module...");
         datatools::properties dumbConfig;
         dumbConfig.store("title", "flreconstruct::default");
         dumbConfig.store("output", "cout");
-        moduleManager->load_module(flRecParameters_.reconstructionPipelineModule, "dpp::dump_module",
+        std::string dumbType = "dpp::dump_module";
+        if (profiling) {
+          dumbConfig.store(ProfilingModule::wrapped_type_key(), dumbType);
+          dumbType = "FLReconstruct::ProfilingModule";
+        }
+        moduleManager->load_module(flRecParameters_.reconstructionPipelineModule, dumbType,
                                    dumbConfig);
       }
+      return moduleManager;
+    }
 
-      datatools::library_loader altLibLoader;
-      // Load a Things2Root module in the manager before initialization
-      if (!flRecParameters_.outputFile.empty()) {
-        if (boost::algorithm::ends_with(flRecParameters_.outputFile, ".root")) {
-          std::string pluginPath = falaise::get_plugin_dir();
-          altLibLoader.load("Things2Root", pluginPath);
-          datatools::properties t2rConfig;
-          t2rConfig.store("output_file", flRecParameters_.outputFile);
-          moduleManager->load_module("t2rRecOutput", "Things2Root", t2rConfig);
+    //! Return the names of the pipeline modules driven by a pseudo-random number generator
+    //!
+    //! Such modules are recognized from their type, or from the "random.seed"/"random.id"
+    //! properties used by Falaise modules to configure their embedded PRNG. Their results
+    //! depend on the sequence of events each instance processes, so they cannot be
+    //! replicated in several worker threads without changing the output.
+    std::vector<std::string> find_seeded_modules(const dpp::module_manager & moduleManager_)
+    {
+      static const std::vector<std::string> seededTypes = {
+        "snemo::processing::mock_calorimeter_s2c_module",
+        "snemo::processing::mock_tracker_s2c_module"
+      };
+      std::vector<std::string> seeded;
+      for (const auto & entry : moduleManager_.get_modules()) {
+        const datatools::properties & config = entry.second.get_module_config();
+        std::string moduleType = entry.second.get_module_id();
+        // Profiled modules wrap the actual module type
+        if (config.has_key(ProfilingModule::wrapped_type_key())) {
+          moduleType = config.fetch_string(ProfilingModule::wrapped_type_key());
+        }
+        if (std::find(seededTypes.begin(), seededTypes.end(), moduleType) != seededTypes.end() ||
+            config.has_key("random.seed") || config.has_key("random.id")) {
+          seeded.push_back(entry.first);
         }
       }
+      return seeded;
+    }
+
+    //! \brief Reconstruction services and pipeline modules ready to process input files
+    //!
+    //! Plugins, services (geometry...) and pipeline modules are set up once at
+    //! construction, so that a resident process can run successive input files
+    //! without paying for the initialization again.
+    class PipelineSession
+    {
+    public:
+      //! Load plugins, start services and initialize the pipeline modules
+      explicit PipelineSession(const FLReconstructParams & flRecParameters_);
+
+      //! Reset modules and services if not done yet
+      ~PipelineSession();
+
+      PipelineSession(const PipelineSession &) = delete;
+      PipelineSession & operator=(const PipelineSession &) = delete;
+
+      //! Process an input file and store the results in an output file (none if empty)
+      //! \param processed_ receives the number of processed input data records
+      falaise::exit_code run(const std::string & inputFile_, const std::string & outputFile_,
+                             std::size_t & processed_);
+
+      //! Reset the modules and services
+      void close();
+
+    private:
+      //! Build and initialize the output module for an output file (null if empty)
+      std::unique_ptr<dpp::base_module> make_output_module_(const std::string & outputFile_,
+                                                            const datatools::multi_properties & metadata_);
+
+    private:
+      const FLReconstructParams & params_;                                  //!< Configuration
+      datatools::library_loader libLoader_;                                 //!< Plugins loader
+      datatools::library_loader altLibLoader_;                              //!< Output plugins loader
+      bool t2rLoaded_ = false;                                              //!< Flag for the Things2Root plugin
+      std::unique_ptr<datatools::service_manager> services_;                //!< Reconstruction services
+      std::unique_ptr<dpp::module_manager> moduleManager_;                  //!< Pipeline modules
+      std::vector<std::unique_ptr<dpp::module_manager>> workerModuleManagers_; //!< Pipeline modules of the extra worker threads
+      dpp::base_module * pipeline_ = nullptr;                               //!< Pipeline module
+      std::vector<dpp::base_module *> workerPipelines_;                     //!< Pipeline module of each worker thread
+    };
+
+    PipelineSession::PipelineSession(const FLReconstructParams & flRecParameters_)
+      : params_(flRecParameters_)
+      , libLoader_(flRecParameters_.userLibConfig)
+    {
+      // Heap allocations are only counted when the modules are profiled
+      if (!params_.profileFile.empty()) {
+        set_allocation_counting(true);
+      }
+
+      // Setup services:
+      DT_LOG_DEBUG(params_.logLevel, "Starting reconstruction services...");
+      uint32_t servicesFlags = datatools::service_manager::BLANK;
+      servicesFlags |= datatools::service_manager::ALLOW_DYNAMIC_SERVICES;
+      services_.reset(new datatools::service_manager("flReconstructionServices",
+                                                     "SuperNEMO Reconstruction Services", servicesFlags));
+      if (!params_.servicesSubsystemConfig.empty()) {
+        // Load services:
+        std::string services_config_file = params_.servicesSubsystemConfig;
+        datatools::fetch_path_with_env(services_config_file);
+        datatools::properties services_config;
+        services_config.read_configuration(services_config_file);
+        services_->initialize(services_config);
+      } else {
+        services_->initialize();
+      }
+      if (datatools::logger::is_debug(params_.logLevel)) {
+        services_->tree_dump(std::cerr, "Reconstruction services: ", "[debug] ");
+      }
+
+      // Make sure some core services are setup and started (geometry, electronics, database...):
+      falaise::exit_code safeServicesCode = ensure_core_services(params_, *services_);
+      DT_THROW_IF(safeServicesCode != falaise::EXIT_OK, std::logic_error,
+                  "Cannot start core services!");
+
+      // - Start up the module manager
+      moduleManager_ = make_module_manager(params_, *services_);
+
+      // Worker threads would each run their own copy of the PRNG driven modules,
+      // with the same seed, over a subset of the events:
+      if (params_.numberOfThreads > 1) {
+        std::vector<std::string> seededModules = find_seeded_modules(*moduleManager_);
+        DT_THROW_IF(!seededModules.empty(), std::logic_error,
+                    "Pipeline module '" << seededModules.front()
+                    << "' uses a pseudo-random number generator and cannot run in "
+                    << params_.numberOfThreads << " worker threads; use a single thread!");
+      }
 
       // Plain initialization:
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Module manager initialization...");
-      moduleManager->initialize_simple();
-      if (datatools::logger::is_debug(flRecParameters_.logLevel)) {
-        moduleManager->tree_dump(std::cerr, "Initialized module manager: ", "[debug] ");
+      DT_LOG_DEBUG(params_.logLevel, "Module manager initialization...");
+      moduleManager_->initialize_simple();
+      if (datatools::logger::is_debug(params_.logLevel)) {
+        moduleManager_->tree_dump(std::cerr, "Initialized module manager: ", "[debug] ");
+      }
+
+      // Additional module managers for the worker threads, each of them with its own instances
+      // of the pipeline modules sharing the same services (geometry...). Services are all
+      // started and modules initialized here, from the main thread; during the event loop
+      // the modules only query them through const accessors (geometry manager, locators,
+      // cell/OM status and run information), which do not modify shared state.
+      // Managers are initialized one after the other, in the same order at each run.
+      for (unsigned int iworker = 1; iworker < params_.numberOfThreads; iworker++) {
+        DT_LOG_DEBUG(params_.logLevel,
+                     "Module manager initialization for worker thread #" << iworker << "...");
+        workerModuleManagers_.push_back(make_module_manager(params_, *services_));
+        workerModuleManagers_.back()->initialize_simple();
+      }
+
+      // - Pipeline
+      try {
+        pipeline_ = &(moduleManager_->grab(params_.reconstructionPipelineModule));
+        workerPipelines_.push_back(pipeline_);
+        for (auto & workerModuleManager : workerModuleManagers_) {
+          workerPipelines_.push_back(
+            &(workerModuleManager->grab(params_.reconstructionPipelineModule)));
+        }
+      } catch (std::exception & e) {
+        DT_LOG_FATAL(params_.logLevel, "Failed to initialize pipeline : " << e.what());
+        throw;
+      }
+      return;
+    }
+
+    PipelineSession::~PipelineSession()
+    {
+      try {
+        close();
+      } catch (std::exception & e) {
+        DT_LOG_ERROR(params_.logLevel, "Failed to stop the reconstruction pipeline: " << e.what());
+      }
+    }
+
+    void PipelineSession::close()
+    {
+      if (!services_) {
+        return;
+      }
+      // - MUST delete the module managers BEFORE the library loader clears
+      // in case the managers are holding resources created from a shared lib
+      workerPipelines_.clear();
+      pipeline_ = nullptr;
+      for (auto & workerModuleManager : workerModuleManagers_) {
+        if (workerModuleManager->is_initialized()) {
+          workerModuleManager->reset();
+        }
+        workerModuleManager.reset();
+      }
+      workerModuleManagers_.clear();
+      if (moduleManager_ != nullptr) {
+        if (moduleManager_->is_initialized()) {
+          moduleManager_->reset();
+        }
+        moduleManager_.reset();
+      }
+
+      DT_LOG_DEBUG(params_.logLevel, "Stopping reconstruction services...");
+      std::unique_ptr<datatools::service_manager> services = std::move(services_);
+      services->reset();
+      DT_LOG_DEBUG(params_.logLevel, "Reconstruction services are stopped");
+
+      // Profiles are published by the modules when they are reset
+      if (!params_.profileFile.empty()) {
+        std::string profileFile = params_.profileFile;
+        datatools::fetch_path_with_env(profileFile);
+        DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Writing module profile to '" << profileFile << "'");
+        ProfileRegistry::instance().write(profileFile);
+        ProfileRegistry::instance().clear();
+        set_allocation_counting(false);
+      }
+      return;
+    }
+
+    std::unique_ptr<dpp::base_module>
+    PipelineSession::make_output_module_(const std::string & outputFile_,
+                                         const datatools::multi_properties & metadata_)
+    {
+      std::unique_ptr<dpp::base_module> output;
+      if (outputFile_.empty()) {
+        return output;
+      }
+      if (boost::algorithm::ends_with(outputFile_, ".root")) {
+        // Things2Root module from its plugin
+        if (!t2rLoaded_) {
+          std::string pluginPath = falaise::get_plugin_dir();
+          altLibLoader_.load("Things2Root", pluginPath);
+          t2rLoaded_ = true;
+        }
+        const auto & moduleFactoryRegister = DATATOOLS_FACTORY_GET_SYSTEM_REGISTER(dpp::base_module);
+        DT_THROW_IF(!moduleFactoryRegister.has("Things2Root"), std::logic_error,
+                    "Factory register supports no module of type 'Things2Root'!");
+        output.reset(moduleFactoryRegister.get("Things2Root")());
+        output->set_name("t2rRecOutput");
+        datatools::properties t2rConfig;
+        t2rConfig.store("output_file", outputFile_);
+        dpp::module_handle_dict_type noModules;
+        output->initialize(t2rConfig, *services_, noModules);
+        return output;
       }
+      // We try to setup an output module
+      std::unique_ptr<dpp::output_module> flRecOutput(new dpp::output_module);
+      flRecOutput->set_name("FLReconstructOutput");
+      flRecOutput->set_single_output_file(outputFile_);
+      // Metadata management:
+      // Fetch the metadata to be stored through the output module
+      datatools::multi_properties & metadataStore = flRecOutput->grab_metadata_store();
+      // Copy metadata from the input module
+      metadataStore = metadata_;
+      flRecOutput->initialize_simple();
+      output = std::move(flRecOutput);
+      return output;
+    }
+
+    falaise::exit_code PipelineSession::run(const std::string & inputFile_,
+                                            const std::string & outputFile_,
+                                            std::size_t & processed_)
+    {
+      falaise::exit_code code = falaise::EXIT_OK;
+      processed_ = 0;
 
       // Input module...
       std::unique_ptr<dpp::input_module> recInput(new dpp::input_module());
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Configuring the input module...");
+      DT_LOG_DEBUG(params_.logLevel, "Configuring the input module...");
       recInput->set_name("FLReconstructInput");
-      recInput->set_logging_priority(flRecParameters_.logLevel);
-      std::string inFile(flRecParameters_.inputFile);
+      recInput->set_logging_priority(params_.logLevel);
+      std::string inFile(inputFile_);
       datatools::fetch_path_with_env(inFile);
       if (not boost::filesystem::exists(inFile)) {
-        DT_LOG_FATAL(flRecParameters_.logLevel, "Input file '" << inFile << "' does not exist!");
+        DT_LOG_FATAL(params_.logLevel, "Input file '" << inFile << "' does not exist!");
         return falaise::EXIT_UNAVAILABLE;
       }
       recInput->set_single_input_file(inFile);
       recInput->initialize_simple();
 
-      DT_LOG_DEBUG(flRecParameters_.logLevel,
+      DT_LOG_DEBUG(params_.logLevel,
                    "Number of entries  = " << recInput->get_source().get_number_of_entries());
-      DT_LOG_DEBUG(flRecParameters_.logLevel,
+      DT_LOG_DEBUG(params_.logLevel,
                    "Number of metadata = " << recInput->get_source().get_number_of_metadata());
 
       // Output metadata management:
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Building output metadata...");
+      DT_LOG_DEBUG(params_.logLevel, "Building output metadata...");
       datatools::multi_properties flRecMetadata("name", "type",
                                                 "Metadata associated to a flreconstruct run");
-      do_metadata(flRecParameters_, flRecMetadata);
-      if (datatools::logger::is_debug(flRecParameters_.logLevel)) {
+      do_metadata(params_, flRecMetadata);
+      if (datatools::logger::is_debug(params_.logLevel)) {
         flRecMetadata.tree_dump(std::cerr, "Output metadata: ", "[debug] ");
       }
 
-      // - Pipeline
-      dpp::base_module * pipeline = nullptr;
-      try {
-        pipeline = &(moduleManager->grab(flRecParameters_.reconstructionPipelineModule));
-      } catch (std::exception & e) {
-        DT_LOG_FATAL(flRecParameters_.logLevel, "Failed to initialize pipeline : " << e.what());
-        return falaise::EXIT_UNAVAILABLE;
-      }
+      // Output module... only if an output file is requested
+      std::unique_ptr<dpp::base_module> recOutput = make_output_module_(outputFile_, flRecMetadata);
+      dpp::base_module * recOutputHandle = recOutput.get();
 
-      // Output module... only if added in the module manager
-      dpp::base_module * recOutputHandle = nullptr;
-      std::unique_ptr<dpp::output_module> flRecOutput;
-      if (moduleManager->has("t2rRecOutput")) {
-        // We instantiate and fetch the t2r module from the manager
-        recOutputHandle = &moduleManager->grab("t2rRecOutput");
-      } else if (!flRecParameters_.outputFile.empty()) {
-        // We try to setup an output module
-        flRecOutput.reset(new dpp::output_module);
-        flRecOutput->set_name("FLReconstructOutput");
-        flRecOutput->set_single_output_file(flRecParameters_.outputFile);
-        // Metadata management:
-        // Fetch the metadata to be stored through the output module
-        datatools::multi_properties & metadataStore = flRecOutput->grab_metadata_store();
-        // Copy metadata from the input module
-        metadataStore = flRecMetadata;
-        flRecOutput->initialize_simple();
-        recOutputHandle = flRecOutput.get();
-      }
-
-      if (!flRecParameters_.outputMetadataFile.empty()) {
-        std::string fMetadata = flRecParameters_.outputMetadataFile;
+      if (!params_.outputMetadataFile.empty()) {
+        std::string fMetadata = params_.outputMetadataFile;
         datatools::fetch_path_with_env(fMetadata);
         flRecMetadata.write(fMetadata);
       }
 
       // - Now the actual data record/event loop
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Begin data record/event loop");
-      datatools::things workItem;
+      DT_LOG_DEBUG(params_.logLevel, "Begin data record/event loop");
       std::size_t dataRecordCounter = 0;
-      while (true) {
-        // DT_LOG_DEBUG(datatools::logger::PRIO_DEBUG, "==========> Pipeline loop for data record/event #" << dataRecordCounter);
-        // Prepare and read work
-        if (recInput->is_terminated()) {
-          DT_LOG_DEBUG(datatools::logger::PRIO_DEBUG, "Input module is terminated");
-          break;
-        }
-        workItem.clear();
-        if (recInput->process(workItem) != dpp::base_module::PROCESS_OK) {
-          DT_LOG_FATAL(flRecParameters_.logLevel, "Failed to read data record from input source");
-          code = falaise::EXIT_UNAVAILABLE;
-          break;
-        }
-        if (flRecParameters_.moduloEvents > 0) {
-          if (dataRecordCounter % flRecParameters_.moduloEvents == 0) {
-            DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Data record #" << dataRecordCounter << " about to be processed");
+      if (params_.firstEvent > 0 || params_.endEvent > 0) {
+        DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE,
+                      "Processing input data records from #" << params_.firstEvent
+                      << (params_.endEvent > 0 ? " to #" + std::to_string(params_.endEvent - 1)
+                                               : std::string(" to the end of input")));
+      }
+      RecordReader recReader(*recInput, params_.inputPrefetch, params_.logLevel,
+                             params_.firstEvent, params_.endEvent);
+      std::unique_ptr<falaise::async_writer> recWriter;
+      if (recOutputHandle != nullptr && params_.outputQueue > 0) {
+        DT_LOG_DEBUG(params_.logLevel,
+                     "Writing output data records from a thread with queue size " << params_.outputQueue);
+        recWriter.reset(new falaise::async_writer(*recOutputHandle, params_.outputQueue));
+      }
+      if (params_.inputPrefetch > 0) {
+        DT_LOG_DEBUG(params_.logLevel,
+                     "Prefetching up to " << params_.inputPrefetch << " input data records");
+      }
+      if (workerPipelines_.size() > 1) {
+        DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE,
+                      "Running the pipeline in " << workerPipelines_.size() << " worker threads");
+        PipelineWorkers workers(workerPipelines_, params_.logLevel);
+        bool inputDone = false;
+        while (true) {
+          // Keep the worker threads busy with data records read in advance
+          while (!inputDone && workers.in_flight() < workers.capacity()) {
+            std::unique_ptr<datatools::things> inputItem;
+            RecordReader::read_status rStatus = recReader.read(inputItem);
+            if (rStatus == RecordReader::READ_END) {
+              DT_LOG_DEBUG(datatools::logger::PRIO_DEBUG, "Input module is terminated");
+              inputDone = true;
+              break;
+            }
+            if (rStatus == RecordReader::READ_ERROR) {
+              DT_LOG_FATAL(params_.logLevel, "Failed to read data record from input source");
+              code = falaise::EXIT_UNAVAILABLE;
+              inputDone = true;
+              break;
+            }
+            workers.submit(std::move(inputItem));
           }
-        }
-
-        // Feed through pipeline
-        dpp::base_module::process_status pStatus = pipeline->process(workItem);
-        DT_THROW_IF(pStatus == dpp::base_module::PROCESS_INVALID, std::logic_error,
-                    "Module '" << pipeline->get_name() << "' did not return a valid processing status!");
 
-        // FATAL, ERROR and ERROR_STOP status triggers the abortion of the processing loop.
-        // This is a very conservative approach, but it is compatible with the default behaviour of
-        // the bxdpp_processing executable.
-        if (pStatus == dpp::base_module::PROCESS_FATAL) {
-          code = falaise::EXIT_UNAVAILABLE;
-          break;
-        }
-        if (pStatus == dpp::base_module::PROCESS_ERROR) {
-          code = falaise::EXIT_UNAVAILABLE;
-          break;
-        }
-        if (pStatus == dpp::base_module::PROCESS_ERROR_STOP) {
-          code = falaise::EXIT_UNAVAILABLE;
-          break;
+          // Collect processed data records in input order
+          PipelineRecord record;
+          if (!workers.next(record)) {
+            break;
+          }
+          record_action action = check_pipeline_status(*pipeline_, record.status);
+          if (action == RECORD_ABORT) {
+            code = falaise::EXIT_UNAVAILABLE;
+            break;
+          }
+          if (action == RECORD_SKIP) {
+            continue;
+          }
+          if (!write_record(recOutputHandle, recWriter.get(), record.data)) {
+            DT_LOG_FATAL(params_.logLevel, "Failed to write data record to output sink");
+            code = falaise::EXIT_UNAVAILABLE;
+            break;
+          }
+          if (params_.moduloEvents > 0) {
+            if (dataRecordCounter % params_.moduloEvents == 0) {
+              DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Data record #" << dataRecordCounter << " has been processed");
+            }
+          }
+          dataRecordCounter++;
+          if (params_.numberOfEvents > 0 && dataRecordCounter >= params_.numberOfEvents) {
+            break;
+          }
         }
+        workers.stop();
+      } else {
+        std::unique_ptr<datatools::things> workItemPtr;
+        while (true) {
+          // DT_LOG_DEBUG(datatools::logger::PRIO_DEBUG, "==========> Pipeline loop for data record/event #" << dataRecordCounter);
+          // Prepare and read work
+          RecordReader::read_status rStatus = recReader.read(workItemPtr);
+          if (rStatus == RecordReader::READ_END) {
+            DT_LOG_DEBUG(datatools::logger::PRIO_DEBUG, "Input module is terminated");
+            break;
+          }
+          if (rStatus == RecordReader::READ_ERROR) {
+            DT_LOG_FATAL(params_.logLevel, "Failed to read data record from input source");
+            code = falaise::EXIT_UNAVAILABLE;
+            break;
+          }
+          datatools::things & workItem = *workItemPtr;
+          if (params_.moduloEvents > 0) {
+            if (dataRecordCounter % params_.moduloEvents == 0) {
+              DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Data record #" << dataRecordCounter << " about to be processed");
+            }
+          }
 
-        // STOP means the current data record/event should not be processed anymore nor saved
-        // but the loop can continue with other items
-        if (pStatus == dpp::base_module::PROCESS_STOP) {
-          continue;
-        }
+          // Feed through pipeline
+          dpp::base_module::process_status pStatus = pipeline_->process(workItem);
+          record_action action = check_pipeline_status(*pipeline_, pStatus);
+          if (action == RECORD_ABORT) {
+            code = falaise::EXIT_UNAVAILABLE;
+            break;
+          }
+          if (action == RECORD_SKIP) {
+            continue;
+          }
 
-        // Check post-conditions on data record/event model (expectedOutputBanks) ?
+          // Check post-conditions on data record/event model (expectedOutputBanks) ?
 
-        // Write item
-        if (recOutputHandle != nullptr) {
-          pStatus = recOutputHandle->process(workItem);
-          if (pStatus != dpp::base_module::PROCESS_OK) {
-            DT_LOG_FATAL(flRecParameters_.logLevel, "Failed to write data record to output sink");
+          // Write item
+          if (!write_record(recOutputHandle, recWriter.get(), workItemPtr)) {
+            DT_LOG_FATAL(params_.logLevel, "Failed to write data record to output sink");
             code = falaise::EXIT_UNAVAILABLE;
             break;
           }
-        }
-        if (flRecParameters_.moduloEvents > 0) {
-          if (dataRecordCounter % flRecParameters_.moduloEvents == 0) {
-            DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Data record #" << dataRecordCounter << " has been processed");
+          if (params_.moduloEvents > 0) {
+            if (dataRecordCounter % params_.moduloEvents == 0) {
+              DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Data record #" << dataRecordCounter << " has been processed");
+            }
+          }
+          dataRecordCounter++;
+          // 2024-03-14 FM : change condition "dataRecordCounter >" to "dataRecordCounter >="
+          if (params_.numberOfEvents > 0 && dataRecordCounter >= params_.numberOfEvents) {
+            break;
           }
         }
-        dataRecordCounter++;
-	// 2024-03-14 FM : change condition "dataRecordCounter >" to "dataRecordCounter >="
-        if (flRecParameters_.numberOfEvents > 0 && dataRecordCounter >= flRecParameters_.numberOfEvents) {
-          break;
+      }
+      recReader.stop();
+      if (recWriter) {
+        // Flush pending output data records before the output module is reset
+        if (!recWriter->finish()) {
+          DT_LOG_FATAL(params_.logLevel,
+                       "Failed to write data record to output sink: " << recWriter->error_message());
+          code = falaise::EXIT_UNAVAILABLE;
         }
+        recWriter.reset();
+      }
+      // Close the output file
+      if (recOutput && recOutput->is_initialized()) {
+        recOutput->reset();
       }
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Data record loop completed");
+      DT_LOG_DEBUG(params_.logLevel, "Data record loop completed");
       DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Number of processed input data records = " << dataRecordCounter);
+      processed_ = dataRecordCounter;
+      return code;
+    }
 
-      // - MUST delete the module manager BEFORE the library loader clears
-      // in case the manager is holding resources created from a shared lib
-      if (moduleManager != nullptr) {
-        if (moduleManager->is_initialized()) {
-          moduleManager->reset();
-        }
-        moduleManager.reset();
-      }
+  } // namespace
 
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Stopping reconstruction services...");
-      recServices.reset();
-      DT_LOG_DEBUG(flRecParameters_.logLevel, "Reconstruction services are stopped");
+  //! Configure and run the pipeline
+  falaise::exit_code do_pipeline(const FLReconstructParams & flRecParameters_)
+  {
+    DT_LOG_TRACE_ENTERING(flRecParameters_.logLevel);
+
+    // - Run:
+    falaise::exit_code code = falaise::EXIT_OK;
+    try {
+      PipelineSession session(flRecParameters_);
+      std::size_t processed = 0;
+      code = session.run(flRecParameters_.inputFile, flRecParameters_.outputFile, processed);
+      session.close();
     } catch (std::exception & e) {
       std::cerr << "flreconstruct : Setup/run of simulation threw exception" << std::endl;
       std::cerr << e.what() << std::endl;
@@ -265,6 +579,62 @@ namespace FLReconstruct {
     return code; // falaise::EXIT_OK;
   }
 
+  falaise::exit_code do_serve(const FLReconstructParams & flRecParameters_,
+                              std::istream & jobs_, std::ostream & replies_)
+  {
+    DT_LOG_TRACE_ENTERING(flRecParameters_.logLevel);
+
+    falaise::exit_code code = falaise::EXIT_OK;
+    try {
+      PipelineSession session(flRecParameters_);
+      DT_LOG_NOTICE(datatools::logger::PRIO_NOTICE, "Reconstruction pipeline is ready to serve jobs");
+      replies_ << "READY" << std::endl;
+      std::string line;
+      while (std::getline(jobs_, line)) {
+        boost::algorithm::trim(line);
+        if (line.empty() || line[0] == '#') {
+          continue;
+        }
+        if (line == "quit" || line == "exit") {
+          break;
+        }
+        std::vector<std::string> tokens;
+        boost::algorithm::split(tokens, line, boost::algorithm::is_space(),
+                                boost::algorithm::token_compress_on);
+        if (tokens.size() > 2) {
+          replies_ << "ERROR " << tokens[0] << " invalid job, expected '<input> [<output>]'" << std::endl;
+          continue;
+        }
+        const std::string & inputFile = tokens[0];
+        const std::string outputFile = tokens.size() > 1 ? tokens[1] : std::string();
+        std::size_t processed = 0;
+        falaise::exit_code jobCode = falaise::EXIT_UNAVAILABLE;
+        std::string why = "processing failed";
+        try {
+          // Jobs from another setup or user profile would be processed with the wrong
+          // geometry and conditions
+          do_check_job_input_metadata(flRecParameters_, inputFile);
+          jobCode = session.run(inputFile, outputFile, processed);
+        } catch (std::exception & e) {
+          DT_LOG_ERROR(flRecParameters_.logLevel, "Job '" << line << "' failed: " << e.what());
+          why = e.what();
+        }
+        if (jobCode == falaise::EXIT_OK) {
+          replies_ << "OK " << inputFile << ' ' << processed << std::endl;
+        } else {
+          std::replace(why.begin(), why.end(), '\n', ' ');
+          replies_ << "ERROR " << inputFile << ' ' << why << std::endl;
+        }
+      }
+      session.close();
+    } catch (std::exception & e) {
+      std::cerr << "flreconstruct : Setup/run of reconstruction server threw exception" << std::endl;
+      std::cerr << e.what() << std::endl;
+      code = falaise::EXIT_UNAVAILABLE;
+    }
+    return code;
+  }
+
   falaise::exit_code ensure_core_services(const FLReconstructParams & recParams_,
                                           datatools::service_manager & recServices_)
   {
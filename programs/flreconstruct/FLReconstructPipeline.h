@@ -15,6 +15,9 @@
 #ifndef FLRECONSTRUCTPIPELINE_H
 #define FLRECONSTRUCTPIPELINE_H
 
+// Standard Library:
+#include <iostream>
+
 // Third party
 //  - Bayeux:
 #include "bayeux/datatools/service_manager.h"
@@ -28,6 +31,15 @@ namespace FLReconstruct {
   //! Run the pipeline after configuration step
   falaise::exit_code do_pipeline(const FLReconstructParams & flRecParameters);
 
+  //! Keep the pipeline initialized and run the jobs read from a stream
+  //!
+  //! Each job is a line "<input> [<output>]", answered on the replies stream by a line
+  //! "OK <input> <number of processed records>" or "ERROR <input> <reason>". A "READY"
+  //! line is sent once the services and modules are initialized, and the server stops
+  //! at the end of the jobs stream or on a "quit" line.
+  falaise::exit_code do_serve(const FLReconstructParams & flRecParameters,
+                              std::istream & jobs, std::ostream & replies);
+
   //! Ensure some critical services are setup
   falaise::exit_code ensure_core_services(const FLReconstructParams & recParams,
                                           datatools::service_manager & recServices);
@@ -0,0 +1,514 @@
+// Ourselves
+#include "FLReconstructProfiler.h"
+
+// Standard Library
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+// Third Party
+// - Boost
+#include <boost/algorithm/string.hpp>
+// - Bayeux
+#include "bayeux/datatools/exception.h"
+#include "bayeux/datatools/service_manager.h"
+
+//----------------------------------------------------------------------
+// Heap allocation accounting
+//
+// Replacing the global allocation functions of the flreconstruct executable
+// lets the profiler measure the memory requested by each module without any
+// instrumentation of the modules themselves. The bookkeeping is a thread local
+// counter updated only while profiling; otherwise each allocation pays for
+// the relaxed load of a flag.
+namespace {
+  std::atomic<bool> allocationCounting{false};
+  thread_local std::uint64_t threadAllocatedBytes = 0;
+
+  //! Call the new handler after a failed allocation, or throw if there is none
+  void handle_allocation_failure()
+  {
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+    return;
+  }
+
+  void * counted_allocate(std::size_t size_)
+  {
+    if (allocationCounting.load(std::memory_order_relaxed)) {
+      threadAllocatedBytes += size_;
+    }
+    if (size_ == 0) {
+      size_ = 1;
+    }
+    while (true) {
+      void * p = std::malloc(size_);
+      if (p != nullptr) {
+        return p;
+      }
+      handle_allocation_failure();
+    }
+  }
+
+#if defined(__cpp_aligned_new)
+  void * counted_allocate(std::size_t size_, std::align_val_t alignment_)
+  {
+    if (allocationCounting.load(std::memory_order_relaxed)) {
+      threadAllocatedBytes += size_;
+    }
+    if (size_ == 0) {
+      size_ = 1;
+    }
+    // posix_memalign needs a multiple of the pointer size
+    std::size_t alignment = std::max(static_cast<std::size_t>(alignment_), sizeof(void *));
+    while (true) {
+      void * p = nullptr;
+      if (posix_memalign(&p, alignment, size_) == 0) {
+        return p;
+      }
+      handle_allocation_failure();
+    }
+  }
+#endif // defined(__cpp_aligned_new)
+} // namespace
+
+void * operator new(std::size_t size_) { return counted_allocate(size_); }
+
+void * operator new[](std::size_t size_) { return counted_allocate(size_); }
+
+void * operator new(std::size_t size_, const std::nothrow_t &) noexcept
+{
+  try {
+    return counted_allocate(size_);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void * operator new[](std::size_t size_, const std::nothrow_t &) noexcept
+{
+  try {
+    return counted_allocate(size_);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void * ptr_) noexcept { std::free(ptr_); }
+
+void operator delete[](void * ptr_) noexcept { std::free(ptr_); }
+
+void operator delete(void * ptr_, std::size_t) noexcept { std::free(ptr_); }
+
+void operator delete[](void * ptr_, std::size_t) noexcept { std::free(ptr_); }
+
+void operator delete(void * ptr_, const std::nothrow_t &) noexcept { std::free(ptr_); }
+
+void operator delete[](void * ptr_, const std::nothrow_t &) noexcept { std::free(ptr_); }
+
+#if defined(__cpp_aligned_new)
+void * operator new(std::size_t size_, std::align_val_t alignment_)
+{
+  return counted_allocate(size_, alignment_);
+}
+
+void * operator new[](std::size_t size_, std::align_val_t alignment_)
+{
+  return counted_allocate(size_, alignment_);
+}
+
+void * operator new(std::size_t size_, std::align_val_t alignment_, const std::nothrow_t &) noexcept
+{
+  try {
+    return counted_allocate(size_, alignment_);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void * operator new[](std::size_t size_, std::align_val_t alignment_, const std::nothrow_t &) noexcept
+{
+  try {
+    return counted_allocate(size_, alignment_);
+  } catch (...) {
+    return nullptr;
+  }
+}
+
+void operator delete(void * ptr_, std::align_val_t) noexcept { std::free(ptr_); }
+
+void operator delete[](void * ptr_, std::align_val_t) noexcept { std::free(ptr_); }
+
+void operator delete(void * ptr_, std::size_t, std::align_val_t) noexcept { std::free(ptr_); }
+
+void operator delete[](void * ptr_, std::size_t, std::align_val_t) noexcept { std::free(ptr_); }
+
+void operator delete(void * ptr_, std::align_val_t, const std::nothrow_t &) noexcept { std::free(ptr_); }
+
+void operator delete[](void * ptr_, std::align_val_t, const std::nothrow_t &) noexcept { std::free(ptr_); }
+#endif // defined(__cpp_aligned_new)
+
+namespace FLReconstruct {
+
+  void set_allocation_counting(bool enabled_)
+  {
+    allocationCounting.store(enabled_);
+    return;
+  }
+
+  std::uint64_t thread_allocated_bytes()
+  {
+    return threadAllocatedBytes;
+  }
+
+  namespace {
+
+    //! Bookkeeping of the profiled module currently running in this thread
+    struct ProfilingFrame
+    {
+      double childTime = 0.0;
+      std::uint64_t childAllocatedBytes = 0;
+    };
+
+    thread_local ProfilingFrame * currentFrame = nullptr;
+
+    //! Lower edge of the first regular bin of the call time histograms (us)
+    const double minBinnedTime = 0.1;
+
+    //! Summary of a module profile, as reported
+    struct ProfileSummary
+    {
+      double meanTime = 0.0;   //!< us
+      double p50Time = 0.0;    //!< us
+      double p90Time = 0.0;    //!< us
+      double p99Time = 0.0;    //!< us
+      double maxTime = 0.0;    //!< us
+      double meanAllocatedBytes = 0.0;
+      double meanSelfAllocatedBytes = 0.0;
+    };
+
+    ProfileSummary summarize(const ModuleProfile & profile_)
+    {
+      ProfileSummary summary;
+      if (profile_.calls == 0) {
+        return summary;
+      }
+      summary.meanTime = 1.e6 * profile_.totalTime / profile_.calls;
+      summary.p50Time = profile_.callTimes.quantile(0.50);
+      summary.p90Time = profile_.callTimes.quantile(0.90);
+      summary.p99Time = profile_.callTimes.quantile(0.99);
+      summary.maxTime = profile_.callTimes.max();
+      summary.meanAllocatedBytes = static_cast<double>(profile_.allocatedBytes) / profile_.calls;
+      summary.meanSelfAllocatedBytes = static_cast<double>(profile_.selfAllocatedBytes) / profile_.calls;
+      return summary;
+    }
+
+    //! Escape a string for inclusion in a JSON document
+    std::string json_escape(const std::string & text_)
+    {
+      std::ostringstream out;
+      for (char c : text_) {
+        switch (c) {
+        case '"':
+          out << "\\\"";
+          break;
+        case '\\':
+          out << "\\\\";
+          break;
+        case '\n':
+          out << "\\n";
+          break;
+        case '\t':
+          out << "\\t";
+          break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                << static_cast<int>(c) << std::dec;
+          } else {
+            out << c;
+          }
+        }
+      }
+      return out.str();
+    }
+
+  } // namespace
+
+  //----------------------------------------------------------------------
+  // CallTimeHistogram
+  void CallTimeHistogram::add(double time_)
+  {
+    // Bin 0 is the underflow, bin nbins - 1 the overflow
+    std::size_t bin = 0;
+    if (time_ >= minBinnedTime) {
+      double decades = std::log10(time_ / minBinnedTime);
+      bin = 1 + static_cast<std::size_t>(std::min(decades * binsPerDecade, nbins - 2.0));
+    }
+    bins_[bin]++;
+    count_++;
+    max_ = std::max(max_, time_);
+    return;
+  }
+
+  void CallTimeHistogram::merge(const CallTimeHistogram & other_)
+  {
+    for (std::size_t bin = 0; bin < nbins; bin++) {
+      bins_[bin] += other_.bins_[bin];
+    }
+    count_ += other_.count_;
+    max_ = std::max(max_, other_.max_);
+    return;
+  }
+
+  std::uint64_t CallTimeHistogram::count() const
+  {
+    return count_;
+  }
+
+  double CallTimeHistogram::max() const
+  {
+    return max_;
+  }
+
+  double CallTimeHistogram::quantile(double q_) const
+  {
+    if (count_ == 0) {
+      return 0.0;
+    }
+    // Same rank as the nearest-rank quantile of the sorted call times
+    const auto rank = static_cast<std::uint64_t>(q_ * (count_ - 1) + 0.5);
+    std::uint64_t cumulated = 0;
+    for (std::size_t bin = 0; bin < nbins - 1; bin++) {
+      cumulated += bins_[bin];
+      if (cumulated > rank) {
+        const double upperEdge = minBinnedTime * std::pow(10.0, static_cast<double>(bin) / binsPerDecade);
+        return std::min(upperEdge, max_);
+      }
+    }
+    return max_;
+  }
+
+  //----------------------------------------------------------------------
+  // ModuleProfile
+  void ModuleProfile::merge(const ModuleProfile & other_)
+  {
+    calls += other_.calls;
+    totalTime += other_.totalTime;
+    selfTime += other_.selfTime;
+    allocatedBytes += other_.allocatedBytes;
+    selfAllocatedBytes += other_.selfAllocatedBytes;
+    callTimes.merge(other_.callTimes);
+    return;
+  }
+
+  //----------------------------------------------------------------------
+  // ProfileRegistry
+  ProfileRegistry & ProfileRegistry::instance()
+  {
+    static ProfileRegistry registry;
+    return registry;
+  }
+
+  void ProfileRegistry::merge(const ModuleProfile & profile_)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto & p : profiles_) {
+      if (p.name == profile_.name) {
+        p.merge(profile_);
+        return;
+      }
+    }
+    profiles_.push_back(profile_);
+    return;
+  }
+
+  void ProfileRegistry::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    profiles_.clear();
+    return;
+  }
+
+  void ProfileRegistry::write_json(std::ostream & out_) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_ << "{\n  \"modules\": [";
+    for (std::size_t i = 0; i < profiles_.size(); i++) {
+      const ModuleProfile & p = profiles_[i];
+      ProfileSummary s = summarize(p);
+      out_ << (i == 0 ? "\n" : ",\n");
+      out_ << "    {\n";
+      out_ << "      \"name\": \"" << json_escape(p.name) << "\",\n";
+      out_ << "      \"type\": \"" << json_escape(p.type) << "\",\n";
+      out_ << "      \"calls\": " << p.calls << ",\n";
+      out_ << "      \"total_time_s\": " << p.totalTime << ",\n";
+      out_ << "      \"self_time_s\": " << p.selfTime << ",\n";
+      out_ << "      \"mean_time_us\": " << s.meanTime << ",\n";
+      out_ << "      \"p50_time_us\": " << s.p50Time << ",\n";
+      out_ << "      \"p90_time_us\": " << s.p90Time << ",\n";
+      out_ << "      \"p99_time_us\": " << s.p99Time << ",\n";
+      out_ << "      \"max_time_us\": " << s.maxTime << ",\n";
+      out_ << "      \"allocated_bytes\": " << p.allocatedBytes << ",\n";
+      out_ << "      \"self_allocated_bytes\": " << p.selfAllocatedBytes << ",\n";
+      out_ << "      \"mean_allocated_bytes\": " << s.meanAllocatedBytes << ",\n";
+      out_ << "      \"mean_self_allocated_bytes\": " << s.meanSelfAllocatedBytes << "\n";
+      out_ << "    }";
+    }
+    out_ << (profiles_.empty() ? "]\n" : "\n  ]\n") << "}\n";
+    return;
+  }
+
+  void ProfileRegistry::write_csv(std::ostream & out_) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    out_ << "name,type,calls,total_time_s,self_time_s,mean_time_us,p50_time_us,p90_time_us,"
+         << "p99_time_us,max_time_us,allocated_bytes,self_allocated_bytes,"
+         << "mean_allocated_bytes,mean_self_allocated_bytes\n";
+    for (const auto & p : profiles_) {
+      ProfileSummary s = summarize(p);
+      out_ << p.name << ',' << p.type << ',' << p.calls << ',' << p.totalTime << ','
+           << p.selfTime << ',' << s.meanTime << ',' << s.p50Time << ',' << s.p90Time << ','
+           << s.p99Time << ',' << s.maxTime << ',' << p.allocatedBytes << ','
+           << p.selfAllocatedBytes << ',' << s.meanAllocatedBytes << ','
+           << s.meanSelfAllocatedBytes << '\n';
+    }
+    return;
+  }
+
+  void ProfileRegistry::write(const std::string & path_) const
+  {
+    std::ofstream out(path_);
+    DT_THROW_IF(!out, std::runtime_error, "Cannot open profile file '" << path_ << "'!");
+    if (boost::algorithm::iends_with(path_, ".csv")) {
+      write_csv(out);
+    } else {
+      write_json(out);
+    }
+    DT_THROW_IF(!out, std::runtime_error, "Cannot write profile file '" << path_ << "'!");
+    return;
+  }
+
+  //----------------------------------------------------------------------
+  // ProfilingModule
+  DPP_MODULE_REGISTRATION_IMPLEMENT(ProfilingModule, "FLReconstruct::ProfilingModule")
+
+  const std::string & ProfilingModule::wrapped_type_key()
+  {
+    static const std::string key("profiling.type");
+    return key;
+  }
+
+  ProfilingModule::ProfilingModule(datatools::logger::priority p_)
+    : dpp::base_module(p_)
+  {
+    return;
+  }
+
+  ProfilingModule::~ProfilingModule()
+  {
+    if (is_initialized()) {
+      ProfilingModule::reset();
+    }
+  }
+
+  void ProfilingModule::initialize(const datatools::properties & setup_,
+                                   datatools::service_manager & service_manager_,
+                                   dpp::module_handle_dict_type & module_dict_)
+  {
+    DT_THROW_IF(is_initialized(), std::logic_error,
+                "Module '" << get_name() << "' is already initialized ! ");
+    DT_THROW_IF(!setup_.has_key(wrapped_type_key()), std::logic_error,
+                "Module '" << get_name() << "' has no '" << wrapped_type_key() << "' property!");
+    const std::string wrappedType = setup_.fetch_string(wrapped_type_key());
+
+    const auto & moduleFactoryRegister = DATATOOLS_FACTORY_GET_SYSTEM_REGISTER(dpp::base_module);
+    DT_THROW_IF(!moduleFactoryRegister.has(wrappedType), std::logic_error,
+                "Factory register supports no module of type '" << wrappedType << "'!");
+    wrapped_.reset(moduleFactoryRegister.get(wrappedType)());
+    wrapped_->set_name(get_name());
+
+    datatools::properties wrappedSetup(setup_);
+    wrappedSetup.erase(wrapped_type_key());
+    wrapped_->initialize(wrappedSetup, service_manager_, module_dict_);
+
+    profile_ = ModuleProfile();
+    profile_.name = get_name();
+    profile_.type = wrappedType;
+    _set_initialized(true);
+    return;
+  }
+
+  void ProfilingModule::reset()
+  {
+    DT_THROW_IF(!is_initialized(), std::logic_error,
+                "Module '" << get_name() << "' is not initialized !");
+    _set_initialized(false);
+    ProfileRegistry::instance().merge(profile_);
+    profile_ = ModuleProfile();
+    if (wrapped_->is_initialized()) {
+      wrapped_->reset();
+    }
+    wrapped_.reset();
+    return;
+  }
+
+  dpp::base_module::process_status ProfilingModule::process(datatools::things & data_)
+  {
+    ProfilingFrame frame;
+    ProfilingFrame * parentFrame = currentFrame;
+    currentFrame = &frame;
+    const std::uint64_t startBytes = threadAllocatedBytes;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    process_status status = PROCESS_INVALID;
+    try {
+      status = wrapped_->process(data_);
+    } catch (...) {
+      currentFrame = parentFrame;
+      throw;
+    }
+
+    const double elapsed =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const std::uint64_t allocated = threadAllocatedBytes - startBytes;
+    currentFrame = parentFrame;
+    if (parentFrame != nullptr) {
+      parentFrame->childTime += elapsed;
+      parentFrame->childAllocatedBytes += allocated;
+    }
+
+    profile_.calls++;
+    profile_.totalTime += elapsed;
+    profile_.selfTime += elapsed - frame.childTime;
+    profile_.allocatedBytes += allocated;
+    profile_.selfAllocatedBytes += allocated - frame.childAllocatedBytes;
+    profile_.callTimes.add(1.e6 * elapsed);
+    return status;
+  }
+
+  //----------------------------------------------------------------------
+  datatools::multi_properties make_profiled_modules_config(const datatools::multi_properties & modulesConfig_)
+  {
+    datatools::multi_properties profiledConfig(modulesConfig_.get_key_label(),
+                                               modulesConfig_.get_meta_label(),
+                                               modulesConfig_.get_description());
+    for (const auto & entry : modulesConfig_.ordered_entries()) {
+      datatools::properties & moduleConfig =
+        profiledConfig.add_section(entry->get_key(), "FLReconstruct::ProfilingModule");
+      moduleConfig = entry->get_properties();
+      moduleConfig.store_string(ProfilingModule::wrapped_type_key(), entry->get_meta());
+    }
+    return profiledConfig;
+  }
+
+} // namespace FLReconstruct
@@ -0,0 +1,147 @@
+// Ourselves
+#include "FLReconstructReader.h"
+
+// Standard Library
+#include <exception>
+#include <stdexcept>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/exception.h"
+
+namespace FLReconstruct {
+
+  RecordReader::RecordReader(dpp::input_module & inputModule_, std::size_t prefetch_,
+                             datatools::logger::priority priority_,
+                             std::size_t firstRecord_, std::size_t endRecord_)
+    : input_(inputModule_)
+    , logLevel_(priority_)
+    , first_(firstRecord_)
+    , end_(endRecord_)
+  {
+    DT_THROW_IF(end_ > 0 && end_ <= first_, std::range_error,
+                "Invalid range of input data records [" << first_ << ":" << end_ << "[!");
+    if (prefetch_ > 0) {
+      queue_.reset(new falaise::bounded_queue<std::unique_ptr<datatools::things>>(prefetch_));
+      thread_ = std::thread(&RecordReader::run_, this);
+      DT_LOG_DEBUG(logLevel_, "Started input prefetch thread with depth " << prefetch_);
+    }
+    return;
+  }
+
+  RecordReader::~RecordReader()
+  {
+    stop();
+    return;
+  }
+
+  std::size_t RecordReader::prefetch() const
+  {
+    return queue_ ? queue_->capacity() : 0;
+  }
+
+  RecordReader::read_status RecordReader::read(std::unique_ptr<datatools::things> & record_)
+  {
+    if (queue_) {
+      if (queue_->pop(record_)) {
+        return READ_OK;
+      }
+      return failed_ ? READ_ERROR : READ_END;
+    }
+    if (record_) {
+      record_->clear();
+    } else {
+      record_.reset(new datatools::things);
+    }
+    return fetch_(*record_);
+  }
+
+  void RecordReader::stop()
+  {
+    if (queue_) {
+      queue_->close();
+    }
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    return;
+  }
+
+  void RecordReader::run_()
+  {
+    try {
+      while (true) {
+        std::unique_ptr<datatools::things> record(new datatools::things);
+        read_status status = fetch_(*record);
+        if (status == READ_END) {
+          break;
+        }
+        if (status == READ_ERROR) {
+          failed_ = true;
+          break;
+        }
+        if (!queue_->push(std::move(record))) {
+          // Reading was stopped by the consumer
+          break;
+        }
+      }
+    } catch (std::exception & e) {
+      DT_LOG_FATAL(logLevel_, "Input prefetch thread failed: " << e.what());
+      failed_ = true;
+    }
+    DT_LOG_DEBUG(logLevel_, "Input prefetch thread is done");
+    queue_->close();
+    return;
+  }
+
+  RecordReader::read_status RecordReader::fetch_(datatools::things & record_)
+  {
+    if (end_ > 0 && next_ >= end_) {
+      return READ_END;
+    }
+    if (!positioned_) {
+      positioned_ = true;
+      if (first_ > 0) {
+        return seek_(record_);
+      }
+    }
+    if (input_.is_terminated()) {
+      return READ_END;
+    }
+    if (input_.process(record_) != dpp::base_module::PROCESS_OK) {
+      return READ_ERROR;
+    }
+    next_++;
+    return READ_OK;
+  }
+
+  RecordReader::read_status RecordReader::seek_(datatools::things & record_)
+  {
+    dpp::i_data_source & source = input_.grab_source();
+    const int64_t entry = first_;
+    if (source.can_load_record(entry)) {
+      // Random access: subsequent sequential reads resume after this entry
+      DT_LOG_DEBUG(logLevel_, "Loading input data record #" << entry << " by direct access");
+      if (!source.load_record(record_, entry)) {
+        return READ_ERROR;
+      }
+      next_ = first_ + 1;
+      return READ_OK;
+    }
+    // Sequential-only source: read and drop the leading data records
+    DT_LOG_DEBUG(logLevel_, "Skipping " << first_ << " input data records");
+    while (next_ < first_) {
+      if (input_.is_terminated()) {
+        return READ_END;
+      }
+      record_.clear();
+      if (input_.process(record_) != dpp::base_module::PROCESS_OK) {
+        return READ_ERROR;
+      }
+      next_++;
+    }
+    record_.clear();
+    return fetch_(record_);
+  }
+
+} // namespace FLReconstruct
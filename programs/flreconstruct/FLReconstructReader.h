@@ -0,0 +1,103 @@
+// FLReconstructReader.h - Interface for FLReconstruct input data record reader
+//
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLRECONSTRUCTREADER_H
+#define FLRECONSTRUCTREADER_H
+
+// Standard Library:
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/logger.h"
+#include "bayeux/datatools/things.h"
+#include "bayeux/dpp/i_data_source.h"
+#include "bayeux/dpp/input_module.h"
+
+// This project
+#include "falaise/bounded_queue.h"
+
+namespace FLReconstruct {
+
+  //! \brief Reader of the input data records of the pipeline
+  //!
+  //! Without prefetching, data records are read from the input module on demand
+  //! by the calling thread. With a prefetch depth K > 0, a background thread reads
+  //! and deserializes up to K data records ahead of the pipeline, so that input
+  //! I/O overlaps with the reconstruction of the current event.
+  //!
+  //! The reader can be restricted to a range of input data records, so that
+  //! several jobs process disjoint slices of the same file. The first record of
+  //! the range is reached by direct entry loading when the data source supports
+  //! random access (BRIO files), otherwise the preceding records are read and
+  //! dropped.
+  class RecordReader
+  {
+  public:
+    //! Outcome of a read request
+    enum read_status { READ_OK, READ_END, READ_ERROR };
+
+    //! Construct from an initialized input module and a prefetch depth (0: no prefetch)
+    //! \param firstRecord_ index of the first input data record to be read
+    //! \param endRecord_ index past the last input data record to be read (0: end of input)
+    RecordReader(dpp::input_module & inputModule_, std::size_t prefetch_,
+                 datatools::logger::priority priority_,
+                 std::size_t firstRecord_ = 0, std::size_t endRecord_ = 0);
+
+    //! Stop and join the background thread, if any
+    ~RecordReader();
+
+    RecordReader(const RecordReader &) = delete;
+    RecordReader & operator=(const RecordReader &) = delete;
+
+    //! Return the prefetch depth
+    std::size_t prefetch() const;
+
+    //! Fetch the next data record from the input
+    //! \param record_ receives the data record (reused if already allocated)
+    read_status read(std::unique_ptr<datatools::things> & record_);
+
+    //! Stop reading, discarding prefetched data records
+    void stop();
+
+  private:
+    //! Background thread main loop
+    void run_();
+
+    //! Load the next data record of the range from the input module
+    read_status fetch_(datatools::things & record_);
+
+    //! Move to the first data record of the range, loading it if the source supports random access
+    read_status seek_(datatools::things & record_);
+
+  private:
+    dpp::input_module & input_;                                      //!< Input module
+    datatools::logger::priority logLevel_;                           //!< Logging priority threshold
+    std::size_t first_ = 0;                                          //!< Index of the first data record
+    std::size_t end_ = 0;                                            //!< Index past the last data record (0: none)
+    std::size_t next_ = 0;                                           //!< Index of the next data record
+    bool positioned_ = false;                                        //!< Flag set once the first data record is reached
+    std::unique_ptr<falaise::bounded_queue<std::unique_ptr<datatools::things>>> queue_; //!< Prefetched data records
+    std::atomic<bool> failed_{false};                                //!< Input error flag
+    std::thread thread_;                                             //!< Background reader thread
+  };
+
+} // namespace FLReconstruct
+
+#endif // FLRECONSTRUCTREADER_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
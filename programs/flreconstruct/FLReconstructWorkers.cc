@@ -0,0 +1,89 @@
+// Ourselves
+#include "FLReconstructWorkers.h"
+
+// Standard Library
+#include <exception>
+#include <stdexcept>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/exception.h"
+
+namespace FLReconstruct {
+
+  PipelineWorkers::PipelineWorkers(const std::vector<dpp::base_module *> & pipelines_,
+                                   datatools::logger::priority priority_)
+    : logLevel_(priority_)
+    , modules_(pipelines_)
+  {
+    // Check all pipelines before any thread is started
+    DT_THROW_IF(modules_.empty(), std::logic_error, "No pipeline module for worker threads!");
+    for (const dpp::base_module * pipeline : modules_) {
+      DT_THROW_IF(pipeline == nullptr, std::logic_error, "Null pipeline module for worker thread!");
+    }
+    // Two records per worker: one being processed, one waiting
+    workers_.reset(new falaise::ordered_workers<PipelineRecord>(
+      modules_.size(), 2,
+      [this](std::size_t worker, PipelineRecord & record) { process_(worker, record); }));
+    DT_LOG_DEBUG(logLevel_, "Started " << workers_->size() << " pipeline worker threads");
+    return;
+  }
+
+  PipelineWorkers::~PipelineWorkers()
+  {
+    stop();
+    return;
+  }
+
+  std::size_t PipelineWorkers::size() const
+  {
+    return workers_->size();
+  }
+
+  std::size_t PipelineWorkers::capacity() const
+  {
+    return workers_->capacity();
+  }
+
+  std::size_t PipelineWorkers::in_flight() const
+  {
+    return workers_->in_flight();
+  }
+
+  void PipelineWorkers::submit(std::unique_ptr<datatools::things> data_)
+  {
+    PipelineRecord record;
+    record.index = workers_->submitted();
+    record.data = std::move(data_);
+    // Records skipped by stop() are dropped as if filtered out
+    record.status = dpp::base_module::PROCESS_STOP;
+    workers_->submit(std::move(record));
+    return;
+  }
+
+  bool PipelineWorkers::next(PipelineRecord & record_)
+  {
+    return workers_->next(record_);
+  }
+
+  void PipelineWorkers::stop()
+  {
+    workers_->stop();
+    return;
+  }
+
+  void PipelineWorkers::process_(std::size_t worker_, PipelineRecord & record_)
+  {
+    dpp::base_module * pipeline = modules_[worker_];
+    try {
+      record_.status = pipeline->process(*record_.data);
+    } catch (std::exception & e) {
+      DT_LOG_FATAL(logLevel_, "Module '" << pipeline->get_name()
+                   << "' threw while processing data record #" << record_.index << ": "
+                   << e.what());
+      record_.status = dpp::base_module::PROCESS_FATAL;
+    }
+    return;
+  }
+
+} // namespace FLReconstruct
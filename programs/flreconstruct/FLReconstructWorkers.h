@@ -0,0 +1,96 @@
+// FLReconstructWorkers.h - Interface for FLReconstruct pipeline worker threads
+//
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLRECONSTRUCTWORKERS_H
+#define FLRECONSTRUCTWORKERS_H
+
+// Standard Library:
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/logger.h"
+#include "bayeux/datatools/things.h"
+#include "bayeux/dpp/base_module.h"
+
+// This project
+#include "falaise/ordered_workers.h"
+
+namespace FLReconstruct {
+
+  //! Data record travelling through the threaded event loop
+  struct PipelineRecord
+  {
+    std::size_t index = 0;                    //!< Rank of the record in the input stream
+    std::unique_ptr<datatools::things> data;  //!< The data record
+    //! Status returned by the pipeline for this record
+    dpp::base_module::process_status status = dpp::base_module::PROCESS_INVALID;
+  };
+
+  //! \brief Pool of threads running independent pipeline instances over data records
+  //!
+  //! Each worker thread owns one pipeline module (built by its own module manager)
+  //! so that modules never see concurrent calls. Records are dispatched and retrieved
+  //! by a falaise::ordered_workers pool, so each module instance sees the same sequence
+  //! of records from one run to the other and the output of the application does not
+  //! depend on scheduling.
+  class PipelineWorkers
+  {
+  public:
+    //! Start one worker thread per supplied pipeline module
+    PipelineWorkers(const std::vector<dpp::base_module *> & pipelines_,
+                    datatools::logger::priority priority_);
+
+    //! Stop and join the worker threads
+    ~PipelineWorkers();
+
+    PipelineWorkers(const PipelineWorkers &) = delete;
+    PipelineWorkers & operator=(const PipelineWorkers &) = delete;
+
+    //! Return the number of worker threads
+    std::size_t size() const;
+
+    //! Return the maximum number of records that may be in flight
+    std::size_t capacity() const;
+
+    //! Return the number of submitted records not yet retrieved
+    std::size_t in_flight() const;
+
+    //! Queue a data record for processing
+    void submit(std::unique_ptr<datatools::things> data_);
+
+    //! Wait for the next record in submission order
+    //! \return false if no record is in flight
+    bool next(PipelineRecord & record_);
+
+    //! Discard pending records and join the worker threads
+    void stop();
+
+  private:
+    //! Run the pipeline of a worker over a record
+    void process_(std::size_t worker_, PipelineRecord & record_);
+
+  private:
+    datatools::logger::priority logLevel_;            //!< Logging priority threshold
+    std::vector<dpp::base_module *> modules_;         //!< Pipeline module of each worker
+    //! Worker threads
+    std::unique_ptr<falaise::ordered_workers<PipelineRecord>> workers_;
+  };
+
+} // namespace FLReconstruct
+
+#endif // FLRECONSTRUCTWORKERS_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
@@ -36,6 +36,7 @@
 // along with Falaise.  If not, see <http://www.gnu.org/licenses/>.
 
 // Standard Library
+#include <iostream>
 #include <memory>
 
 // Third Party
@@ -104,7 +105,11 @@ namespace FLReconstruct {
     // - Run
     falaise::exit_code code = falaise::EXIT_OK;
     DT_LOG_DEBUG(flRecParameters.logLevel, "Running the pipeline...");
-    code = do_pipeline(flRecParameters);
+    if (flRecParameters.serve) {
+      code = do_serve(flRecParameters, std::cin, std::cout);
+    } else {
+      code = do_pipeline(flRecParameters);
+    }
     DT_LOG_DEBUG(flRecParameters.logLevel, "Pipeline is done with code=" << code);
 
     // Terminate:
@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Test of the multi-threaded event loop of flreconstruct
+# =======================================================
+#
+# Usage: run.sh <configuration directory>
+#
+# Events are simulated, then calibrated in one thread (the mock calibration
+# modules are driven by a PRNG and are not allowed in several threads).
+# The calibrated events are reconstructed with one and with several worker
+# threads. Both outputs must be identical, event by event.
+#
+set -ex
+
+cfgDir="$1"
+
+flsimulate -c ${cfgDir}/sim.conf -o threads-sim.brio
+
+# PRNG driven modules are refused in threaded mode
+if flreconstruct -i threads-sim.brio -p ${cfgDir}/calibrate.conf --threads 2 -o threads-refused.brio ; then
+  echo >&2 "[error] Mock calibration was accepted in several worker threads!"
+  exit 1
+fi
+
+flreconstruct -i threads-sim.brio -p ${cfgDir}/calibrate.conf -o threads-calibrated.brio
+
+# XML archives carry no creation date, so identical events give identical files
+flreconstruct -i threads-calibrated.brio -p ${cfgDir}/reconstruct.conf --threads 1 -o threads-1.xml
+flreconstruct -i threads-calibrated.brio -p ${cfgDir}/reconstruct.conf --threads 4 -o threads-4.xml
+flreconstruct -i threads-calibrated.brio -p ${cfgDir}/reconstruct.conf --threads 4 --output-queue 8 -o threads-4q.xml
+
+cmp threads-1.xml threads-4.xml
+cmp threads-1.xml threads-4q.xml
+
+# Profiles of the module instances of all worker threads are merged
+flreconstruct -i threads-calibrated.brio -p ${cfgDir}/reconstruct.conf --threads 2 --profile threads-profile.json
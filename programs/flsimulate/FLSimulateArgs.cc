@@ -1,6 +1,9 @@
 // Ourselves
 #include "FLSimulateArgs.h"
 
+// Standard Library
+#include <algorithm>
+
 // Third party:
 // - Boost:
 #include <boost/algorithm/string.hpp>
@@ -89,6 +92,8 @@ namespace FLSimulate {
     params.outputMetadataFile = "";
     params.embeddedMetadata = true;
     params.outputFile = "";
+    params.outputQueue = 0u;
+    params.numberOfJobs = 1u;
 
     // Plugins management:
     params.userLibConfig.reset();
@@ -123,6 +128,8 @@ namespace FLSimulate {
     flSimParameters_.numberOfEvents = args.numberOfEvents;
     flSimParameters_.runNumber = args.runNumber;
     flSimParameters_.firstEventNumber = args.firstEventNumber;
+    flSimParameters_.outputQueue = args.outputQueue;
+    flSimParameters_.numberOfJobs = args.numberOfJobs;
  
     if (static_cast<unsigned int>(!flSimParameters_.mountPoints.empty()) != 0u) {
       // Apply mount points as soon as possible, because manually set file path below
@@ -259,6 +266,16 @@ namespace FLSimulate {
 				      flSimParameters_.simulationManagerParams.number_of_events_modulo);
 	DT_THROW_IF(nem < 0, FLConfigUserError, "Invalid event printing rate : " << nem);
         flSimParameters_.simulationManagerParams.number_of_events_modulo = nem;
+
+        // Number of output events queued for the writer thread:
+        int noq = baseSystem.get<int>("outputQueue", static_cast<int>(flSimParameters_.outputQueue));
+        DT_THROW_IF(noq < 0, FLConfigUserError, "Invalid output queue size : " << noq);
+        flSimParameters_.outputQueue = static_cast<unsigned int>(noq);
+
+        // Number of worker processes:
+        int noj = baseSystem.get<int>("numberOfJobs", static_cast<int>(flSimParameters_.numberOfJobs));
+        DT_THROW_IF(noj <= 0, FLConfigUserError, "Invalid number of jobs : " << noj);
+        flSimParameters_.numberOfJobs = static_cast<unsigned int>(noj);
 	
 		    
         // Do simulation:
@@ -459,6 +476,20 @@ namespace FLSimulate {
       }
     }
 
+    // Worker processes:
+    DT_THROW_IF(flSimParameters_.numberOfJobs == 0, FLConfigUserError,
+                "Invalid number of jobs : " << flSimParameters_.numberOfJobs);
+    if (flSimParameters_.numberOfJobs > 1) {
+      // PRNG states are saved/restored along a single event sequence:
+      DT_THROW_IF(!flSimParameters_.simulationManagerParams.input_prng_states_file.empty() ||
+                  !flSimParameters_.simulationManagerParams.output_prng_states_file.empty(),
+                  FLConfigUserError,
+                  "PRNG states files cannot be used with several jobs!");
+      // Each job simulates at least one event:
+      flSimParameters_.numberOfJobs =
+        std::min(flSimParameters_.numberOfJobs, flSimParameters_.numberOfEvents);
+    }
+
     // Propagate verbosity to variant service:
     flSimParameters_.variantServiceConfig.logging =
       datatools::logger::get_priority_label(flSimParameters_.logLevel);
@@ -729,7 +760,9 @@ namespace FLSimulate {
     out_ << tag << "servicesSubsystemConfig    = " << servicesSubsystemConfig << std::endl;
     out_ << tag << "outputMetadataFile         = " << outputMetadataFile << std::endl;
     out_ << tag << "embeddedMetadata           = " << std::boolalpha << embeddedMetadata << std::endl;
-    out_ << last_tag << "outputFile                 = " << outputFile << std::endl;
+    out_ << tag << "outputFile                 = " << outputFile << std::endl;
+    out_ << tag << "outputQueue                = " << outputQueue << std::endl;
+    out_ << last_tag << "numberOfJobs               = " << numberOfJobs << std::endl;
     return;
   }
 
@@ -71,6 +71,8 @@ namespace FLSimulate {
     bool saveRngSeeding;            //!< Flag to save PRNG seeds in metadata
     std::string rngSeeding;         //!< PRNG seed initialization
     std::string outputFile;         //!< Output data file for the output module
+    unsigned int outputQueue;       //!< Number of output events queued for the writer thread (0: synchronous)
+    unsigned int numberOfJobs;      //!< Number of worker processes sharing the events (1: no worker)
 
     //! Construct and return the default configuration object
     // Equally, could be supplied in a .application file, though note
@@ -33,6 +33,8 @@ namespace FLSimulate {
     flClarg.numberOfEvents = 1u;
     flClarg.runNumber = datatools::event_id::ANY_RUN_NUMBER;
     flClarg.firstEventNumber = 0u;
+    flClarg.outputQueue = 0u;
+    flClarg.numberOfJobs = 1u;
     return flClarg;
   } 
 
@@ -187,6 +189,20 @@ namespace FLSimulate {
        ->value_name("N"),
        "first event number in the run")
 
+      ("output-queue",
+       bpo::value<unsigned int>(&clArgs_.outputQueue)
+       ->default_value(0u)
+       ->value_name("K"),
+       "number of simulated events queued for a background writer thread\n"
+       "(0: events are written by the event loop)")
+
+      ("jobs,j",
+       bpo::value<unsigned int>(&clArgs_.numberOfJobs)
+       ->default_value(1u)
+       ->value_name("N"),
+       "number of worker processes sharing the generated events\n"
+       "(their outputs are merged in the output file)")
+
       ("output-file,o", bpo::value<std::string>(&clArgs_.outputFile)->required()->value_name("file"),
        "file in which to store simulation results\n"
        "Examples:\n"
@@ -41,6 +41,8 @@ namespace FLSimulate {
     unsigned int numberOfEvents;           //!< Number of events to be generated
     int runNumber;                         //!< Run number
     unsigned int firstEventNumber;                  //!< Number of the first generated event
+    unsigned int outputQueue;              //!< Number of output events queued for writing
+    unsigned int numberOfJobs;             //!< Number of worker processes
     static FLSimulateCommandLine makeDefault();
   };
 
@@ -0,0 +1,251 @@
+// Ourselves
+#include "FLSimulateJobs.h"
+
+// Standard Library
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+// - POSIX
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Third party:
+// - Boost:
+#include "boost/filesystem.hpp"
+// - Bayeux:
+#include "bayeux/datatools/exception.h"
+#include "bayeux/datatools/logger.h"
+#include "bayeux/datatools/things.h"
+#include "bayeux/datatools/utils.h"
+#include "bayeux/dpp/input_module.h"
+#include "bayeux/dpp/output_module.h"
+#include "bayeux/mygsl/random_utils.h"
+
+namespace FLSimulate {
+
+  namespace {
+
+    //! Labels of the PRNGs of the Geant4 simulation manager
+    const char * const kManagerSeedLabel = "manager";
+    const char * const kVertexGeneratorSeedLabel = "vertex_generator";
+    const char * const kEventGeneratorSeedLabel = "event_generator";
+    const char * const kHitProcessingSeedLabel = "shpf";
+
+    //! Return the seed of a job's PRNG derived from the master seed
+    int32_t derive_seed(int32_t masterSeed_, unsigned int job_, unsigned int prng_,
+                        unsigned int attempt_)
+    {
+      // SplitMix64 finalizer over the master seed and the job/PRNG/attempt indexes:
+      uint64_t z = (static_cast<uint64_t>(static_cast<uint32_t>(masterSeed_)) << 32) ^
+                   (static_cast<uint64_t>(job_) << 12) ^ (static_cast<uint64_t>(prng_) << 8) ^
+                   attempt_;
+      z += 0x9E3779B97F4A7C15ULL;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+      z ^= z >> 31;
+      // Valid seeds are strictly positive 31-bit integers:
+      auto seed = static_cast<int32_t>(z & 0x7FFFFFFFULL);
+      return seed == 0 ? 1 : seed;
+    }
+
+  }  // namespace
+
+  mygsl::seed_manager make_master_seeds(const FLSimulateArgs & flSimParameters_)
+  {
+    const mctools::g4::manager_parameters & mgrParams = flSimParameters_.simulationManagerParams;
+    mygsl::seed_manager masterSeeds;
+    if (!mgrParams.input_prng_seeds_file.empty()) {
+      std::string seedsFile = mgrParams.input_prng_seeds_file;
+      datatools::fetch_path_with_env(seedsFile);
+      std::ifstream seedsIn(seedsFile);
+      DT_THROW_IF(!seedsIn, std::runtime_error, "Cannot open PRNG seeds file '" << seedsFile << "'!");
+      seedsIn >> masterSeeds;
+      DT_THROW_IF(!seedsIn, std::runtime_error, "Cannot read PRNG seeds file '" << seedsFile << "'!");
+    } else {
+      masterSeeds.add_seed(kManagerSeedLabel, mgrParams.mgr_seed);
+      masterSeeds.add_seed(kVertexGeneratorSeedLabel, mgrParams.vg_seed);
+      masterSeeds.add_seed(kEventGeneratorSeedLabel, mgrParams.eg_seed);
+      masterSeeds.add_seed(kHitProcessingSeedLabel, mgrParams.shpf_seed);
+    }
+    // Jobs derive their seeds from fixed values:
+    masterSeeds.transform_time_seeds();
+    return masterSeeds;
+  }
+
+  std::vector<FLSimulateJob> make_jobs(const FLSimulateArgs & flSimParameters_,
+                                       const mygsl::seed_manager & masterSeeds_,
+                                       const std::string & workDir_)
+  {
+    const unsigned int nJobs = flSimParameters_.numberOfJobs;
+    const unsigned int nEvents = flSimParameters_.numberOfEvents;
+    DT_THROW_IF(nJobs == 0 || nJobs > nEvents, std::logic_error,
+                "Cannot share " << nEvents << " events between " << nJobs << " jobs!");
+    const std::vector<std::string> labels{kManagerSeedLabel, kVertexGeneratorSeedLabel,
+                                          kEventGeneratorSeedLabel, kHitProcessingSeedLabel};
+
+    std::set<int32_t> usedSeeds;
+    for (const std::string & label : labels) {
+      if (masterSeeds_.has_seed(label)) {
+        usedSeeds.insert(masterSeeds_.get_seed(label));
+      }
+    }
+
+    const std::string outputName =
+      boost::filesystem::path(flSimParameters_.outputFile).filename().string();
+    std::vector<FLSimulateJob> jobs(nJobs);
+    unsigned int firstEvent = 0;
+    for (unsigned int ijob = 0; ijob < nJobs; ijob++) {
+      FLSimulateJob & job = jobs[ijob];
+      job.index = ijob;
+      job.firstEvent = firstEvent;
+      // The remainder is spread over the first jobs:
+      job.numberOfEvents = nEvents / nJobs + (ijob < nEvents % nJobs ? 1 : 0);
+      firstEvent += job.numberOfEvents;
+
+      job.seeds = masterSeeds_;
+      if (ijob > 0) {
+        for (unsigned int iprng = 0; iprng < labels.size(); iprng++) {
+          if (!masterSeeds_.has_seed(labels[iprng])) {
+            continue;
+          }
+          int32_t masterSeed = masterSeeds_.get_seed(labels[iprng]);
+          unsigned int attempt = 0;
+          int32_t seed = derive_seed(masterSeed, ijob, iprng, attempt);
+          while (usedSeeds.count(seed) != 0) {
+            seed = derive_seed(masterSeed, ijob, iprng, ++attempt);
+          }
+          usedSeeds.insert(seed);
+          job.seeds.update_seed(labels[iprng], seed);
+        }
+      }
+
+      boost::filesystem::path jobDir(workDir_);
+      jobDir /= "job-" + std::to_string(ijob);
+      // Same file name as the final output, so that the output format is the same:
+      job.outputFile = (jobDir / outputName).string();
+    }
+    return jobs;
+  }
+
+  FLSimulateArgs make_job_parameters(const FLSimulateArgs & flSimParameters_,
+                                     const FLSimulateJob & job_)
+  {
+    FLSimulateArgs jobParameters = flSimParameters_;
+    jobParameters.numberOfJobs = 1;
+    jobParameters.numberOfEvents = job_.numberOfEvents;
+    jobParameters.firstEventNumber = flSimParameters_.firstEventNumber + job_.firstEvent;
+    jobParameters.outputFile = job_.outputFile;
+    // Metadata and seeds of the run are recorded by the parent process:
+    jobParameters.outputMetadataFile.clear();
+    jobParameters.embeddedMetadata = false;
+    mctools::g4::manager_parameters & mgrParams = jobParameters.simulationManagerParams;
+    mgrParams.input_prng_seeds_file.clear();
+    mgrParams.output_prng_seeds_file.clear();
+    if (job_.seeds.has_seed(kManagerSeedLabel)) {
+      mgrParams.mgr_seed = job_.seeds.get_seed(kManagerSeedLabel);
+    }
+    if (job_.seeds.has_seed(kVertexGeneratorSeedLabel)) {
+      mgrParams.vg_seed = job_.seeds.get_seed(kVertexGeneratorSeedLabel);
+    }
+    if (job_.seeds.has_seed(kEventGeneratorSeedLabel)) {
+      mgrParams.eg_seed = job_.seeds.get_seed(kEventGeneratorSeedLabel);
+    }
+    if (job_.seeds.has_seed(kHitProcessingSeedLabel)) {
+      mgrParams.shpf_seed = job_.seeds.get_seed(kHitProcessingSeedLabel);
+    }
+    return jobParameters;
+  }
+
+  bool run_jobs(const FLSimulateArgs & flSimParameters_,
+                const std::vector<FLSimulateJob> & jobs_,
+                const std::function<falaise::exit_code(FLSimulateArgs &)> & worker_)
+  {
+    bool success = true;
+    std::vector<pid_t> workers;
+    for (const FLSimulateJob & job : jobs_) {
+      boost::filesystem::create_directories(
+        boost::filesystem::path(job.outputFile).parent_path());
+      // Do not let workers inherit pending output:
+      std::cout.flush();
+      std::cerr.flush();
+      pid_t pid = ::fork();
+      if (pid < 0) {
+        std::cerr << "flsimulate : Cannot start worker process for job " << job.index << std::endl;
+        success = false;
+        break;
+      }
+      if (pid == 0) {
+        falaise::exit_code code = falaise::EXIT_UNAVAILABLE;
+        try {
+          FLSimulateArgs jobParameters = make_job_parameters(flSimParameters_, job);
+          DT_LOG_DEBUG(flSimParameters_.logLevel,
+                       "Job " << job.index << " : events [" << job.firstEvent << ", "
+                       << job.firstEvent + job.numberOfEvents << "), seeds " << job.seeds);
+          code = worker_(jobParameters);
+        } catch (std::exception & e) {
+          std::cerr << "flsimulate : Job " << job.index << " threw exception" << std::endl;
+          std::cerr << e.what() << std::endl;
+        }
+        std::cout.flush();
+        std::cerr.flush();
+        // Leave the process without running the parent's exit handlers:
+        ::_exit(code);
+      }
+      workers.push_back(pid);
+    }
+
+    for (std::size_t ijob = 0; ijob < workers.size(); ijob++) {
+      int status = 0;
+      while (::waitpid(workers[ijob], &status, 0) < 0) {
+        if (errno != EINTR) {
+          status = -1;
+          break;
+        }
+      }
+      if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != falaise::EXIT_OK) {
+        std::cerr << "flsimulate : Job " << ijob << " failed" << std::endl;
+        success = false;
+      }
+    }
+    return success;
+  }
+
+  void merge_job_outputs(const std::vector<FLSimulateJob> & jobs_,
+                         const std::string & outputFile_,
+                         const datatools::multi_properties * metadata_)
+  {
+    dpp::output_module mergedOutput;
+    mergedOutput.set_name("FLSimulateOutput");
+    mergedOutput.set_single_output_file(outputFile_);
+    if (metadata_ != nullptr) {
+      mergedOutput.grab_metadata_store() = *metadata_;
+    }
+    mergedOutput.initialize_simple();
+
+    datatools::things record;
+    for (const FLSimulateJob & job : jobs_) {
+      dpp::input_module jobInput;
+      jobInput.set_name("FLSimulateJobInput");
+      jobInput.set_single_input_file(job.outputFile);
+      jobInput.initialize_simple();
+      std::size_t nRecords = 0;
+      while (!jobInput.is_terminated()) {
+        record.clear();
+        DT_THROW_IF(jobInput.process(record) != dpp::base_module::PROCESS_OK, std::runtime_error,
+                    "Cannot read output of job " << job.index << " from '" << job.outputFile << "'!");
+        DT_THROW_IF(mergedOutput.process(record) != dpp::base_module::PROCESS_OK, std::runtime_error,
+                    "Cannot write output file '" << outputFile_ << "'!");
+        nRecords++;
+      }
+      DT_THROW_IF(nRecords != job.numberOfEvents, std::runtime_error,
+                  "Job " << job.index << " produced " << nRecords << " events instead of "
+                  << job.numberOfEvents << "!");
+    }
+    mergedOutput.reset();
+  }
+
+}  // namespace FLSimulate
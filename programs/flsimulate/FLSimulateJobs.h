@@ -0,0 +1,75 @@
+// FLSimulateJobs.h - FLSimulate worker processes
+//
+// Distributed under the OSI-approved BSD 3-Clause License (the "License");
+// see accompanying file License.txt for details.
+//
+// This software is distributed WITHOUT ANY WARRANTY; without even the
+// implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+// See the License for more information.
+
+#ifndef FLSIMULATEJOBS_H
+#define FLSIMULATEJOBS_H
+
+// Standard Library
+#include <functional>
+#include <string>
+#include <vector>
+
+// Third Party
+// - Bayeux
+#include "bayeux/datatools/multi_properties.h"
+#include "bayeux/mygsl/seed_manager.h"
+
+// This Project
+#include "falaise/exitcodes.h"
+
+#include "FLSimulateArgs.h"
+
+namespace FLSimulate {
+
+  //! Share of a run simulated by one worker process
+  struct FLSimulateJob
+  {
+    unsigned int index = 0;          //!< Index of the job
+    unsigned int firstEvent = 0;     //!< Rank of the first event of the job in the run
+    unsigned int numberOfEvents = 0; //!< Number of events simulated by the job
+    mygsl::seed_manager seeds;       //!< Initial seeds of the job's PRNGs
+    std::string outputFile;          //!< Temporary output file of the job
+  };
+
+  //! Return the initial seeds of the run's PRNGs, with time seeds resolved to fixed values
+  mygsl::seed_manager make_master_seeds(const FLSimulateArgs & flSimParameters_);
+
+  //! Split the events of a run between its jobs
+  //!
+  //! The first job uses the master seeds, so that it reproduces the beginning of a
+  //! single process run. The seeds of the other jobs are derived from the master seeds
+  //! and the job index, and are all distinct.
+  std::vector<FLSimulateJob> make_jobs(const FLSimulateArgs & flSimParameters_,
+                                       const mygsl::seed_manager & masterSeeds_,
+                                       const std::string & workDir_);
+
+  //! Return the parameters of the worker process running a job
+  FLSimulateArgs make_job_parameters(const FLSimulateArgs & flSimParameters_,
+                                     const FLSimulateJob & job_);
+
+  //! Run each job in a forked worker process and wait for all of them
+  //! \return true if all workers succeeded
+  bool run_jobs(const FLSimulateArgs & flSimParameters_,
+                const std::vector<FLSimulateJob> & jobs_,
+                const std::function<falaise::exit_code(FLSimulateArgs &)> & worker_);
+
+  //! Concatenate the job outputs, in job order, into a single output file
+  void merge_job_outputs(const std::vector<FLSimulateJob> & jobs_,
+                         const std::string & outputFile_,
+                         const datatools::multi_properties * metadata_);
+
+}  // namespace FLSimulate
+
+#endif  // FLSIMULATEJOBS_H
+
+// Local Variables: --
+// mode: c++ --
+// c-file-style: "gnu" --
+// tab-width: 2 --
+// End: --
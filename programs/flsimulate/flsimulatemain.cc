@@ -37,7 +37,14 @@
 // along with Falaise.  If not, see <http://www.gnu.org/licenses/>.
 
 // Standard Library
+#include <fstream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <vector>
+
+// - POSIX
+#include <unistd.h>
 
 // Third Party
 // - Boost
@@ -65,6 +72,7 @@
 #include "bayeux/version.h"
 
 // This Project
+#include "falaise/async_writer.h"
 #include "falaise/exitcodes.h"
 #include "falaise/falaise.h"
 #include "falaise/resource.h"
@@ -75,6 +83,7 @@
 
 #include "FLSimulateArgs.h"
 #include "FLSimulateErrors.h"
+#include "FLSimulateJobs.h"
 
 namespace FLSimulate {
 
@@ -85,6 +94,12 @@ namespace FLSimulate {
   falaise::exit_code do_metadata(const FLSimulateArgs & /*flSimParameters*/,
                                  datatools::multi_properties & /*flSimMetadata*/);
 
+  //! Run the simulation in this process
+  falaise::exit_code do_simulation(FLSimulateArgs & flSimParameters);
+
+  //! Run the simulation in several worker processes and merge their outputs
+  falaise::exit_code do_simulation_jobs(FLSimulateArgs & flSimParameters);
+
 }  // end of namespace FLSimulate
 
 //----------------------------------------------------------------------
@@ -149,6 +164,12 @@ namespace FLSimulate {
                                flSimParameters.numberOfEvents,
                                "Number of simulated events");
 
+    if (flSimParameters.numberOfJobs > 1) {
+      system_props.store_integer("numberOfJobs",
+                                 flSimParameters.numberOfJobs,
+                                 "Number of worker processes sharing the simulated events");
+    }
+
     system_props.store_boolean("doSimulation",
                                flSimParameters.doSimulation,
                                "Activate simulation");
@@ -312,6 +333,24 @@ namespace FLSimulate {
     }
 
     // - Run:
+    falaise::exit_code code = falaise::EXIT_OK;
+    if (flSimParameters.numberOfJobs > 1) {
+      code = do_simulation_jobs(flSimParameters);
+    } else {
+      code = do_simulation(flSimParameters);
+    }
+
+    // Terminate the variant service:
+    if (variantService.is_started()) {
+      variantService.stop();
+    }
+
+    return code;
+  }
+
+  //----------------------------------------------------------------------
+  falaise::exit_code do_simulation(FLSimulateArgs & flSimParameters)
+  {
     falaise::exit_code code = falaise::EXIT_OK;
     try {
       // Library loader:
@@ -379,12 +418,23 @@ namespace FLSimulate {
       }
       simOutput.initialize_simple();
 
+      // Optional writer thread:
+      std::unique_ptr<falaise::async_writer> simWriter;
+      if (flSimParameters.outputQueue > 0) {
+        simWriter.reset(new falaise::async_writer(simOutput, flSimParameters.outputQueue));
+      }
+
       // Manual Event loop....
-      datatools::things workItem;
+      std::unique_ptr<datatools::things> workItemPtr(new datatools::things);
       dpp::base_module::process_status status;
 
       int run_number = flSimParameters.runNumber;
       for (unsigned int i(0); i < flSimParameters.numberOfEvents; ++i) {
+        if (!workItemPtr) {
+          // Previous event was handed over to the writer thread
+          workItemPtr.reset(new datatools::things);
+        }
+        datatools::things & workItem = *workItemPtr;
         workItem.clear();
 
         // Add the event header bank
@@ -401,10 +451,17 @@ namespace FLSimulate {
           code = falaise::EXIT_UNAVAILABLE;
         }
 
-        status = simOutput.process(workItem);
-        if (status != dpp::base_module::PROCESS_OK) {
-          std::cerr << "flsimulate : Output module failed" << std::endl;
-          code = falaise::EXIT_UNAVAILABLE;
+        if (simWriter) {
+          if (!simWriter->write(std::move(workItemPtr))) {
+            std::cerr << "flsimulate : Output module failed" << std::endl;
+            code = falaise::EXIT_UNAVAILABLE;
+          }
+        } else {
+          status = simOutput.process(workItem);
+          if (status != dpp::base_module::PROCESS_OK) {
+            std::cerr << "flsimulate : Output module failed" << std::endl;
+            code = falaise::EXIT_UNAVAILABLE;
+          }
         }
 
         // Here we will process optional ASB+Digitization+terminal output modules
@@ -413,17 +470,86 @@ namespace FLSimulate {
           break;
         }
       }
+
+      // Flush pending events before the output module is closed:
+      if (simWriter && !simWriter->finish()) {
+        std::cerr << "flsimulate : Output module failed" << std::endl;
+        std::cerr << simWriter->error_message() << std::endl;
+        code = falaise::EXIT_UNAVAILABLE;
+      }
     } catch (std::exception & e) {
       std::cerr << "flsimulate : Setup/run of simulation threw exception" << std::endl;
       std::cerr << e.what() << std::endl;
       code = falaise::EXIT_UNAVAILABLE;
     }
 
-    // Terminate the variant service:
-    if (variantService.is_started()) {
-      variantService.stop();
+    return code;
+  }
+
+  //----------------------------------------------------------------------
+  falaise::exit_code do_simulation_jobs(FLSimulateArgs & flSimParameters)
+  {
+    falaise::exit_code code = falaise::EXIT_OK;
+    std::string workDir;
+    try {
+      // All jobs derive their seeds from the master seeds, which are recorded
+      // as the seeds of the run:
+      mygsl::seed_manager masterSeeds = make_master_seeds(flSimParameters);
+      std::ostringstream rngSeedingOut;
+      rngSeedingOut << masterSeeds;
+      flSimParameters.rngSeeding = rngSeedingOut.str();
+      DT_LOG_DEBUG(flSimParameters.logLevel, "PRNG seeding = " << flSimParameters.rngSeeding);
+      if (!flSimParameters.simulationManagerParams.output_prng_seeds_file.empty()) {
+        std::string fSeeds = flSimParameters.simulationManagerParams.output_prng_seeds_file;
+        datatools::fetch_path_with_env(fSeeds);
+        std::ofstream seedsOut(fSeeds);
+        seedsOut << masterSeeds << std::endl;
+        DT_THROW_IF(!seedsOut, std::runtime_error, "Cannot write PRNG seeds file '" << fSeeds << "'!");
+      }
+
+      // Temporary outputs of the jobs:
+      workDir = flSimParameters.outputFile + ".jobs-" + std::to_string(::getpid());
+      std::vector<FLSimulateJob> jobs = make_jobs(flSimParameters, masterSeeds, workDir);
+
+      // Output metadata management:
+      datatools::multi_properties flSimMetadata("name", "type",
+                                                "Metadata associated to a flsimulate run");
+      do_metadata(flSimParameters, flSimMetadata);
+      if (flSimParameters.saveRngSeeding && flSimMetadata.has_section("flsimulate.simulation")) {
+        std::vector<std::string> jobsRngSeeding;
+        for (const FLSimulateJob & job : jobs) {
+          std::ostringstream jobSeedingOut;
+          jobSeedingOut << job.seeds;
+          jobsRngSeeding.push_back(jobSeedingOut.str());
+        }
+        flSimMetadata.grab_section("flsimulate.simulation")
+          .store("jobsRngSeeding", jobsRngSeeding, "PRNG initial seeds of the jobs");
+      }
+      if (datatools::logger::is_debug(flSimParameters.logLevel)) {
+        flSimMetadata.tree_dump(std::cerr, "Simulation metadata: ", "[debug]: ");
+      }
+      if (!flSimParameters.outputMetadataFile.empty()) {
+        std::string fMetadata = flSimParameters.outputMetadataFile;
+        datatools::fetch_path_with_env(fMetadata);
+        flSimMetadata.write(fMetadata);
+      }
+
+      if (run_jobs(flSimParameters, jobs, do_simulation)) {
+        merge_job_outputs(jobs, flSimParameters.outputFile,
+                          flSimParameters.embeddedMetadata ? &flSimMetadata : nullptr);
+      } else {
+        code = falaise::EXIT_UNAVAILABLE;
+      }
+    } catch (std::exception & e) {
+      std::cerr << "flsimulate : Setup/run of simulation jobs threw exception" << std::endl;
+      std::cerr << e.what() << std::endl;
+      code = falaise::EXIT_UNAVAILABLE;
     }
 
+    if (!workDir.empty()) {
+      boost::system::error_code ec;
+      boost::filesystem::remove_all(workDir, ec);
+    }
     return code;
   }
 
@@ -0,0 +1,80 @@
+// async_writer.cc
+
+// Ourselves
+#include "falaise/async_writer.h"
+
+// Standard library:
+#include <exception>
+#include <sstream>
+
+namespace falaise {
+
+async_writer::async_writer(dpp::base_module& output, std::size_t capacity)
+    : output_(output), queue_(capacity) {
+  thread_ = std::thread(&async_writer::run_, this);
+}
+
+async_writer::~async_writer() { finish(); }
+
+bool async_writer::write(std::unique_ptr<datatools::things> record) {
+  if (failed_) {
+    return false;
+  }
+  return queue_.push(std::move(record));
+}
+
+bool async_writer::finish() {
+  queue_.close();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  return !failed_;
+}
+
+bool async_writer::has_failed() const { return failed_; }
+
+std::string async_writer::error_message() const {
+  std::lock_guard<std::mutex> lock{errorMutex_};
+  return errorMessage_;
+}
+
+std::size_t async_writer::written() const { return written_; }
+
+std::size_t async_writer::capacity() const { return queue_.capacity(); }
+
+void async_writer::run_() {
+  std::unique_ptr<datatools::things> record;
+  while (queue_.pop(record)) {
+    try {
+      dpp::base_module::process_status status = output_.process(*record);
+      if (status != dpp::base_module::PROCESS_OK) {
+        std::ostringstream message;
+        message << "Output module '" << output_.get_name() << "' failed to write data record #"
+                << written_ << " (status=" << status << ")";
+        fail_(message.str());
+        return;
+      }
+    } catch (std::exception& e) {
+      std::ostringstream message;
+      message << "Output module '" << output_.get_name() << "' threw while writing data record #"
+              << written_ << ": " << e.what();
+      fail_(message.str());
+      return;
+    }
+    written_++;
+  }
+}
+
+void async_writer::fail_(const std::string& message) {
+  {
+    std::lock_guard<std::mutex> lock{errorMutex_};
+    if (errorMessage_.empty()) {
+      errorMessage_ = message;
+    }
+  }
+  failed_ = true;
+  // Wake up and refuse any blocked or subsequent producer
+  queue_.close();
+}
+
+}  // namespace falaise
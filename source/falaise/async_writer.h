@@ -0,0 +1,118 @@
+//! \file falaise/async_writer.h
+//
+// This file is part of Falaise.
+//
+// Falaise is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Falaise is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Falaise.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FALAISE_ASYNC_WRITER_H
+#define FALAISE_ASYNC_WRITER_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "bayeux/datatools/things.h"
+#include "bayeux/dpp/base_module.h"
+
+#include "falaise/bounded_queue.h"
+
+namespace falaise {
+//! \brief Output stage writing data records from a dedicated thread
+/*!
+ * Takes ownership of finished data records through a bounded queue and passes
+ * them, in submission order, to an initialized output module (typically a
+ * dpp::output_module or the Things2Root module) running in a writer thread.
+ * Serialization and compression then overlap with the processing of the next
+ * events instead of sitting on the critical path of the event loop.
+ *
+ * A full queue blocks the producer (back-pressure). If the output module fails
+ * or throws, the writer stops, write() returns false for subsequent records and
+ * finish() reports the error:
+ *
+ * ```cpp
+ * falaise::async_writer writer{outputModule, 16};
+ * for (...) {
+ *   std::unique_ptr<datatools::things> record{new datatools::things};
+ *   ... fill record ...
+ *   if (!writer.write(std::move(record))) break;
+ * }
+ * if (!writer.finish()) {
+ *   std::cerr << writer.error_message() << std::endl;
+ * }
+ * ```
+ *
+ * The output module must not be used by any other thread until finish() returns.
+ */
+class async_writer {
+ public:
+  //! Start the writer thread
+  /*!
+   * \param[in] output initialized output module, must outlive the writer
+   * \param[in] capacity maximum number of records waiting to be written
+   * \throw std::invalid_argument if capacity is zero
+   */
+  async_writer(dpp::base_module& output, std::size_t capacity);
+
+  //! Flush the queue and join the writer thread, ignoring errors
+  ~async_writer();
+
+  async_writer(const async_writer&) = delete;
+  async_writer& operator=(const async_writer&) = delete;
+
+  //! Hand over a data record to the writer thread, blocking while the queue is full
+  /*!
+   * \param[in] record data record to be written
+   * \return false if the writer has failed or has been finished
+   */
+  bool write(std::unique_ptr<datatools::things> record);
+
+  //! Write all queued records and join the writer thread
+  /*!
+   * \return true if all records handed over were written successfully
+   */
+  bool finish();
+
+  //! Return true if the output module failed
+  bool has_failed() const;
+
+  //! Return the description of the first failure, empty if none
+  std::string error_message() const;
+
+  //! Return the number of records written so far
+  std::size_t written() const;
+
+  //! Return the maximum number of records waiting to be written
+  std::size_t capacity() const;
+
+ private:
+  //! Writer thread main loop
+  void run_();
+
+  //! Record a failure and stop accepting new records
+  void fail_(const std::string& message);
+
+  dpp::base_module& output_;                                      //< output module
+  bounded_queue<std::unique_ptr<datatools::things>> queue_;       //< records to be written
+  std::atomic<bool> failed_{false};                               //< failure flag
+  std::atomic<std::size_t> written_{0};                           //< written records counter
+  mutable std::mutex errorMutex_;                                 //< protects errorMessage_
+  std::string errorMessage_;                                      //< first failure description
+  std::thread thread_;                                            //< writer thread
+};
+}  // namespace falaise
+
+#endif  // FALAISE_ASYNC_WRITER_H
@@ -0,0 +1,112 @@
+// binary_cache.cc
+
+// Ourselves
+#include "falaise/binary_cache.h"
+
+// Standard library:
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+// - POSIX:
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
+// - Bayeux:
+#include "bayeux/datatools/exception.h"
+#include "bayeux/datatools/utils.h"
+
+namespace falaise {
+void fnv1a_hash::add(const void* data, size_t size) {
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; i++) {
+    value_ ^= bytes[i];
+    value_ *= 1099511628211ULL;
+  }
+}
+
+void fnv1a_hash::add(const std::string& text) {
+  add(text.data(), text.size());
+  add("", 1);
+}
+
+void fnv1a_hash::add_file(const std::string& path) {
+  add(boost::filesystem::canonical(path).string());
+  const uint64_t fileSize = boost::filesystem::file_size(path);
+  add(&fileSize, sizeof(fileSize));
+  const auto fileTime = static_cast<int64_t>(boost::filesystem::last_write_time(path));
+  add(&fileTime, sizeof(fileTime));
+}
+
+uint64_t fnv1a_hash::value() const { return value_; }
+
+mapped_file::mapped_file(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (addr != MAP_FAILED) {
+      data_ = static_cast<const char*>(addr);
+      size_ = st.st_size;
+    }
+  }
+  ::close(fd);
+}
+
+mapped_file::~mapped_file() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+const char* mapped_file::data() const { return data_; }
+
+size_t mapped_file::size() const { return size_; }
+
+std::string cache_file_path(const std::string& directory, const std::string& prefix, uint64_t key,
+                            const std::string& extension) {
+  std::string dir = directory;
+  datatools::fetch_path_with_env(dir);
+  std::ostringstream path;
+  path << dir << "/" << prefix << "-" << std::hex << std::setw(16) << std::setfill('0') << key
+       << extension;
+  return path.str();
+}
+
+void write_file_atomically(const std::string& path,
+                           const std::function<void(std::ostream&)>& writer) {
+  std::ostringstream tmpPath;
+  tmpPath << path << ".tmp." << ::getpid();
+  {
+    std::ofstream out(tmpPath.str(), std::ios::binary | std::ios::trunc);
+    DT_THROW_IF(!out, std::runtime_error, "Cannot open file '" << tmpPath.str() << "'!");
+    try {
+      writer(out);
+    } catch (...) {
+      out.close();
+      std::remove(tmpPath.str().c_str());
+      throw;
+    }
+    out.flush();
+    if (!out) {
+      out.close();
+      std::remove(tmpPath.str().c_str());
+      DT_THROW(std::runtime_error, "Cannot write file '" << tmpPath.str() << "'!");
+    }
+  }
+  if (std::rename(tmpPath.str().c_str(), path.c_str()) != 0) {
+    std::remove(tmpPath.str().c_str());
+    DT_THROW(std::runtime_error, "Cannot store file '" << path << "'!");
+  }
+}
+}  // namespace falaise
@@ -0,0 +1,86 @@
+//! \file  falaise/binary_cache.h
+//! \brief Utilities for binary cache files of parsed or resolved data
+//
+// This file is part of Falaise.
+//
+// Falaise is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Falaise is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Falaise.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FALAISE_BINARY_CACHE_H
+#define FALAISE_BINARY_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace falaise {
+//! \brief 64-bit FNV-1a hash, used to build the keys of cache files
+class fnv1a_hash {
+ public:
+  //! Add a block of bytes
+  void add(const void* data, size_t size);
+
+  //! Add a string, followed by a separator so that ("ab", "c") and ("a", "bc") differ
+  void add(const std::string& text);
+
+  //! Add the identity of an existing file: canonical path, size and modification time
+  void add_file(const std::string& path);
+
+  //! Return the hash of the data added so far
+  uint64_t value() const;
+
+ private:
+  uint64_t value_ = 14695981039346656037ULL;
+};
+
+//! \brief Read-only memory mapping of a whole file
+/*!
+ * data() is null if the file is missing, empty or cannot be mapped.
+ */
+class mapped_file {
+ public:
+  explicit mapped_file(const std::string& path);
+  ~mapped_file();
+  mapped_file(const mapped_file&) = delete;
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  //! Return the first byte of the file
+  const char* data() const;
+
+  //! Return the size of the file in bytes
+  size_t size() const;
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+//! Return the path of the cache file "<directory>/<prefix>-<key as 16 hex digits><extension>"
+/*!
+ * Environment variables and Falaise resource paths in directory are expanded.
+ */
+std::string cache_file_path(const std::string& directory, const std::string& prefix, uint64_t key,
+                            const std::string& extension);
+
+//! Write a file with a writer function, through a private temporary file renamed at the end
+/*!
+ * Concurrent jobs thus never see a partially written file.
+ * \throw std::runtime_error if the file cannot be written or renamed
+ */
+void write_file_atomically(const std::string& path,
+                           const std::function<void(std::ostream&)>& writer);
+}  // namespace falaise
+
+#endif  // FALAISE_BINARY_CACHE_H
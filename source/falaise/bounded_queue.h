@@ -0,0 +1,146 @@
+//! \file falaise/bounded_queue.h
+//
+// This file is part of Falaise.
+//
+// Falaise is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Falaise is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Falaise.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FALAISE_BOUNDED_QUEUE_H
+#define FALAISE_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace falaise {
+//! \brief Blocking FIFO queue of fixed capacity shared between threads
+/*!
+ * \tparam T type of the queued items (typically a movable owning handle
+ *           such as std::unique_ptr<datatools::things>)
+ *
+ * Provides the hand-off point between the stages of the threaded event
+ * loops in the Falaise applications (reader, workers, writer). Producers
+ * block in push() while the queue is full, which gives back-pressure on
+ * fast stages, and consumers block in pop() while it is empty.
+ *
+ * Once close() has been called, push() refuses new items and pop() drains
+ * the remaining ones before reporting the end of the stream:
+ *
+ * ```cpp
+ * falaise::bounded_queue<int> q{4};
+ *
+ * // producer thread
+ * for (int i = 0; i < 10; ++i) {
+ *   if (!q.push(i)) break; // consumer gave up
+ * }
+ * q.close();
+ *
+ * // consumer thread
+ * int x;
+ * while (q.pop(x)) {
+ *   ... use x ...
+ * }
+ * ```
+ */
+template <typename T>
+class bounded_queue {
+ public:
+  //! Construct an empty queue holding at most capacity items
+  /*!
+   * \param[in] capacity maximum number of queued items
+   * \throw std::invalid_argument if capacity is zero
+   */
+  explicit bounded_queue(std::size_t capacity) : capacity_{capacity} {
+    if (capacity_ == 0) {
+      throw std::invalid_argument("bounded_queue capacity must be non-zero");
+    }
+  }
+
+  ~bounded_queue() = default;
+  bounded_queue(const bounded_queue&) = delete;
+  bounded_queue& operator=(const bounded_queue&) = delete;
+
+  //! Append an item, blocking while the queue is full
+  /*!
+   * \param[in] item value to move into the queue
+   * \return false if the queue was closed, in which case item is left untouched
+   */
+  bool push(T&& item) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(item));
+    lock.unlock();
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  //! Remove the oldest item, blocking while the queue is empty and open
+  /*!
+   * \param[out] item receives the dequeued value
+   * \return false once the queue is closed and fully drained
+   */
+  bool pop(T& item) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return false;
+    }
+    item = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    notFull_.notify_one();
+    return true;
+  }
+
+  //! Mark the end of the stream and wake up all waiting threads
+  void close() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      closed_ = true;
+    }
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  //! Return true once close() has been called
+  bool is_closed() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return closed_;
+  }
+
+  //! Return the number of currently queued items
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return items_.size();
+  }
+
+  //! Return the maximum number of queued items
+  std::size_t capacity() const { return capacity_; }
+
+ private:
+  const std::size_t capacity_;         //< maximum number of items
+  bool closed_ = false;                //< end of stream flag
+  std::deque<T> items_;                //< queued items
+  mutable std::mutex mutex_;           //< protects closed_ and items_
+  std::condition_variable notEmpty_;   //< signalled on push/close
+  std::condition_variable notFull_;    //< signalled on pop/close
+};
+}  // namespace falaise
+
+#endif  // FALAISE_BOUNDED_QUEUE_H
@@ -0,0 +1,225 @@
+//! \file falaise/ordered_workers.h
+//
+// This file is part of Falaise.
+//
+// Falaise is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Falaise is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Falaise.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef FALAISE_ORDERED_WORKERS_H
+#define FALAISE_ORDERED_WORKERS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "falaise/bounded_queue.h"
+
+namespace falaise {
+//! \brief Pool of worker threads processing items and delivering them in submission order
+/*!
+ * \tparam T type of the processed items (typically a record owning a
+ *           std::unique_ptr<datatools::things>)
+ *
+ * Item number i is always processed by worker i modulo the number of
+ * workers, so that any per-worker state (e.g. a pipeline module instance)
+ * sees the same sequence of items from one run to the other. Items are
+ * retrieved by next() in submission order whatever the thread that
+ * processed them, so the output of the threaded event loops in the Falaise
+ * applications does not depend on scheduling.
+ *
+ * At most capacity() items may be in flight (submitted but not retrieved),
+ * the caller being expected to retrieve items before submitting more:
+ *
+ * ```cpp
+ * falaise::ordered_workers<int> pool{4, 2, [](std::size_t worker, int& x) { x *= 2; }};
+ *
+ * int x = 0;
+ * for (int i = 0; i < 10; ++i) {
+ *   if (pool.in_flight() == pool.capacity()) {
+ *     pool.next(x);
+ *     ... use x ...
+ *   }
+ *   pool.submit(i);
+ * }
+ * while (pool.next(x)) {
+ *   ... use x ...
+ * }
+ * ```
+ *
+ * After stop(), the items still queued are not processed but are still
+ * delivered by next(), unchanged.
+ */
+template <typename T>
+class ordered_workers {
+ public:
+  //! Function processing an item in the thread of the given worker
+  using task_type = std::function<void(std::size_t worker, T& item)>;
+
+  //! Start the worker threads
+  /*!
+   * \param[in] nworkers number of worker threads
+   * \param[in] depth number of items queued per worker
+   * \param[in] task function processing the items, called concurrently by the workers
+   * \throw std::invalid_argument if nworkers or depth is zero
+   */
+  ordered_workers(std::size_t nworkers, std::size_t depth, task_type task)
+      : depth_{depth}, task_{std::move(task)} {
+    if (nworkers == 0) {
+      throw std::invalid_argument("ordered_workers needs at least one worker");
+    }
+    if (depth_ == 0) {
+      throw std::invalid_argument("ordered_workers depth must be non-zero");
+    }
+    for (std::size_t iworker = 0; iworker < nworkers; ++iworker) {
+      todo_.emplace_back(new slot_queue{depth_});
+    }
+    try {
+      for (std::size_t iworker = 0; iworker < nworkers; ++iworker) {
+        threads_.emplace_back(&ordered_workers::run_, this, iworker);
+      }
+    } catch (...) {
+      // Join the threads already started before giving up
+      stop();
+      throw;
+    }
+  }
+
+  //! Stop and join the worker threads
+  ~ordered_workers() { stop(); }
+
+  ordered_workers(const ordered_workers&) = delete;
+  ordered_workers& operator=(const ordered_workers&) = delete;
+
+  //! Return the number of worker threads
+  std::size_t size() const { return todo_.size(); }
+
+  //! Return the maximum number of items that may be in flight
+  std::size_t capacity() const { return depth_ * todo_.size(); }
+
+  //! Return the number of submitted items, which is the rank of the next one
+  std::size_t submitted() const { return submitted_; }
+
+  //! Return the number of submitted items not yet retrieved
+  std::size_t in_flight() const { return submitted_ - retrieved_; }
+
+  //! Queue an item for processing
+  /*!
+   * \param[in] item value to move to its worker
+   * \return the rank of the item in submission order
+   * \throw std::logic_error if capacity() items are in flight or the workers are stopped
+   */
+  std::size_t submit(T&& item) {
+    if (in_flight() >= capacity()) {
+      throw std::logic_error("ordered_workers has too many items in flight");
+    }
+    slot s;
+    s.index = submitted_;
+    s.item = std::move(item);
+    // At most capacity() consecutive items are in flight, so the queue
+    // of the worker never holds more than depth items and push does not block
+    if (!todo_[submitted_ % todo_.size()]->push(std::move(s))) {
+      throw std::logic_error("ordered_workers are stopped");
+    }
+    return submitted_++;
+  }
+
+  //! Wait for the next item in submission order
+  /*!
+   * \param[out] item receives the processed value
+   * \return false if no item is in flight
+   * \throw any exception thrown by the task while processing this item,
+   *        the item being consumed anyway
+   */
+  bool next(T& item) {
+    if (in_flight() == 0) {
+      return false;
+    }
+    std::unique_lock<std::mutex> lock{doneMutex_};
+    doneCondition_.wait(lock, [this] { return done_.count(retrieved_) != 0; });
+    auto found = done_.find(retrieved_);
+    item = std::move(found->second.item);
+    std::exception_ptr error = found->second.error;
+    done_.erase(found);
+    retrieved_++;
+    lock.unlock();
+    if (error) {
+      std::rethrow_exception(error);
+    }
+    return true;
+  }
+
+  //! Skip the queued items and join the worker threads
+  void stop() {
+    abort_ = true;
+    for (auto& todo : todo_) {
+      todo->close();
+    }
+    for (std::thread& worker : threads_) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+    }
+  }
+
+ private:
+  //! Item travelling through the pool
+  struct slot {
+    std::size_t index = 0;     //< rank in submission order
+    T item;                    //< the item
+    std::exception_ptr error;  //< exception thrown by the task, if any
+  };
+  using slot_queue = bounded_queue<slot>;
+
+  //! Worker thread main loop
+  void run_(std::size_t worker) {
+    slot s;
+    while (todo_[worker]->pop(s)) {
+      if (!abort_) {
+        try {
+          task_(worker, s.item);
+        } catch (...) {
+          s.error = std::current_exception();
+        }
+      }
+      {
+        std::lock_guard<std::mutex> lock{doneMutex_};
+        done_[s.index] = std::move(s);
+      }
+      doneCondition_.notify_all();
+      s = slot{};
+    }
+  }
+
+  const std::size_t depth_;                        //< items queued per worker
+  task_type task_;                                 //< processing function
+  std::vector<std::unique_ptr<slot_queue>> todo_;  //< items waiting for each worker
+  std::atomic<bool> abort_{false};                 //< flag to skip queued items
+  std::size_t submitted_ = 0;                      //< number of submitted items
+  std::size_t retrieved_ = 0;                      //< number of retrieved items
+  std::mutex doneMutex_;                           //< protects done_
+  std::condition_variable doneCondition_;          //< signalled when an item is done
+  std::map<std::size_t, slot> done_;               //< processed items by index
+  std::vector<std::thread> threads_;               //< worker threads
+};
+}  // namespace falaise
+
+#endif  // FALAISE_ORDERED_WORKERS_H
@@ -70,11 +70,13 @@ list(APPEND FalaiseLibrary_HEADERS
   snemo/geometry/utils.h
   snemo/geometry/calo_locator.h
   snemo/geometry/xcalo_locator.h
+  snemo/geometry/geom_info_table.h
   snemo/geometry/gg_locator.h
   snemo/geometry/gveto_locator.h
   snemo/geometry/locator_helpers.h
   snemo/geometry/locator_plugin.h
   snemo/geometry/mapped_magnetic_field.h
+  snemo/geometry/neighbour_table.h
   snemo/geometry/helix_intercept.h
   snemo/geometry/manager.h
 
@@ -101,6 +103,7 @@ list(APPEND FalaiseLibrary_HEADERS
   snemo/processing/base_gamma_builder.h
   snemo/processing/detail/GeigerTimePartitioner.h
   snemo/processing/event_header_utils_module.h
+  snemo/processing/calo_waveform_features.h
   snemo/processing/udd2pcd_module.h
   snemo/processing/mock_calorimeter_s2c_module.h
   snemo/processing/mock_calorimeter_s2c_module_utils.h
@@ -180,11 +183,13 @@ list(APPEND FalaiseLibrary_SOURCES
   snemo/geometry/config.cc
   snemo/geometry/calo_locator.cc
   snemo/geometry/xcalo_locator.cc
+  snemo/geometry/geom_info_table.cc
   snemo/geometry/gg_locator.cc
   snemo/geometry/gveto_locator.cc
   snemo/geometry/locator_plugin.cc
   snemo/geometry/utils.cc
   snemo/geometry/mapped_magnetic_field.cc
+  snemo/geometry/neighbour_table.cc
   snemo/geometry/private/categories.h
   snemo/geometry/helix_intercept.cc
   snemo/geometry/manager.cc
@@ -194,11 +199,14 @@ list(APPEND FalaiseLibrary_SOURCES
   snemo/processing/event_header_utils_module.cc
   snemo/processing/calorimeter_regime.cc
   snemo/processing/geiger_regime.cc
+  snemo/processing/calo_waveform_features.cc
   snemo/processing/udd2pcd_module.cc
   snemo/processing/mock_calorimeter_s2c_module.cc
   snemo/processing/mock_calorimeter_s2c_module_utils.cc
   snemo/processing/mock_tracker_s2c_module.cc
   snemo/processing/detail/mock_raw_tracker_hit.h
+  snemo/processing/detail/tracker_cell_grid.h
+  snemo/processing/detail/tracker_hit_clustering.h
   snemo/processing/black_hole_module.cc
   snemo/processing/base_tracker_clusterizer.cc
   snemo/processing/base_tracker_fitter.cc
@@ -227,6 +235,7 @@ list(APPEND FalaiseLibrary_SOURCES
   snemo/simulation/config.cc
   snemo/simulation/cosmic_muon_generator.cc
   snemo/simulation/gg_step_hit_processor.cc
+  snemo/simulation/detail/gg_ionization.h
   snemo/simulation/calorimeter_step_hit_processor.cc
   snemo/simulation/arbitrary_event_generator_injector.cc
   snemo/simulation/from_ascii_files_event_generator.cc
@@ -259,6 +268,16 @@ list(APPEND FalaiseLibrary_TESTS_CATCH
   snemo/test/test_snemo_datamodel_event.cxx
   snemo/test/test_snemo_datamodel_timestamp.cxx
   snemo/test/test_snemo_geometry_gveto_locator_2.cxx
+  snemo/test/test_snemo_geometry_geom_info_table.cxx
+  snemo/test/test_snemo_geometry_gg_locator_batch.cxx
+  snemo/test/test_snemo_geometry_neighbour_table.cxx
+  snemo/test/test_snemo_geometry_helix_intercept.cxx
+  snemo/test/test_snemo_processing_geiger_regime.cxx
+  snemo/test/test_snemo_simulation_gg_ionization.cxx
+  snemo/test/test_snemo_processing_calo_waveform_features.cxx
+  snemo/test/test_snemo_processing_calorimeter_regime_cache.cxx
+  snemo/test/test_snemo_processing_udd2pcd_parallel.cxx
+  snemo/test/test_snemo_processing_tracker_hit_clustering.cxx
   snemo/test/test_filter.cxx
   snemo/test/test_module.cxx
   snemo/test/test_service.cxx
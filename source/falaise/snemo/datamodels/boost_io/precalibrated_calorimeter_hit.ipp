@@ -21,7 +21,7 @@ namespace snemo {
 
     /// Serialization method
     template <class Archive>
-    void precalibrated_calorimeter_hit::serialize(Archive& ar_, const unsigned int /* version */) {
+    void precalibrated_calorimeter_hit::serialize(Archive& ar_, const unsigned int version_) {
       ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(base_hit);
       ar_ & boost::serialization::make_nvp("baseline", _baseline_);
       ar_ & boost::serialization::make_nvp("sigma_baseline", _sigma_baseline_);
@@ -31,7 +31,13 @@ namespace snemo {
       ar_ & boost::serialization::make_nvp("sigma_charge", _sigma_charge_);
       ar_ & boost::serialization::make_nvp("time", _time_);
       ar_ & boost::serialization::make_nvp("sigma_time", _sigma_time_);
-
+      if (version_ >= 1) {
+        ar_ & boost::serialization::make_nvp("time_cfd", _time_cfd_);
+        ar_ & boost::serialization::make_nvp("pulse_width", _pulse_width_);
+      } else if (Archive::is_loading::value) {
+        // version 0: the CFD time and the pulse width were auxiliary properties
+        _import_legacy_auxiliaries_();
+      }
     }
 
   }  // end of namespace datamodel
@@ -22,7 +22,7 @@ namespace snemo {
   namespace datamodel {
 
     template <class Archive>
-    void precalibrated_tracker_hit::serialize(Archive& ar_, const unsigned int /* version_ */) {
+    void precalibrated_tracker_hit::serialize(Archive& ar_, const unsigned int version_) {
       ar_ & BOOST_SERIALIZATION_BASE_OBJECT_NVP(base_hit);
       ar_ & boost::serialization::make_nvp("anodic_time", _anodic_time_);
       ar_ & boost::serialization::make_nvp("sigma_anodic_time", _sigma_anodic_time_);
@@ -32,7 +32,15 @@ namespace snemo {
       ar_ & boost::serialization::make_nvp("sigma_bottom_cathode_drift_time", _sigma_bottom_cathode_drift_time_);
       ar_ & boost::serialization::make_nvp("top_cathode_drift_time", _top_cathode_drift_time_);
       ar_ & boost::serialization::make_nvp("sigma_top_cathode_drift_time", _sigma_top_cathode_drift_time_);
-
+      if (version_ >= 2) {
+        ar_ & boost::serialization::make_nvp("anodic_r1_time", _anodic_ri_times_[0]);
+        ar_ & boost::serialization::make_nvp("anodic_r2_time", _anodic_ri_times_[1]);
+        ar_ & boost::serialization::make_nvp("anodic_r3_time", _anodic_ri_times_[2]);
+        ar_ & boost::serialization::make_nvp("anodic_r4_time", _anodic_ri_times_[3]);
+      } else if (Archive::is_loading::value) {
+        // version <= 1: the R1-R4 anodic times were auxiliary properties
+        _import_legacy_auxiliaries_();
+      }
     }
 
   }  // end of namespace datamodel
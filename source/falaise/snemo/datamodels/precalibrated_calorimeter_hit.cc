@@ -192,6 +192,67 @@ namespace snemo {
       return;
     }
 
+    double precalibrated_calorimeter_hit::get_time_cfd() const
+    {
+      return _time_cfd_;
+    }
+
+    bool precalibrated_calorimeter_hit::has_time_cfd() const
+    {
+      return datatools::is_valid(_time_cfd_);
+    }
+
+    void precalibrated_calorimeter_hit::set_time_cfd(double time_cfd_)
+    {
+      _time_cfd_ = time_cfd_;
+      return;
+    }
+
+    void precalibrated_calorimeter_hit::reset_time_cfd()
+    {
+      _time_cfd_ = datatools::invalid_real();
+      return;
+    }
+
+    double precalibrated_calorimeter_hit::get_pulse_width() const
+    {
+      return _pulse_width_;
+    }
+
+    bool precalibrated_calorimeter_hit::has_pulse_width() const
+    {
+      return datatools::is_valid(_pulse_width_);
+    }
+
+    void precalibrated_calorimeter_hit::set_pulse_width(double pulse_width_)
+    {
+      _pulse_width_ = pulse_width_;
+      return;
+    }
+
+    void precalibrated_calorimeter_hit::reset_pulse_width()
+    {
+      _pulse_width_ = datatools::invalid_real();
+      return;
+    }
+
+    void precalibrated_calorimeter_hit::_import_legacy_auxiliaries_()
+    {
+      // The hit may be reused, so quantities missing from the archive must be reset
+      reset_time_cfd();
+      reset_pulse_width();
+      datatools::properties & aux = grab_auxiliaries();
+      if (aux.has_key("time_cfd_ns")) {
+        _time_cfd_ = aux.fetch_real("time_cfd_ns") * CLHEP::ns;
+        aux.erase("time_cfd_ns");
+      }
+      if (aux.has_key("pulse_width_ns")) {
+        _pulse_width_ = aux.fetch_real("pulse_width_ns") * CLHEP::ns;
+        aux.erase("pulse_width_ns");
+      }
+      return;
+    }
+
     bool precalibrated_calorimeter_hit::is_valid() const
     {
       return this->base_hit::is_valid();
@@ -209,6 +270,8 @@ namespace snemo {
       datatools::invalidate(_sigma_charge_);
       datatools::invalidate(_time_);
       datatools::invalidate(_sigma_time_);
+      datatools::invalidate(_time_cfd_);
+      datatools::invalidate(_pulse_width_);
     }
   
     void precalibrated_calorimeter_hit::print_tree(std::ostream & out_,
@@ -253,7 +316,7 @@ namespace snemo {
       tmp_time_sec   -= 1E-6 * time_usec;
       double time_nsec = tmp_time_sec*1E9;
 
-      out_ << indent << last_tag << "Time: "
+      out_ << indent << tag << "Time: "
           << time_day << "d " << time_hour << "h " << time_min << "m " << time_sec << "s "
           << time_msec << "ms " << time_usec << "us " << time_nsec;
       if (has_sigma_time()) {
@@ -261,6 +324,20 @@ namespace snemo {
       }
       out_ << "ns\n";
 
+      out_ << indent << tag << "CFD time: ";
+      if (has_time_cfd()) {
+        out_ << _time_cfd_ / CLHEP::ns << " ns\n";
+      } else {
+        out_ << "missing\n";
+      }
+
+      out_ << indent << last_tag << "Pulse width: ";
+      if (has_pulse_width()) {
+        out_ << _pulse_width_ / CLHEP::ns << " ns\n";
+      } else {
+        out_ << "missing\n";
+      }
+
       return;
     }
 
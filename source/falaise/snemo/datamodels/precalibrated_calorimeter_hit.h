@@ -3,7 +3,7 @@
 /* Author(s) :    Guillaume Oliviero <oliviero@cenbg.in2p3.fr>
  *                Emmanuel Chauveau <chauveau@cenbg.in2p3.fr>
  * Creation date: 2022-05-03
- * Last modified: 2024-03-13
+ * Last modified: 2026-10-18
  *
  * Description:
  *
@@ -131,6 +131,30 @@ namespace snemo {
       /// Reset the error on the time
       void reset_sigma_time();
 
+      /// Return the CFD time of the pulse in the record window
+      double get_time_cfd() const;
+
+      /// Set the CFD time of the pulse in the record window
+      void set_time_cfd(double);
+
+      /// Check if the CFD time is valid
+      bool has_time_cfd() const;
+
+      /// Reset the CFD time
+      void reset_time_cfd();
+
+      /// Return the width of the pulse (between the falling and rising CFD times)
+      double get_pulse_width() const;
+
+      /// Set the width of the pulse
+      void set_pulse_width(double);
+
+      /// Check if the width of the pulse is valid
+      bool has_pulse_width() const;
+
+      /// Reset the width of the pulse
+      void reset_pulse_width();
+
       /// Check if the internal data of the hit are valid
       bool is_valid() const override;
 
@@ -143,6 +167,9 @@ namespace snemo {
  
     private:
 
+      /// Move the quantities stored as auxiliary properties by version 0 into their attributes
+      void _import_legacy_auxiliaries_();
+
       double _baseline_{datatools::invalid_real()};           //!< Baseline associated to the hit
       double _sigma_baseline_{datatools::invalid_real()};     //!< Error on the baseline associated to the hit
       double _amplitude_{datatools::invalid_real()};          //!< Amplitude associated to the hit
@@ -151,6 +178,8 @@ namespace snemo {
       double _sigma_charge_{datatools::invalid_real()};       //!< Error on the charge associated to the hit
       double _time_{datatools::invalid_real()};               //!< Time associated to the hit
       double _sigma_time_{datatools::invalid_real()};         //!< Error on the time associated to the hit
+      double _time_cfd_{datatools::invalid_real()};           //!< CFD time of the pulse in the record window
+      double _pulse_width_{datatools::invalid_real()};        //!< Width of the pulse
 
       DATATOOLS_SERIALIZATION_DECLARATION()
     };
@@ -169,4 +198,8 @@ namespace snemo {
 
 } // end of namespace snemo
 
+// Class version:
+#include <boost/serialization/version.hpp>
+BOOST_CLASS_VERSION(snemo::datamodel::precalibrated_calorimeter_hit, 1)
+
 #endif // FALAISE_SNEMO_DATAMODELS_PRECALIBRATED_CALORIMETER_HIT_H
@@ -7,6 +7,7 @@
 // Third party:
 // - Bayeux/datatools
 #include <datatools/clhep_units.h>
+#include <datatools/exception.h>
 #include <datatools/utils.h>
 
 namespace snemo {
@@ -126,6 +127,32 @@ namespace snemo {
       return;
     }
 
+    const int precalibrated_tracker_hit::NB_ANODIC_RI;
+
+    double precalibrated_tracker_hit::get_anodic_ri_time(int ri_) const
+    {
+      DT_THROW_IF(ri_ < 1 || ri_ > NB_ANODIC_RI, std::range_error, "Invalid anodic timestamp R" << ri_ << "!");
+      return _anodic_ri_times_[ri_ - 1];
+    }
+
+    void precalibrated_tracker_hit::set_anodic_ri_time(int ri_, double anodic_ri_time_)
+    {
+      DT_THROW_IF(ri_ < 1 || ri_ > NB_ANODIC_RI, std::range_error, "Invalid anodic timestamp R" << ri_ << "!");
+      _anodic_ri_times_[ri_ - 1] = anodic_ri_time_;
+      return;
+    }
+
+    bool precalibrated_tracker_hit::has_anodic_ri_time(int ri_) const
+    {
+      return datatools::is_valid(get_anodic_ri_time(ri_));
+    }
+
+    void precalibrated_tracker_hit::reset_anodic_ri_time(int ri_)
+    {
+      set_anodic_ri_time(ri_, datatools::invalid_real());
+      return;
+    }
+
     double precalibrated_tracker_hit::get_plasma_propagation_time() const
     {
       if (has_bottom_cathode_drift_time() && has_top_cathode_drift_time()) return _bottom_cathode_drift_time_ + _top_cathode_drift_time_;
@@ -154,6 +181,21 @@ namespace snemo {
       return;
     }
 
+    void precalibrated_tracker_hit::_import_legacy_auxiliaries_()
+    {
+      // The hit may be reused, so times missing from the archive must be reset
+      _anodic_ri_times_.fill(datatools::invalid_real());
+      datatools::properties & aux = grab_auxiliaries();
+      for (int ri = 1; ri <= NB_ANODIC_RI; ri++) {
+        const std::string ri_key = "R" + std::to_string(ri) + "_us";
+        if (aux.has_key(ri_key)) {
+          _anodic_ri_times_[ri - 1] = aux.fetch_real(ri_key) * CLHEP::microsecond;
+          aux.erase(ri_key);
+        }
+      }
+      return;
+    }
+
     bool precalibrated_tracker_hit::is_valid() const
     {
       return this->base_hit::is_valid() and has_anodic_time();
@@ -168,6 +210,7 @@ namespace snemo {
       datatools::invalidate(_sigma_bottom_cathode_drift_time_);
       datatools::invalidate(_top_cathode_drift_time_);
       datatools::invalidate(_sigma_top_cathode_drift_time_);
+      _anodic_ri_times_.fill(datatools::invalid_real());
     }
 
     void precalibrated_tracker_hit::clear()
@@ -210,13 +253,22 @@ namespace snemo {
 	out_ << "missing\n";
       }
 
-      out_ << indent << last_tag << "Top cathode drift time: ";
+      out_ << indent << tag << "Top cathode drift time: ";
       if (has_top_cathode_drift_time()) {
 	out_ << _top_cathode_drift_time_ / CLHEP::microsecond << " us +/- " << _sigma_bottom_cathode_drift_time_ / CLHEP::nanosecond << " ns\n";
       } else {
 	out_ << "missing\n";
       }
 
+      for (int ri = 1; ri <= NB_ANODIC_RI; ri++) {
+        out_ << indent << (ri == NB_ANODIC_RI ? last_tag : tag) << "Anodic R" << ri << " time: ";
+        if (has_anodic_ri_time(ri)) {
+          out_ << get_anodic_ri_time(ri) / CLHEP::microsecond << " us\n";
+        } else {
+          out_ << "missing\n";
+        }
+      }
+
       return;
     }
 
@@ -4,7 +4,7 @@
  *                Emmanuel Chauveau <chauveau@cenbg.in2p3.fr>
  *
  * Creation date: 2022-05-03
- * Last modified: 2024-03-13
+ * Last modified: 2026-10-18
  *
  * Description:
  *
@@ -16,6 +16,7 @@
 #define FALAISE_SNEMO_DATAMODELS_PRECALIBRATED_TRACKER_HIT_H 1
 
 // Standard library:
+#include <array>
 #include <string>
 #include <vector>
 
@@ -114,6 +115,22 @@ namespace snemo {
       void reset_sigma_top_cathode_drift_time();
 
 
+      /// Number of additional anodic timestamps (R1 to R4)
+      static const int NB_ANODIC_RI = 4;
+
+      /// Return the time of the anodic timestamp R<ri_> (ri_ in [1, 4]) relative to the anodic time (R0)
+      double get_anodic_ri_time(int ri_) const;
+
+      /// Set the time of the anodic timestamp R<ri_> relative to the anodic time
+      void set_anodic_ri_time(int ri_, double);
+
+      /// Check if the time of the anodic timestamp R<ri_> is valid
+      bool has_anodic_ri_time(int ri_) const;
+
+      /// Reset the time of the anodic timestamp R<ri_>
+      void reset_anodic_ri_time(int ri_);
+
+
       /// Return the plasma propagation time associated to the hit (bottom + top cathode times)
       double get_plasma_propagation_time() const;
 
@@ -132,13 +149,18 @@ namespace snemo {
                       const boost::property_tree::ptree & options_ = empty_options()) const override;
 
     private:
-      
+
+      /// Move the quantities stored as auxiliary properties by version 1 into their attributes
+      void _import_legacy_auxiliaries_();
+
       double _anodic_time_{datatools::invalid_real()};                      //!< Anodic absolute time of the cell
       double _sigma_anodic_time_{datatools::invalid_real()};                //!< Error on anodic absolute time of the cell
       double _bottom_cathode_drift_time_{datatools::invalid_real()};        //!< Bottom cathode drift time of the cell
       double _sigma_bottom_cathode_drift_time_{datatools::invalid_real()};  //!< Error on bottom cathode drift time of the cell
       double _top_cathode_drift_time_{datatools::invalid_real()};           //!< Top cathode drift time of the cell
       double _sigma_top_cathode_drift_time_{datatools::invalid_real()};     //!< Error on top cathode drift time of the cell
+      std::array<double, NB_ANODIC_RI> _anodic_ri_times_{{datatools::invalid_real(), datatools::invalid_real(),
+                                                          datatools::invalid_real(), datatools::invalid_real()}}; //!< R1-R4 anodic times relative to R0
 
       DATATOOLS_SERIALIZATION_DECLARATION()
     };
@@ -159,7 +181,7 @@ namespace snemo {
 
 // Class version:
 #include <boost/serialization/version.hpp>
-BOOST_CLASS_VERSION(snemo::datamodel::precalibrated_tracker_hit, 1)
+BOOST_CLASS_VERSION(snemo::datamodel::precalibrated_tracker_hit, 2)
 
 #endif // FALAISE_SNEMO_DATAMODELS_PRECALIBRATED_TRACKER_HIT_H
 
@@ -23,10 +23,12 @@
 
 // Ourselves:
 #include <falaise/snemo/geometry/calo_locator.h>
+#include <falaise/snemo/geometry/geom_info_table.h>
 
 #include "private/categories.h"
 
 // Standard library:
+#include <array>
 #include <stdexcept>
 
 // Third party:
@@ -64,6 +66,7 @@ void calo_locator::initialize(const datatools::properties &ps) {
   DT_THROW_IF(moduleNumber_ == geomtools::geom_id::INVALID_ADDRESS, std::logic_error,
               "Missing module number ! Use the 'setModuleNumber' method before !");
   construct_();
+  buildNeighbourTable_();
   isInitialized_ = true;
 }
 
@@ -79,6 +82,8 @@ uint32_t calo_locator::getModuleNumber() const { return moduleNumber_; }
 
 void calo_locator::setModuleNumber(uint32_t number) { moduleNumber_ = number; }
 
+void calo_locator::setGeomInfoTable(const geom_info_table *table) { geomInfoTable_ = table; }
+
 uint32_t calo_locator::getBlockPart() const { return blockPart_; }
 
 void calo_locator::setBlockPart(uint32_t part) { blockPart_ = part; }
@@ -536,6 +541,19 @@ std::vector<geomtools::geom_id> calo_locator::getNeighbourGIDs(uint32_t side, ui
   return ids_;
 }
 
+geom_id_range calo_locator::getNeighbourRange(const geomtools::geom_id &gid, uint8_t mask) const {
+  DT_THROW_IF(
+      gid.get(moduleAddressIndex_) != moduleNumber_, std::logic_error,
+      "Invalid module number (" << gid.get(moduleAddressIndex_) << "!=" << moduleNumber_ << ")!");
+  return getNeighbourRange(gid.get(sideAddressIndex_), gid.get(columnAddressIndex_),
+                           gid.get(rowAddressIndex_), mask);
+}
+
+geom_id_range calo_locator::getNeighbourRange(uint32_t side, uint32_t column, uint32_t row,
+                                              uint8_t mask) const {
+  return neighbourTable_.get(blockIndex_(side, column, row), mask);
+}
+
 double calo_locator::getXCoordOfWall(uint32_t side) const {
   if (side == 0) {
     return blockWall_X_[0];
@@ -727,7 +745,9 @@ bool calo_locator::findBlockGID_(const geomtools::vector_3d &in_module_position_
     gid.set(rowAddressIndex_, row_number);
     if (gid.is_valid()) {
       // 2012-05-31 FM : use ginfo from mapping (see below)
-      const geomtools::geom_info *ginfo_ptr = geomMapping_->get_geom_info_ptr(gid);
+      const geomtools::geom_info *ginfo_ptr = geomInfoTable_ != nullptr
+                                                  ? geomInfoTable_->getInfo(gid)
+                                                  : geomMapping_->get_geom_info_ptr(gid);
       if (ginfo_ptr == nullptr) {
         gid.invalidate();
         return false;
@@ -838,6 +858,7 @@ void calo_locator::tree_dump(std::ostream &out, const std::string &title, const
 }
 
 void calo_locator::set_defaults_() {
+  neighbourTable_.clear();
   moduleNumber_ = geomtools::geom_id::INVALID_ADDRESS;
   blockPart_ = geomtools::geom_id::INVALID_ADDRESS;
   blocksArePartitioned_ = false;
@@ -866,9 +887,38 @@ void calo_locator::set_defaults_() {
   frontCaloBlock_Z_.clear();
   frontCaloBlock_Y_.clear();
 
+  geomInfoTable_ = nullptr;
   isInitialized_ = false;
 }
 
+size_t calo_locator::blockIndex_(uint32_t side, uint32_t column, uint32_t row) const {
+  DT_THROW_IF(side > 1, std::logic_error, "Invalid side number (" << side << "> 1)!");
+  DT_THROW_IF(column >= numberOfColumns(side), std::logic_error,
+              "Invalid column number (" << column << ">" << numberOfColumns(side) - 1 << ")!");
+  DT_THROW_IF(row >= numberOfRows(side), std::logic_error,
+              "Invalid row number (" << row << ">" << numberOfRows(side) - 1 << ")!");
+  size_t index = 0;
+  if (side == (uint32_t)side_t::FRONT) {
+    index = numberOfColumns(side_t::BACK) * numberOfRows(side_t::BACK);
+  }
+  return index + column * numberOfRows(side) + row;
+}
+
+void calo_locator::buildNeighbourTable_() {
+  // Blocks in the order of their index:
+  std::vector<std::array<uint32_t, 3>> blocks;
+  for (uint32_t side = 0; side < utils::NSIDES; side++) {
+    for (uint32_t column = 0; column < numberOfColumns(side); column++) {
+      for (uint32_t row = 0; row < numberOfRows(side); row++) {
+        blocks.push_back({{side, column, row}});
+      }
+    }
+  }
+  neighbourTable_.build(blocks.size(), [this, &blocks](size_t block, uint8_t mask) {
+    return getNeighbourGIDs(blocks[block][0], blocks[block][1], blocks[block][2], mask);
+  });
+}
+
 void calo_locator::construct_() {
   geomMapping_ = &get_geo_manager().get_mapping();
   const geomtools::id_mgr &idManager = get_geo_manager().get_id_mgr();
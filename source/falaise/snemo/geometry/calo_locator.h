@@ -44,6 +44,7 @@
 
 // This project:
 #include <falaise/property_set.h>
+#include <falaise/snemo/geometry/neighbour_table.h>
 #include <falaise/snemo/geometry/utils.h>
 
 // Forward declaration:
@@ -60,6 +61,8 @@ namespace snemo {
 
 namespace geometry {
 
+class geom_info_table;
+
 /// \brief Fast locator class for SuperNEMO main calorimeter scintillator block volumes
 class calo_locator : public geomtools::base_locator, public datatools::i_tree_dumpable {
  public:
@@ -114,6 +117,11 @@ class calo_locator : public geomtools::base_locator, public datatools::i_tree_du
    */
   void setModuleNumber(uint32_t number);
 
+  /**! Resolve the geometry IDs of the blocks through a dense table rather than
+   *   through the geometry mapping (the table must outlive the locator).
+   */
+  void setGeomInfoTable(const geom_info_table* table);
+
   /**! return the block part number for this locator.
    */
   uint32_t getBlockPart() const;
@@ -188,6 +196,19 @@ class calo_locator : public geomtools::base_locator, public datatools::i_tree_du
   std::vector<geomtools::geom_id> getNeighbourGIDs(const geomtools::geom_id& gid,
                                                    uint8_t mask = grid_mask_t::FIRST) const;
 
+  /** Given a block at specific side, column and row, return the range of the geometry IDs of
+   * associated neighbouring blocks, as computed by getNeighbourGIDs but from tables precomputed
+   * at initialization, without allocation. The range is valid as long as the locator.
+   */
+  geom_id_range getNeighbourRange(uint32_t side, uint32_t column, uint32_t row,
+                                  uint8_t mask = grid_mask_t::FIRST) const;
+
+  /** Given a block with a specific geometry ID, return the range of the geometry IDs of
+   * associated neighbouring blocks (see above).
+   */
+  geom_id_range getNeighbourRange(const geomtools::geom_id& gid,
+                                  uint8_t mask = grid_mask_t::FIRST) const;
+
   /**! @return the X-position of a wall for specific side (in module coordinate system).
    */
   double getXCoordOfWall(uint32_t side) const;
@@ -277,7 +298,15 @@ class calo_locator : public geomtools::base_locator, public datatools::i_tree_du
   bool isBlockPartitioned() const;
 
  private:
+  /// Return the index of a block in the neighbour table
+  size_t blockIndex_(uint32_t side, uint32_t column, uint32_t row) const;
+
+  /// Precompute the neighbours of all blocks
+  void buildNeighbourTable_();
+
   bool isInitialized_;
+  const geom_info_table* geomInfoTable_;
+  neighbour_table neighbourTable_;  //!< Neighbours of the blocks for every mask
 
   // Configuration parameters :
   uint32_t moduleNumber_;
@@ -0,0 +1,108 @@
+// falaise/snemo/geometry/geom_info_table.cc
+
+// Ourselves:
+#include <falaise/snemo/geometry/geom_info_table.h>
+
+// Standard library:
+#include <algorithm>
+#include <stdexcept>
+
+// Third party:
+// - Bayeux/datatools:
+#include <datatools/exception.h>
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+#include <geomtools/geom_info.h>
+#include <geomtools/logical_volume.h>
+#include <geomtools/mapping.h>
+
+namespace snemo {
+
+namespace geometry {
+
+namespace {
+/// Largest number of entries of a table, far above the SuperNEMO address spaces
+const size_t kMaxEntries = 1 << 22;
+}  // namespace
+
+geom_info_table::geom_info_table(const geomtools::mapping& mapping, uint32_t type) : type_(type) {
+  const geomtools::geom_info_dict_type& infos = mapping.get_geom_infos();
+
+  // First pass: extent of each address
+  for (const auto& item : infos) {
+    const geomtools::geom_id& gid = item.first;
+    if (gid.get_type() != type_ || !gid.is_complete()) {
+      continue;
+    }
+    if (extents_.empty()) {
+      extents_.assign(gid.get_depth(), 0);
+    }
+    DT_THROW_IF(gid.get_depth() != extents_.size(), std::logic_error,
+                "Geometry ID " << gid << " has not the depth of category type " << type_ << " !");
+    for (size_t i = 0; i < extents_.size(); i++) {
+      extents_[i] = std::max(extents_[i], gid.get(i) + 1);
+    }
+  }
+
+  size_t nentries = extents_.empty() ? 0 : 1;
+  for (uint32_t extent : extents_) {
+    nentries *= extent;
+    DT_THROW_IF(nentries > kMaxEntries, std::logic_error,
+                "Address space of category type " << type_ << " is too large for a dense table !");
+  }
+  entries_.resize(nentries);
+
+  // Second pass: fill the entries
+  for (const auto& item : infos) {
+    const geomtools::geom_id& gid = item.first;
+    if (gid.get_type() != type_ || !gid.is_complete()) {
+      continue;
+    }
+    entry& e = entries_[find_(gid) - entries_.data()];
+    e.info = &item.second;
+    e.placement = &item.second.get_world_placement();
+    e.shape = &item.second.get_logical().get_shape();
+    count_++;
+  }
+}
+
+uint32_t geom_info_table::getType() const { return type_; }
+
+size_t geom_info_table::getDepth() const { return extents_.size(); }
+
+size_t geom_info_table::size() const { return count_; }
+
+const geom_info_table::entry* geom_info_table::find_(const geomtools::geom_id& gid) const {
+  if (gid.get_type() != type_ || gid.get_depth() != extents_.size() || entries_.empty()) {
+    return nullptr;
+  }
+  size_t index = 0;
+  for (size_t i = 0; i < extents_.size(); i++) {
+    const uint32_t address = gid.get(i);
+    // Also rejects the invalid and 'any' addresses
+    if (address >= extents_[i]) {
+      return nullptr;
+    }
+    index = index * extents_[i] + address;
+  }
+  return &entries_[index];
+}
+
+const geomtools::geom_info* geom_info_table::getInfo(const geomtools::geom_id& gid) const {
+  const entry* e = find_(gid);
+  return e == nullptr ? nullptr : e->info;
+}
+
+const geomtools::placement* geom_info_table::getPlacement(const geomtools::geom_id& gid) const {
+  const entry* e = find_(gid);
+  return e == nullptr ? nullptr : e->placement;
+}
+
+const geomtools::i_shape_3d* geom_info_table::getShape(const geomtools::geom_id& gid) const {
+  const entry* e = find_(gid);
+  return e == nullptr ? nullptr : e->shape;
+}
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
@@ -0,0 +1,86 @@
+/// \file falaise/snemo/geometry/geom_info_table.h
+/*
+ * Description:
+ *
+ *   Dense lookup table of the geometry mapping entries of one geometry
+ *   category, indexed by the addresses of their geometry IDs.
+ *
+ */
+
+#ifndef FALAISE_SNEMO_GEOMETRY_GEOM_INFO_TABLE_H
+#define FALAISE_SNEMO_GEOMETRY_GEOM_INFO_TABLE_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace geomtools {
+class geom_id;
+class geom_info;
+class i_shape_3d;
+class mapping;
+class placement;
+}  // namespace geomtools
+
+namespace snemo {
+
+namespace geometry {
+
+/// \brief Dense geom_id to geom_info table for one geometry category
+///
+/// The geometry mapping resolves a geom_id through an ordered map keyed by
+/// the variable length address of the ID. The SuperNEMO address spaces are
+/// small and fixed (module/side/layer/row for drift cells, module/side/column/
+/// row/part for calorimeter blocks...), so the entries of one category are
+/// stored in a flat array, indexed by the row-major linearization of the
+/// addresses, with constant time access to their geom_info, world placement
+/// and shape.
+class geom_info_table {
+ public:
+  /// Default constructor
+  geom_info_table() = default;
+
+  /// Build the table of a category from the entries of a geometry mapping
+  geom_info_table(const geomtools::mapping& mapping, uint32_t type);
+
+  /// Return the geometry category type of the table
+  uint32_t getType() const;
+
+  /// Return the number of addresses of the category
+  size_t getDepth() const;
+
+  /// Return the number of mapped entries
+  size_t size() const;
+
+  /// Return the geom_info of a geometry ID, or nullptr if it is not mapped
+  const geomtools::geom_info* getInfo(const geomtools::geom_id& gid) const;
+
+  /// Return the world placement of a geometry ID, or nullptr if it is not mapped
+  const geomtools::placement* getPlacement(const geomtools::geom_id& gid) const;
+
+  /// Return the shape of a geometry ID, or nullptr if it is not mapped
+  const geomtools::i_shape_3d* getShape(const geomtools::geom_id& gid) const;
+
+ private:
+  /// Mapped volume
+  struct entry {
+    const geomtools::geom_info* info = nullptr;
+    const geomtools::placement* placement = nullptr;
+    const geomtools::i_shape_3d* shape = nullptr;
+  };
+
+  /// Return the entry of a geometry ID, or nullptr if it is out of the table
+  const entry* find_(const geomtools::geom_id& gid) const;
+
+  uint32_t type_ = 0xFFFFFFFF;    //!< Geometry category type
+  size_t count_ = 0;              //!< Number of mapped entries
+  std::vector<uint32_t> extents_; //!< Number of values of each address
+  std::vector<entry> entries_;    //!< Entries indexed by linearized address
+};
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_GEOMETRY_GEOM_INFO_TABLE_H
@@ -20,10 +20,13 @@
 
 // Ourselves:
 #include <falaise/snemo/geometry/gg_locator.h>
+#include <falaise/snemo/geometry/geom_info_table.h>
 
 #include "private/categories.h"
 
 // Standard library:
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 // Third party
@@ -59,6 +62,7 @@ void gg_locator::initialize(const datatools::properties &ps) {
   DT_THROW_IF(moduleNumber_ == geomtools::geom_id::INVALID_ADDRESS, std::logic_error,
               "Missing module number ! Use the 'setModuleNumber' method before !");
   construct_();
+  buildBatchTables_();
   isInitialized_ = true;
 }
 
@@ -71,6 +75,8 @@ uint32_t gg_locator::cellGIDType() const
   
 void gg_locator::setModuleNumber(uint32_t number) { moduleNumber_ = number; }
 
+void gg_locator::setGeomInfoTable(const geom_info_table *table) { geomInfoTable_ = table; }
+
 uint32_t gg_locator::getModuleNumber() const { return moduleNumber_; }
 
 double gg_locator::cellDiameter() const { return cellBoxShape_->get_x(); }
@@ -587,7 +593,9 @@ bool gg_locator::find_geom_id(const geomtools::vector_3d &worldPoint, int type,
     DT_LOG_DEBUG(logging, " row ok : gid=" << gid);
     if (gid.is_valid()) {
       DT_LOG_DEBUG(logging, " gid ok : gid=" << gid);
-      const geomtools::geom_info *ginfo_ptr = geomMapping_->get_geom_info_ptr(gid);
+      const geomtools::geom_info *ginfo_ptr = geomInfoTable_ != nullptr
+                                                  ? geomInfoTable_->getInfo(gid)
+                                                  : geomMapping_->get_geom_info_ptr(gid);
       if (ginfo_ptr == nullptr) {
         DT_LOG_DEBUG(logging, " gid not mapped");
         gid.invalidate();
@@ -611,6 +619,70 @@ bool gg_locator::findCellGID(const geomtools::vector_3d &worldPoint, geomtools::
   return find_geom_id(worldPoint, cellGIDType_, gid, tolerance);
 }
 
+uint32_t gg_locator::packCellIndex(uint32_t side, uint32_t layer, uint32_t row) {
+  return (side << 16) | (layer << 8) | row;
+}
+
+geomtools::geom_id gg_locator::cellGIDFromIndex(uint32_t cellIndex) const {
+  geomtools::geom_id gid;
+  if (cellIndex != INVALID_CELL_INDEX) {
+    gid.set_type(cellGIDType_);
+    gid.set(moduleAddressIndex_, moduleNumber_);
+    gid.set(sideAddressIndex_, cellIndex >> 16);
+    gid.set(layerAddressIndex_, (cellIndex >> 8) & 0xFF);
+    gid.set(rowAddressIndex_, cellIndex & 0xFF);
+  }
+  return gid;
+}
+
+size_t gg_locator::findCellIndices(size_t count, const double *x, const double *y,
+                                   const double *z, uint32_t *cellIndices,
+                                   double tolerance) const {
+  DT_THROW_IF(!is_initialized(), std::logic_error, "Locator is not initialized !");
+  if (tolerance == GEOMTOOLS_PROPER_TOLERANCE) {
+    tolerance = cellBoxShape_->get_tolerance();
+  }
+  // Same acceptance as findCellGID: strictly inside the cell box, minus half the tolerance
+  const double maxDX = cellBoxShape_->get_half_x() - 0.5 * tolerance;
+  const double maxDY = cellBoxShape_->get_half_y() - 0.5 * tolerance;
+  const double maxDZ = cellBoxShape_->get_half_z() - 0.5 * tolerance;
+  const double backMaxX = backSideMaxX_ + tolerance;
+  const double frontMinX = frontSideMinX_ - tolerance;
+  const double *m = worldToModule_;
+  const side_grid &back = sideGrids_[side_t::BACK];
+  const side_grid &front = sideGrids_[side_t::FRONT];
+  const double *cellX[utils::NSIDES] = {backCellX_.data(), frontCellX_.data()};
+  const double *cellY[utils::NSIDES] = {backCellY_.data(), frontCellY_.data()};
+
+  size_t located = 0;
+  for (size_t i = 0; i < count; i++) {
+    const double mx = m[0] * x[i] + m[1] * y[i] + m[2] * z[i] + m[3];
+    const double my = m[4] * x[i] + m[5] * y[i] + m[6] * z[i] + m[7];
+    const double mz = m[8] * x[i] + m[9] * y[i] + m[10] * z[i] + m[11];
+
+    // Side selection, the back side taking precedence as in findCellGID:
+    const bool inBack = (back.nLayers > 0) & (mx <= backMaxX);
+    const bool inFront = !inBack & (front.nLayers > 0) & (mx >= frontMinX);
+    const side_grid &grid = inBack ? back : front;
+    const uint32_t side = inBack ? side_t::BACK : side_t::FRONT;
+
+    // Nearest layer and row, clamped so that the table reads stay in range:
+    const int ix = (int)(((mx - grid.firstX) / grid.deltaX) + 0.5);
+    const int iy = (int)(((my - grid.firstY) / grid.deltaY) + 0.5);
+    const bool inGrid = (ix >= 0) & (ix < grid.nLayers) & (iy >= 0) & (iy < grid.nRows);
+    const int cx = std::min(std::max(ix, 0), std::max(grid.nLayers - 1, 0));
+    const int cy = std::min(std::max(iy, 0), std::max(grid.nRows - 1, 0));
+    const double dx = grid.nLayers > 0 ? mx - cellX[side][cx] : maxDX + 1.0;
+    const double dy = grid.nRows > 0 ? my - cellY[side][cy] : maxDY + 1.0;
+
+    const bool inCell = (inBack | inFront) & inGrid & (std::abs(dx) < maxDX) &
+                        (std::abs(dy) < maxDY) & (std::abs(mz) < maxDZ);
+    cellIndices[i] = inCell ? packCellIndex(side, cx, cy) : INVALID_CELL_INDEX;
+    located += inCell;
+  }
+  return located;
+}
+
 // ----- OUTPUT
 
 void gg_locator::tree_dump(std::ostream &out, const std::string &title, const std::string &indent,
@@ -722,6 +794,45 @@ void gg_locator::set_defaults_() {
   isInitialized_ = false;
 }
 
+void gg_locator::buildBatchTables_() {
+  // Affine world to module transformation, from the images of the origin and axes:
+  const geomtools::vector_3d origin = transformWorldToModule(geomtools::vector_3d(0., 0., 0.));
+  const geomtools::vector_3d axes[3] = {
+      transformWorldToModule(geomtools::vector_3d(1., 0., 0.)) - origin,
+      transformWorldToModule(geomtools::vector_3d(0., 1., 0.)) - origin,
+      transformWorldToModule(geomtools::vector_3d(0., 0., 1.)) - origin};
+  for (int row = 0; row < 3; row++) {
+    for (int col = 0; col < 3; col++) {
+      worldToModule_[4 * row + col] = axes[col][row];
+    }
+    worldToModule_[4 * row + 3] = origin[row];
+  }
+
+  const std::vector<double> *cellX[utils::NSIDES] = {&backCellX_, &frontCellX_};
+  const std::vector<double> *cellY[utils::NSIDES] = {&backCellY_, &frontCellY_};
+  for (size_t side = 0; side < utils::NSIDES; side++) {
+    side_grid &grid = sideGrids_[side];
+    grid = side_grid();
+    if (!submodules_[side] || cellX[side]->empty() || cellY[side]->empty()) {
+      continue;
+    }
+    DT_THROW_IF(cellX[side]->size() > 0xFF || cellY[side]->size() > 0xFF, std::logic_error,
+                "Too many layers or rows on side " << side << " for packed cell indices !");
+    grid.nLayers = cellX[side]->size();
+    grid.nRows = cellY[side]->size();
+    grid.firstX = cellX[side]->front();
+    grid.firstY = cellY[side]->front();
+    if (grid.nLayers > 1) {
+      grid.deltaX = (cellX[side]->back() - grid.firstX) / (grid.nLayers - 1);
+    }
+    if (grid.nRows > 1) {
+      grid.deltaY = (cellY[side]->back() - grid.firstY) / (grid.nRows - 1);
+    }
+  }
+  backSideMaxX_ = sideGrids_[side_t::BACK].firstX + 0.5 * cellDiameter();
+  frontSideMinX_ = sideGrids_[side_t::FRONT].firstX - 0.5 * cellDiameter();
+}
+
 void gg_locator::construct_() {
   const geomtools::id_mgr &idManager = get_geo_manager().get_id_mgr();
 
@@ -780,54 +891,6 @@ void gg_locator::construct_() {
     cellBoxShape_ = dynamic_cast<const geomtools::box *>(&cellShape);
   }
 
-  std::vector<double> *vlx[utils::NSIDES];
-  vlx[side_t::BACK] = &backCellX_;
-  vlx[side_t::FRONT] = &frontCellX_;
-  // Loop on tracker sides:
-  for (size_t side = 0; side < utils::NSIDES; side++) {
-    if (!submodules_[side]) {
-      continue;
-    }
-    size_t i_layer = 0;
-    vlx[side]->reserve(10);
-    while (true) {
-      geomtools::geom_id cellGID(cellGIDType_, moduleNumber_, side, i_layer, 0);
-      if (!geomMapping_->validate_id(cellGID)) {
-        break;
-      }
-      const geomtools::geom_info &cellGeomInfo = geomMapping_->get_geom_info(cellGID);
-      const geomtools::placement &cellWorldPlacement = cellGeomInfo.get_world_placement();
-      geomtools::placement cellModulePlacement;
-      moduleWorldPlacement_->relocate(cellWorldPlacement, cellModulePlacement);
-      vlx[side]->push_back(cellModulePlacement.get_translation().x());
-      i_layer++;
-    }
-  }
-
-  std::vector<double> *vcy[utils::NSIDES];
-  vcy[0] = &backCellY_;
-  vcy[1] = &frontCellY_;
-  // Loop on tracker sides:
-  for (size_t side = 0; side < utils::NSIDES; side++) {
-    if (!submodules_[side]) {
-      continue;
-    }
-    size_t i_cell = 0;
-    vlx[side]->reserve(130);
-    while (true) {
-      geomtools::geom_id cellGID(cellGIDType_, moduleNumber_, side, 0, i_cell);
-      if (!geomMapping_->validate_id(cellGID)) {
-        break;
-      }
-      const geomtools::geom_info &cellGeomInfo = geomMapping_->get_geom_info(cellGID);
-      const geomtools::placement &cellWorldPlacement = cellGeomInfo.get_world_placement();
-      geomtools::placement cellModulePlacement;
-      moduleWorldPlacement_->relocate(cellWorldPlacement, cellModulePlacement);
-      vcy[side]->push_back(cellModulePlacement.get_translation().y());
-      i_cell++;
-    }
-  }
-
   // analyse the geometry versioning :
   datatools::version_id geom_mgr_setup_vid;
   get_geo_manager().fetch_setup_version_id(geom_mgr_setup_vid);
@@ -877,6 +940,54 @@ void gg_locator::construct_() {
     fieldWireLength_ = field_wire_cylinder.get_z();
     fieldWireDiameter_ = field_wire_cylinder.get_diameter();
   }
+
+  std::vector<double> *vlx[utils::NSIDES];
+  vlx[side_t::BACK] = &backCellX_;
+  vlx[side_t::FRONT] = &frontCellX_;
+  // Loop on tracker sides:
+  for (size_t side = 0; side < utils::NSIDES; side++) {
+    if (!submodules_[side]) {
+      continue;
+    }
+    size_t i_layer = 0;
+    vlx[side]->reserve(10);
+    while (true) {
+      geomtools::geom_id cellGID(cellGIDType_, moduleNumber_, side, i_layer, 0);
+      if (!geomMapping_->validate_id(cellGID)) {
+        break;
+      }
+      const geomtools::geom_info &cellGeomInfo = geomMapping_->get_geom_info(cellGID);
+      const geomtools::placement &cellWorldPlacement = cellGeomInfo.get_world_placement();
+      geomtools::placement cellModulePlacement;
+      moduleWorldPlacement_->relocate(cellWorldPlacement, cellModulePlacement);
+      vlx[side]->push_back(cellModulePlacement.get_translation().x());
+      i_layer++;
+    }
+  }
+
+  std::vector<double> *vcy[utils::NSIDES];
+  vcy[0] = &backCellY_;
+  vcy[1] = &frontCellY_;
+  // Loop on tracker sides:
+  for (size_t side = 0; side < utils::NSIDES; side++) {
+    if (!submodules_[side]) {
+      continue;
+    }
+    size_t i_cell = 0;
+    vlx[side]->reserve(130);
+    while (true) {
+      geomtools::geom_id cellGID(cellGIDType_, moduleNumber_, side, 0, i_cell);
+      if (!geomMapping_->validate_id(cellGID)) {
+        break;
+      }
+      const geomtools::geom_info &cellGeomInfo = geomMapping_->get_geom_info(cellGID);
+      const geomtools::placement &cellWorldPlacement = cellGeomInfo.get_world_placement();
+      geomtools::placement cellModulePlacement;
+      moduleWorldPlacement_->relocate(cellWorldPlacement, cellModulePlacement);
+      vcy[side]->push_back(cellModulePlacement.get_translation().y());
+      i_cell++;
+    }
+  }
 }
 
 }  // namespace geometry
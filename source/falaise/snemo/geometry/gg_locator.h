@@ -57,6 +57,8 @@ namespace snemo {
 
 namespace geometry {
 
+class geom_info_table;
+
 /// \brief Fast locator class for SuperNEMO drift chamber volumes
 class gg_locator
   : public geomtools::base_locator, public datatools::i_tree_dumpable
@@ -91,6 +93,11 @@ class gg_locator
    */
   void setModuleNumber(uint32_t number);
 
+  /**! Resolve the geometry IDs of the cells through a dense table rather than
+   *   through the geometry mapping (the table must outlive the locator).
+   */
+  void setGeomInfoTable(const geom_info_table* table);
+
   /**! @return true if the submodule at given side is present
    */
   bool hasSubmodules(uint32_t side) const;
@@ -244,6 +251,32 @@ class gg_locator
   bool findCellGID(const geomtools::vector_3d& worldPoint, geomtools::geom_id& gid,
                    double tolerance = GEOMTOOLS_PROPER_TOLERANCE) const;
 
+  /// Packed cell index of an invalid or unlocated cell
+  static const uint32_t INVALID_CELL_INDEX = 0xFFFFFFFF;
+
+  /** @return the packed index of the cell at specific side, layer and row:
+   *  (side << 16) | (layer << 8) | row
+   */
+  static uint32_t packCellIndex(uint32_t side, uint32_t layer, uint32_t row);
+
+  /** Given a packed cell index, return the geometry ID of the cell in this module
+   *  (invalid for INVALID_CELL_INDEX).
+   */
+  geomtools::geom_id cellGIDFromIndex(uint32_t cellIndex) const;
+
+  /** Locate an array of world coordinate system positions, given as separate
+   *  arrays of coordinates, in the drift cells of the module.
+   *  cellIndices[i] receives the packed index of the cell containing the i-th
+   *  position, or INVALID_CELL_INDEX. The world to module transformation and the
+   *  cell grids are precomputed at initialization, and the cell containment is
+   *  checked against the cell box shape rather than through the geometry mapping,
+   *  so that the loop has no branch nor lookup per position.
+   *  @return the number of located positions.
+   */
+  size_t findCellIndices(size_t count, const double* x, const double* y, const double* z,
+                         uint32_t* cellIndices,
+                         double tolerance = GEOMTOOLS_PROPER_TOLERANCE) const;
+
   // Interfaces from geomtools::i_locator :
   // Not clear that we ever use this class through the i_locator/base_locator
   // interface, so utility vague at the moment
@@ -263,7 +296,24 @@ class gg_locator
   void construct_();
 
  private:
+  /// Precompute the world to module transformation and cell grids used by findCellIndices
+  void buildBatchTables_();
+
+  /// Cell grid of one side of the tracker, in the module coordinate system
+  ///
+  /// The cell positions themselves stay in the back/front cell tables of the
+  /// locator, so that copies of the locator never refer to another one.
+  struct side_grid {
+    double firstX = 0.0;   ///< X-position of the first layer
+    double deltaX = 1.0;   ///< Distance between two layers
+    double firstY = 0.0;   ///< Y-position of the first row
+    double deltaY = 1.0;   ///< Distance between two rows
+    int nLayers = 0;       ///< Number of layers (0 if the side is missing)
+    int nRows = 0;         ///< Number of rows (0 if the side is missing)
+  };
+
   bool isInitialized_ = false;
+  const geom_info_table* geomInfoTable_ = nullptr;
 
   uint32_t moduleNumber_;
 
@@ -289,6 +339,12 @@ class gg_locator
 
   // Submodules are present :
   bool submodules_[2];
+
+  // Batch location tables :
+  double worldToModule_[12];  ///< Rows of the affine world to module transformation
+  side_grid sideGrids_[2];
+  double backSideMaxX_;   ///< Points with lower X are in the back side
+  double frontSideMinX_;  ///< Points with greater X are in the front side
 };
 
 }  // end of namespace geometry
@@ -22,10 +22,12 @@
 
 // Ourselves:
 #include <falaise/snemo/geometry/gveto_locator.h>
+#include <falaise/snemo/geometry/geom_info_table.h>
 
 #include "private/categories.h"
 
 // Standard library:
+#include <array>
 #include <stdexcept>
 
 // Third party
@@ -65,6 +67,7 @@ void gveto_locator::initialize(const datatools::properties &ps) {
   DT_THROW_IF(moduleNumber_ == geomtools::geom_id::INVALID_ADDRESS, std::logic_error,
               "Missing module number ! Use the 'setModuleNumber' method before !");
   construct_();
+  buildNeighbourTable_();
   isInitialized_ = true;
 }
 
@@ -79,6 +82,8 @@ uint32_t gveto_locator::getModuleNumber() const { return moduleNumber_; }
 
 void gveto_locator::setModuleNumber(uint32_t id) { moduleNumber_ = id; }
 
+void gveto_locator::setGeomInfoTable(const geom_info_table *table) { geomInfoTable_ = table; }
+
 double gveto_locator::blockWidth() const { return caloBlockBox_->get_x(); }
 
 double gveto_locator::blockHeight() const { return caloBlockBox_->get_y(); }
@@ -387,6 +392,25 @@ std::vector<geomtools::geom_id> gveto_locator::getNeighbourGIDs(uint32_t side_,
   return ids_;
 }
 
+geom_id_range gveto_locator::getNeighbourRange(const geomtools::geom_id &gid, uint8_t mask) const {
+  DT_THROW_IF(gid.get_depth() != 4, std::out_of_range,
+              "Invalid depth(" << gid.get_depth() << " != 4)!");
+  DT_THROW_IF(
+      gid.get(moduleAddressIndex_) != moduleNumber_, std::out_of_range,
+      "Invalid module number(" << gid.get(moduleAddressIndex_) << "!=" << moduleNumber_ << ")!");
+  return getNeighbourRange(gid.get(sideAddressIndex_), gid.get(wallAddressIndex_),
+                           gid.get(columnAddressIndex_), mask);
+}
+
+geom_id_range gveto_locator::getNeighbourRange(uint32_t side, uint32_t wall, uint32_t column,
+                                               uint8_t mask) const {
+  if ((mask & grid_mask_t::SECOND) != 0) {
+    DT_LOG_NOTICE(get_logging_priority(),
+                  "Looking for second order neighbour of 'gveto' locator is not implemented !");
+  }
+  return neighbourTable_.get(blockIndex_(side, wall, column), mask);
+}
+
 double gveto_locator::getZCoordOfWall(uint32_t side, uint32_t wall) const {
   DT_THROW_IF(side >= utils::NSIDES, std::out_of_range,
               "Invalid side number(" << side << ">" << utils::NSIDES << ")!");
@@ -632,7 +656,9 @@ bool gveto_locator::find_geom_id(const geomtools::vector_3d &world_position_, in
     gid.set(columnAddressIndex_, column_number);
     if (gid.is_valid()) {
       // 2012-05-31 FM : use ginfo from mapping(see below)
-      const geomtools::geom_info *ginfo_ptr = geomMapping_->get_geom_info_ptr(gid);
+      const geomtools::geom_info *ginfo_ptr = geomInfoTable_ != nullptr
+                                                  ? geomInfoTable_->getInfo(gid)
+                                                  : geomMapping_->get_geom_info_ptr(gid);
       if (ginfo_ptr == nullptr) {
         gid.invalidate();
         return false;
@@ -752,6 +778,7 @@ void gveto_locator::tree_dump(std::ostream &out_, const std::string &title_,
 }
 
 void gveto_locator::set_defaults_() {
+  neighbourTable_.clear();
   moduleNumber_ = geomtools::geom_id::INVALID_ADDRESS;
   blockPart_ = geomtools::geom_id::INVALID_ADDRESS;
 
@@ -781,9 +808,45 @@ void gveto_locator::set_defaults_() {
     submodules_[i] = false;
   }
 
+  geomInfoTable_ = nullptr;
   isInitialized_ = false;
 }
 
+size_t gveto_locator::blockIndex_(uint32_t side, uint32_t wall, uint32_t column) const {
+  DT_THROW_IF(side >= utils::NSIDES, std::out_of_range,
+              "Invalid side number(" << side << ">= " << utils::NSIDES << ")!");
+  DT_THROW_IF(column >= numberOfColumns(side, wall), std::out_of_range,
+              "Invalid column number(" << column << ">" << numberOfColumns(side, wall) - 1
+                                       << ")!");
+  size_t index = 0;
+  for (uint32_t iside = 0; iside <= side; iside++) {
+    for (uint32_t iwall = 0; iwall < NWALLS_PER_SIDE; iwall++) {
+      if (iside == side && iwall == wall) {
+        return index + column;
+      }
+      index += numberOfColumns(iside, iwall);
+    }
+  }
+  return index;
+}
+
+void gveto_locator::buildNeighbourTable_() {
+  // Blocks in the order of their index:
+  std::vector<std::array<uint32_t, 3>> blocks;
+  for (uint32_t side = 0; side < utils::NSIDES; side++) {
+    for (uint32_t wall = 0; wall < NWALLS_PER_SIDE; wall++) {
+      for (uint32_t column = 0; column < numberOfColumns(side, wall); column++) {
+        blocks.push_back({{side, wall, column}});
+      }
+    }
+  }
+  // Second order neighbours are not implemented
+  neighbourTable_.build(blocks.size(), [this, &blocks](size_t block, uint8_t mask) {
+    return getNeighbourGIDs(blocks[block][0], blocks[block][1], blocks[block][2],
+                            mask & ~grid_mask_t::SECOND);
+  });
+}
+
 void gveto_locator::construct_() {
   geomMapping_ = &get_geo_manager().get_mapping();
   const geomtools::id_mgr &idManager = get_geo_manager().get_id_mgr();
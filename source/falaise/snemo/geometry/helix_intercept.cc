@@ -20,7 +20,10 @@
  */
 
 // Standard library
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 // Ourselves:
 #include <falaise/snemo/geometry/helix_intercept.h>
@@ -104,8 +107,259 @@ namespace snemo {
       return;
     }
  
+    void helix_intercept::set_use_analytic_solver(bool use_)
+    {
+      _use_analytic_solver_ = use_;
+      return;
+    }
+
+    bool helix_intercept::is_use_analytic_solver() const
+    {
+      return _use_analytic_solver_;
+    }
+
     bool helix_intercept::find_intercept(extrapolation_info & ei_,
                                          snemo::geometry::vertex_info::from_bit_type from_bit_)
+    {
+      if (_use_analytic_solver_) {
+        const geomtools::box * boxPtr = dynamic_cast<const geomtools::box *>(&_shape_);
+        if (boxPtr != nullptr) {
+          bool found = false;
+          if (_find_box_intercept_(*boxPtr, ei_, from_bit_, found)) {
+            return found;
+          }
+          DT_LOG_DEBUG(_verbosity_, "Analytic solver does not apply, search by stepping along the helix");
+        }
+      }
+      return _find_intercept_stepping_(ei_, from_bit_);
+    }
+
+    namespace {
+
+      /// \brief Coordinate along the helix in the frame of a box
+      ///
+      /// q(t) = a + b.cos(2.pi.t) + c.sin(2.pi.t) + d.t
+      struct helix_coordinate
+      {
+        double a;
+        double b;
+        double c;
+        double d;
+
+        double value(double t_) const
+        {
+          const double phi = 2 * M_PI * t_;
+          return a + b * std::cos(phi) + c * std::sin(phi) + d * t_;
+        }
+
+        double derivative(double t_) const
+        {
+          const double phi = 2 * M_PI * t_;
+          return 2 * M_PI * (c * std::cos(phi) - b * std::sin(phi)) + d;
+        }
+
+        /// Append the parameters in ]tmin_, tmax_[ where the derivative vanishes
+        void extrema(double tmin_, double tmax_, std::vector<double> & ts_) const
+        {
+          // q'(t) = 2.pi.A.cos(2.pi.t + alpha) + d, with A.cos(alpha) = c and A.sin(alpha) = b
+          const double amplitude = std::hypot(b, c);
+          if (2 * M_PI * amplitude <= std::abs(d)) {
+            return;
+          }
+          const double alpha = std::atan2(b, c);
+          const double beta = std::acos(-d / (2 * M_PI * amplitude));
+          for (double phase : {-alpha - beta, -alpha + beta}) {
+            // t = (phase + 2.pi.n) / 2.pi
+            const double t0 = phase / (2 * M_PI);
+            for (double n = std::ceil(tmin_ - t0); t0 + n < tmax_; n += 1.0) {
+              if (t0 + n > tmin_) {
+                ts_.push_back(t0 + n);
+              }
+            }
+          }
+          return;
+        }
+
+        /// Solve q(t) = target_ in [tlo_, thi_] where q - target_ changes sign
+        double solve(double target_, double tlo_, double thi_, double tolerance_) const
+        {
+          double flo = value(tlo_) - target_;
+          if (flo == 0.0) return tlo_;
+          // Orient the bracket so that f(tneg) < 0 < f(tpos):
+          double tneg = tlo_;
+          double tpos = thi_;
+          if (flo > 0.0) {
+            std::swap(tneg, tpos);
+          }
+          double t = 0.5 * (tlo_ + thi_);
+          for (int iter = 0; iter < 100; iter++) {
+            const double f = value(t) - target_;
+            if (f == 0.0) break;
+            if (f < 0.0) {
+              tneg = t;
+            } else {
+              tpos = t;
+            }
+            const double df = derivative(t);
+            double next = (df != 0.0) ? t - f / df : tneg;
+            const bool inside = (next - tneg) * (next - tpos) < 0.0;
+            if (not inside) {
+              // Newton step leaves the bracket, bisect:
+              next = 0.5 * (tneg + tpos);
+            }
+            const bool converged = std::abs(next - t) < tolerance_ or std::abs(tpos - tneg) < tolerance_;
+            t = next;
+            if (converged) break;
+          }
+          return t;
+        }
+      };
+
+    } // namespace
+
+    bool helix_intercept::_find_box_intercept_(const geomtools::box & box_,
+                                               extrapolation_info & ei_,
+                                               snemo::geometry::vertex_info::from_bit_type from_bit_,
+                                               bool & found_) const
+    {
+      found_ = false;
+      const double hRadius = _helix_.get_radius();
+      const double hStep   = _helix_.get_step();
+      const double speed   = std::hypot(hStep, 2 * M_PI * hRadius); // Length per unit of t
+      if (not (hRadius > 0.0) or not std::isfinite(speed)) {
+        return false;
+      }
+      double startT = _helix_.get_t2(); // default : from last
+      double sense  = +1.0;
+      if (from_bit_ == snemo::geometry::vertex_info::FROM_FIRST_BIT) {
+        startT = _helix_.get_t1();
+        sense  = -1.0; // Backward curvilinear abscissa
+      }
+      // Same search range as the stepping algorithm:
+      double maxDeltaT = _max_extrapolated_xy_length_ / (2 * M_PI * hRadius);
+      maxDeltaT = std::min(maxDeltaT, _max_niter_ * _step_ / speed);
+      const double endT = startT + sense * maxDeltaT;
+      const double tmin = std::min(startT, endT);
+      const double tmax = std::max(startT, endT);
+
+      // Helix coordinates in the frame of the box:
+      geomtools::vector_3d shapeCenter;
+      geomtools::vector_3d shapeU;
+      geomtools::vector_3d shapeV;
+      geomtools::vector_3d shapeW;
+      _shape_placement_.mother_to_child(_helix_.get_center(), shapeCenter);
+      _shape_placement_.mother_to_child_direction(geomtools::vector_3d(1.0, 0.0, 0.0), shapeU);
+      _shape_placement_.mother_to_child_direction(geomtools::vector_3d(0.0, 1.0, 0.0), shapeV);
+      _shape_placement_.mother_to_child_direction(geomtools::vector_3d(0.0, 0.0, 1.0), shapeW);
+      helix_coordinate coords[3];
+      for (int i = 0; i < 3; i++) {
+        coords[i].a = shapeCenter[i];
+        coords[i].b = hRadius * shapeU[i];
+        coords[i].c = hRadius * shapeV[i];
+        coords[i].d = hStep * shapeW[i];
+      }
+      // Check the helix parametrization on the start point:
+      geomtools::vector_3d shapeStart;
+      _shape_placement_.mother_to_child(_helix_.get_point(startT), shapeStart);
+      for (int i = 0; i < 3; i++) {
+        if (std::abs(coords[i].value(startT) - shapeStart[i]) > 1.e-3 * _precision_) {
+          DT_LOG_DEBUG(_verbosity_, "Unsupported helix parametrization");
+          return false;
+        }
+      }
+      const double halfDims[3] = {box_.get_half_x(), box_.get_half_y(), box_.get_half_z()};
+      // A start point in the skin or inside the box is left to the stepping algorithm:
+      if (std::abs(shapeStart[0]) <= halfDims[0] + _precision_ and
+          std::abs(shapeStart[1]) <= halfDims[1] + _precision_ and
+          std::abs(shapeStart[2]) <= halfDims[2] + _precision_) {
+        DT_LOG_DEBUG(_verbosity_, "Start point is not outside the box");
+        return false;
+      }
+
+      // First crossing of a face plane within the face, in the extrapolation direction:
+      const double tTolerance = 1.e-6 * _precision_ / speed;
+      double bestDeltaT = std::numeric_limits<double>::infinity();
+      std::vector<double> ts;
+      for (int axis = 0; axis < 3; axis++) {
+        const helix_coordinate & q = coords[axis];
+        ts.clear();
+        ts.push_back(tmin);
+        ts.push_back(tmax);
+        q.extrema(tmin, tmax, ts);
+        std::sort(ts.begin(), ts.end());
+        if (sense < 0.0) {
+          std::reverse(ts.begin(), ts.end());
+        }
+        for (double faceSign : {-1.0, +1.0}) {
+          const double target = faceSign * halfDims[axis];
+          // Monotonic ranges of the coordinate, in the extrapolation order:
+          for (size_t irange = 0; irange + 1 < ts.size(); irange++) {
+            const double t0 = ts[irange];
+            const double t1 = ts[irange + 1];
+            if (std::abs(t0 - startT) >= bestDeltaT) break;
+            const double f0 = q.value(t0) - target;
+            const double f1 = q.value(t1) - target;
+            if ((f0 > 0.0 and f1 > 0.0) or (f0 < 0.0 and f1 < 0.0)) continue;
+            const double t = q.solve(target, t0, t1, tTolerance);
+            bool onFace = true;
+            for (int other = 0; other < 3; other++) {
+              if (other == axis) continue;
+              if (std::abs(coords[other].value(t)) > halfDims[other] + _precision_) {
+                onFace = false;
+                break;
+              }
+            }
+            if (onFace) {
+              bestDeltaT = std::min(bestDeltaT, std::abs(t - startT));
+              break;
+            }
+          }
+        }
+      }
+      if (not std::isfinite(bestDeltaT)) {
+        DT_LOG_DEBUG(_verbosity_, "No analytic intercept on the box");
+        ei_.reset();
+        return true;
+      }
+
+      // Let the shape identify the face from a short chord ending on the impact:
+      const double impactT = startT + sense * bestDeltaT;
+      const double backDeltaT = std::min(bestDeltaT, _step_ / speed);
+      geomtools::vector_3d shapeImpact(coords[0].value(impactT),
+                                       coords[1].value(impactT),
+                                       coords[2].value(impactT));
+      const double chordT = impactT - sense * backDeltaT;
+      geomtools::vector_3d shapeChordStart(coords[0].value(chordT),
+                                           coords[1].value(chordT),
+                                           coords[2].value(chordT));
+      geomtools::face_intercept_info shapeFii;
+      bool success = _shape_.find_intercept(shapeChordStart,
+                                            (shapeImpact - shapeChordStart).unit(),
+                                            shapeFii,
+                                            _precision_);
+      if (not success or (shapeFii.get_impact() - shapeImpact).mag() > _precision_) {
+        DT_LOG_DEBUG(_verbosity_, "Cannot identify the face of the analytic intercept");
+        return false;
+      }
+      ei_.reset();
+      ei_.fii.set_face_id(shapeFii.get_face_id());
+      geomtools::vector_3d impact;
+      _shape_placement_.child_to_mother(shapeFii.get_impact(), impact);
+      ei_.fii.set_impact(impact);
+      ei_.extrapolated_length = bestDeltaT * speed;
+      ei_.extrapolated_xy_length = bestDeltaT * 2 * M_PI * hRadius;
+      DT_LOG_DEBUG(_verbosity_, "Analytic intercept: ");
+      if (datatools::logger::is_debug(_verbosity_)) {
+        ei_.fii.print(std::cerr, "[debug] ");
+      }
+      DT_LOG_DEBUG(_verbosity_, "  - extrapolated length    = " << ei_.extrapolated_length / CLHEP::mm << " mm");
+      DT_LOG_DEBUG(_verbosity_, "  - extrapolated XY length = " << ei_.extrapolated_xy_length / CLHEP::mm << " mm");
+      found_ = true;
+      return true;
+    }
+
+    bool helix_intercept::_find_intercept_stepping_(extrapolation_info & ei_,
+                                                    snemo::geometry::vertex_info::from_bit_type from_bit_)
     {
       ei_.reset();
       double hStep   = _helix_.get_step();
@@ -24,6 +24,12 @@
  *
  *   Algorithm to search the intercept of an helix with an arbitrary  shape
  *
+ *   Intercepts with boxes are solved face by face: in the frame of the box,
+ *   each coordinate along the helix is a + b.cos(2.pi.t) + c.sin(2.pi.t) + d.t,
+ *   which is split in monotonic ranges where the crossing of a face plane is
+ *   bracketed and solved by a safeguarded Newton method. Other shapes use the
+ *   stepping search along the helix.
+ *
  */
 
 #ifndef FALAISE_SNEMO_GEOMETRY_HELIX_INTERCEPT_H
@@ -34,6 +40,7 @@
 #include <bayeux/datatools/logger.h>
 #include <bayeux/datatools/clhep_units.h>
 #include <bayeux/datatools/bit_mask.h>
+#include <bayeux/geomtools/box.h>
 #include <bayeux/geomtools/helix_3d.h>
 #include <bayeux/geomtools/i_shape_3d.h>
 #include <bayeux/geomtools/utils.h>
@@ -68,10 +75,27 @@ namespace snemo {
 
       bool find_intercept(extrapolation_info & ei_,
                           snemo::geometry::vertex_info::from_bit_type from_bit_);
+
+      /// Set the flag to solve intercepts on supported shapes (boxes) analytically
+      void set_use_analytic_solver(bool use_);
+
+      /// Check the flag to solve intercepts on supported shapes (boxes) analytically
+      bool is_use_analytic_solver() const;
       
     private:
 
       void _init_();
+
+      /// Search the intercept by stepping along the helix
+      bool _find_intercept_stepping_(extrapolation_info & ei_,
+                                     snemo::geometry::vertex_info::from_bit_type from_bit_);
+
+      /// Search the intercept on a box by solving the helix/face equations
+      /// \return false if the solver does not apply, in which case ei_ is left unset
+      bool _find_box_intercept_(const geomtools::box & box_,
+                                extrapolation_info & ei_,
+                                snemo::geometry::vertex_info::from_bit_type from_bit_,
+                                bool & found_) const;
       
       datatools::logger::priority _verbosity_ = datatools::logger::PRIO_FATAL; ///< Verbosity
       const geomtools::helix_3d & _helix_; ///< Reference to the helix pattern
@@ -81,6 +105,7 @@ namespace snemo {
       double _precision_ = datatools::invalid_real(); ///< Precision of the vertex (criterion for convergence)
       uint16_t _max_niter_ = 100; ///< Maximum number of iterations
       double _max_extrapolated_xy_length_ = datatools::invalid_real(); ///< Maximum extrapolated length on the XY plane
+      bool _use_analytic_solver_ = true; ///< Flag to solve intercepts on boxes analytically
 
     };
 
@@ -5,15 +5,19 @@
 
 // Third party:
 // - Bayeux/datatools :
+#include <datatools/logger.h>
 #include <datatools/version_id.h>
 
 // This project:
 #include <falaise/property_set.h>
 #include <falaise/snemo/geometry/calo_locator.h>
+#include <falaise/snemo/geometry/geom_info_table.h>
 #include <falaise/snemo/geometry/gg_locator.h>
 #include <falaise/snemo/geometry/gveto_locator.h>
 #include <falaise/snemo/geometry/xcalo_locator.h>
 
+#include "private/categories.h"
+
 namespace snemo {
 
 namespace geometry {
@@ -48,6 +52,18 @@ const snemo::geometry::gveto_locator& locator_plugin::gvetoLocator() const {
   return *gvetoLocator_;
 }
 
+bool locator_plugin::hasGeomInfoTable(const std::string& category) const {
+  return geomInfoTables_.count(category) != 0;
+}
+
+const snemo::geometry::geom_info_table& locator_plugin::geomInfoTable(
+    const std::string& category) const {
+  auto found = geomInfoTables_.find(category);
+  DT_THROW_IF(found == geomInfoTables_.end(), std::logic_error,
+              "No geom_info table available for category '" << category << "'");
+  return *found->second;
+}
+
 bool locator_plugin::is_initialized() const { return isInitialized_; }
 
 int locator_plugin::initialize(const datatools::properties& config_,
@@ -55,6 +71,7 @@ int locator_plugin::initialize(const datatools::properties& config_,
                                const datatools::service_dict_type& /*services_*/) {
   reset();
   geomtools::manager::base_plugin::_basic_initialize(config_);
+  _build_geom_info_tables();
   _build_locators(config_);
   isInitialized_ = true;
   return 0;
@@ -65,10 +82,29 @@ int locator_plugin::reset() {
   caloLocator_.reset();
   xcaloLocator_.reset();
   gvetoLocator_.reset();
+  // Locators refer to the tables
+  geomInfoTables_.clear();
   isInitialized_ = false;
   return 0;
 }
 
+void locator_plugin::_build_geom_info_tables() {
+  const geomtools::id_mgr& idManager = get_geo_manager().get_id_mgr();
+  for (const char* category :
+       {detail::kDriftCellGIDCategory, detail::kCaloOMGIDCategory, detail::kCaloBlockGIDCategory,
+        detail::kXCaloOMGIDCategory, detail::kXCaloBlockGIDCategory,
+        detail::kGammaVetoOMGIDCategory, detail::kGammaVetoBlockGIDCategory}) {
+    if (!idManager.has_category_info(category)) {
+      continue;
+    }
+    uint32_t type = idManager.get_category_type(category);
+    geomInfoTables_[category].reset(new geom_info_table(get_geo_manager().get_mapping(), type));
+    DT_LOG_DEBUG(get_logging_priority(), "Dense geom_info table for category '"
+                                             << category << "' with "
+                                             << geomInfoTables_[category]->size() << " entries");
+  }
+}
+
 void locator_plugin::_build_locators(const datatools::properties& config_) {
   // NB: base_plugin supports conditions on manager setup!
   if (get_geo_manager().get_setup_label() != "snemo::demonstrator") {
@@ -87,16 +123,41 @@ void locator_plugin::_build_locators(const datatools::properties& config_) {
   auto do_gveto = ps.get<bool>("gveto.active", true);
 
   if (do_gg) {
-    geigerLocator_.reset(new gg_locator(module_number, get_geo_manager(), ps));
+    geigerLocator_.reset(new gg_locator);
+    geigerLocator_->set_geo_manager(get_geo_manager());
+    geigerLocator_->setModuleNumber(module_number);
+    if (hasGeomInfoTable(detail::kDriftCellGIDCategory)) {
+      geigerLocator_->setGeomInfoTable(&geomInfoTable(detail::kDriftCellGIDCategory));
+    }
+    geigerLocator_->initialize(config_);
   }
   if (do_calo) {
-    caloLocator_.reset(new calo_locator(module_number, get_geo_manager(), ps));
+    caloLocator_.reset(new calo_locator);
+    caloLocator_->set_geo_manager(get_geo_manager());
+    caloLocator_->setModuleNumber(module_number);
+    caloLocator_->setBlockPart(calo_locator::DEFAULT_BLOCK_PART);
+    if (hasGeomInfoTable(detail::kCaloBlockGIDCategory)) {
+      caloLocator_->setGeomInfoTable(&geomInfoTable(detail::kCaloBlockGIDCategory));
+    }
+    caloLocator_->initialize(config_);
   }
   if (do_xcalo) {
-    xcaloLocator_.reset(new xcalo_locator(module_number, get_geo_manager(), ps));
+    xcaloLocator_.reset(new xcalo_locator);
+    xcaloLocator_->set_geo_manager(get_geo_manager());
+    xcaloLocator_->setModuleNumber(module_number);
+    if (hasGeomInfoTable(detail::kXCaloBlockGIDCategory)) {
+      xcaloLocator_->setGeomInfoTable(&geomInfoTable(detail::kXCaloBlockGIDCategory));
+    }
+    xcaloLocator_->initialize(config_);
   }
   if (do_gveto) {
-    gvetoLocator_.reset(new gveto_locator(module_number, get_geo_manager(), ps));
+    gvetoLocator_.reset(new gveto_locator);
+    gvetoLocator_->set_geo_manager(get_geo_manager());
+    gvetoLocator_->setModuleNumber(module_number);
+    if (hasGeomInfoTable(detail::kGammaVetoBlockGIDCategory)) {
+      gvetoLocator_->setGeomInfoTable(&geomInfoTable(detail::kGammaVetoBlockGIDCategory));
+    }
+    gvetoLocator_->initialize(config_);
   }
 }
 
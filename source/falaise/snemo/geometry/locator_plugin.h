@@ -16,7 +16,9 @@
 #ifndef FALAISE_SNEMO_GEOMETRY_LOCATOR_PLUGIN_H
 #define FALAISE_SNEMO_GEOMETRY_LOCATOR_PLUGIN_H 1
 
+#include <map>
 #include <memory>
+#include <string>
 
 // Third party:
 // - Boost :
@@ -33,12 +35,26 @@ namespace snemo {
 
 namespace geometry {
 
+class geom_info_table;
 class gg_locator;
 class calo_locator;
 class xcalo_locator;
 class gveto_locator;
 
 /// \brief A geometry manager plugin with embedded SuperNEMO locators.
+///
+/// Configuration:
+/// \code
+/// locators.module_number : integer = 0
+/// gg.active    : boolean = true
+/// calo.active  : boolean = true
+/// xcalo.active : boolean = true
+/// gveto.active : boolean = true
+/// \endcode
+///
+/// The plugin also builds a dense geom_id to geom_info table (see geom_info_table)
+/// for each category of drift cells, optical modules and scintillator blocks,
+/// which the locators use instead of the geometry mapping on their hot paths.
 class locator_plugin : public geomtools::manager::base_plugin {
  public:
   /// Main plugin initialization method
@@ -76,16 +92,27 @@ class locator_plugin : public geomtools::manager::base_plugin {
   /// Returns a non-mutable reference to the gamma veto locator
   const snemo::geometry::gveto_locator& gvetoLocator() const;
 
+  /// Check if a dense geom_info table is available for a geometry category
+  bool hasGeomInfoTable(const std::string& category) const;
+
+  /// Returns a non-mutable reference to the dense geom_info table of a geometry category
+  const snemo::geometry::geom_info_table& geomInfoTable(const std::string& category) const;
+
  protected:
   /// Internal mapping build method
   void _build_locators(const datatools::properties& config_);
 
+  /// Build the dense geom_info tables
+  void _build_geom_info_tables();
+
  private:
   bool isInitialized_ = false;                                    //!< Initialization flag
   std::unique_ptr<snemo::geometry::gg_locator> geigerLocator_;    //!< Geiger locator
   std::unique_ptr<snemo::geometry::calo_locator> caloLocator_;    //!< Main wall locator
   std::unique_ptr<snemo::geometry::xcalo_locator> xcaloLocator_;  //!< X-wall locator
   std::unique_ptr<snemo::geometry::gveto_locator> gvetoLocator_;  //!< gamma-veto locator
+  std::map<std::string, std::unique_ptr<snemo::geometry::geom_info_table>>
+      geomInfoTables_;  //!< Dense geom_info tables per category
 
   GEOMTOOLS_PLUGIN_REGISTRATION_INTERFACE(locator_plugin)
 };
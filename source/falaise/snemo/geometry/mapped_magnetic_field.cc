@@ -24,6 +24,11 @@
 #include <falaise/snemo/geometry/mapped_magnetic_field.h>
 
 // Standard library:
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <vector>
 
 // Third party:
@@ -39,6 +44,8 @@
 #include <boost/lexical_cast.hpp>
 // - Bayeux/datatools:
 #include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/logger.h>
 #include <datatools/properties.h>
 #include <datatools/service_manager.h>
 #include <datatools/units.h>
@@ -46,6 +53,7 @@
 // - Bayeux/geomtools:
 #include <geomtools/utils.h>
 
+#include <falaise/binary_cache.h>
 #include <falaise/property_set.h>
 
 namespace {
@@ -81,16 +89,91 @@ std::istream& safe_getline(std::istream& in_, std::string& out_) {
   }
 }
 
+/// Parse a line of comma separated integers, return false on a malformed value
+bool parse_int_csv(const std::string& line_, std::vector<long>& values_) {
+  values_.clear();
+  const char* cursor = line_.c_str();
+  while (true) {
+    char* end = nullptr;
+    errno = 0;
+    long value = std::strtol(cursor, &end, 10);
+    if (end == cursor || errno != 0) {
+      return false;
+    }
+    values_.push_back(value);
+    while (*end == ' ' || *end == '\t') {
+      end++;
+    }
+    if (*end == '\0') {
+      return true;
+    }
+    if (*end != ',') {
+      return false;
+    }
+    cursor = end + 1;
+  }
+}
+
+/// \brief Header of the binary cache of a CSV map (native endianness)
+///
+/// The header is followed by the nx.ny.nz nodes of the map, each made of
+/// the three int32 components of the field.
+struct csv_map_0_cache_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t nx;
+  uint32_t ny;
+  uint32_t nz;
+  uint64_t key;
+  double origin[3];
+  double step[3];
+};
+
+static_assert(sizeof(csv_map_0_cache_header) % 8 == 0, "Misaligned B-field map cache nodes");
+
+const char kCacheMagic[8] = {'F', 'L', 'B', 'M', 'A', 'P', '0', '0'};
+const uint32_t kCacheVersion = 1;
+
+/// Source of the identifiers of the loaded maps
+std::atomic<uint64_t> map_id_counter{0};
+
+/// \brief Field components at the 8 corner nodes of a map cell
+///
+/// Corner c = ix + 2.iy + 4.iz holds (Bx, By, Bz, 0) so that the 3 components
+/// are interpolated together in one 4-lane vector.
+struct csv_map_0_cell {
+  uint64_t map_id = 0;  //!< Identifier of the map the corners come from (0: none)
+  int ix = -1;
+  int iy = -1;
+  int iz = -1;
+  alignas(32) double corners[8][4];
+};
+
 /// \brief Private working data for MM_IMPORT_CSV_MAP_0 mode
 struct csv_map_0_t {
  public:
   csv_map_0_t() = default;
-  csv_map_0_t(std::string mapfile) : map_filename{std::move(mapfile)} { load(map_filename); }
-  void load(const std::string& mapfile);
+  csv_map_0_t(std::string mapfile, const std::string& cachedir = "")
+      : map_filename{std::move(mapfile)} {
+    load(map_filename, cachedir);
+  }
+  void load(const std::string& mapfile, const std::string& cachedir);
   void reset();
   int interpolate(const geomtools::vector_3d& position, geomtools::vector_3d& magnetic_field) const;
+  /// Fetch the corner nodes of a cell
+  void fetch_cell(int ix, int iy, int iz, csv_map_0_cell& cell) const;
   int compute(const geomtools::vector_3d& position, geomtools::vector_3d& magnetic_field) const;
 
+ private:
+  /// Parse the CSV map into the owned node array
+  void load_csv_(const std::string& mfn);
+  /// Return the key identifying a CSV map file and the units used to read it
+  uint64_t cache_key_(const std::string& mfn) const;
+  /// Map the nodes from a binary cache file, return false if it is missing or stale
+  bool load_cache_(const std::string& path, uint64_t key);
+  /// Write the nodes to a binary cache file (written to a temporary file then renamed)
+  void write_cache_(const std::string& path, uint64_t key) const;
+
  public:
   // Configuration:
   std::string map_filename;
@@ -104,16 +187,19 @@ struct csv_map_0_t {
   double dx = datatools::invalid_real();
   double dy = datatools::invalid_real();
   double dz = datatools::invalid_real();
-  // Mapped B-field:
-  using vd = std::vector<int>;
-  using vvd = std::vector<vd>;
-  using vvvd = std::vector<vvd>;
-  using vvvvd = std::vector<vvvd>;
-  vvvvd bmap;
+  // Mapped B-field, node (ix, iy, iz) at nodes[3 * ((iz * ny + iy) * nx + ix)], then By, Bz:
+  const int32_t* nodes = nullptr;
+  std::vector<int32_t> node_store;         //!< Nodes parsed from the CSV map
+  std::unique_ptr<falaise::mapped_file> node_file;  //!< Nodes mapped from the binary cache
+  uint64_t id = 0;                         //!< Unique identifier of the loaded map (0: none)
 };
 
 void csv_map_0_t::reset() {
-  bmap.clear();
+  id = 0;
+  nodes = nullptr;
+  node_store.clear();
+  node_store.shrink_to_fit();
+  node_file.reset();
   nx = 0;
   ny = 0;
   nz = 0;
@@ -123,16 +209,42 @@ void csv_map_0_t::reset() {
   dz = datatools::invalid_real();
 }
 
-void csv_map_0_t::load(const std::string& mapfile) {
+void csv_map_0_t::load(const std::string& mapfile, const std::string& cachedir) {
   std::string mfn = mapfile;
   datatools::fetch_path_with_env(mfn);
   DT_THROW_IF(!boost::filesystem::exists(mfn), std::runtime_error,
               "File '" << mfn << "' does not exist!");
-  std::ifstream fin(mfn.c_str());
-  DT_THROW_IF(!fin, std::runtime_error, "Cannot open file '" << map_filename << "'!");
-
   map_filename = mapfile;
   this->reset();
+
+  std::string cachePath;
+  uint64_t key = 0;
+  if (!cachedir.empty()) {
+    key = cache_key_(mfn);
+    cachePath = falaise::cache_file_path(cachedir, "bfield", key, ".bmap");
+    if (load_cache_(cachePath, key)) {
+      id = ++map_id_counter;
+      return;
+    }
+  }
+
+  load_csv_(mfn);
+  id = ++map_id_counter;
+
+  if (!cachePath.empty()) {
+    // A missing cache must never prevent the field from being built
+    try {
+      write_cache_(cachePath, key);
+    } catch (std::exception& error) {
+      DT_LOG_WARNING(datatools::logger::PRIO_WARNING,
+                     "Cannot store B-field map cache '" << cachePath << "': " << error.what());
+    }
+  }
+}
+
+void csv_map_0_t::load_csv_(const std::string& mfn) {
+  std::ifstream fin(mfn.c_str());
+  DT_THROW_IF(!fin, std::runtime_error, "Cannot open file '" << map_filename << "'!");
   {
     // Read header line:
     std::string header_line;
@@ -157,47 +269,108 @@ void csv_map_0_t::load(const std::string& mapfile) {
   }
 
   {
-    // Read map:
-    csv_map_0_t::vvvvd& bb = bmap;
-    bb.reserve(3);
+    // Read map, one line of nx values per axis/row/plane, into interleaved nodes:
+    node_store.assign(3 * static_cast<size_t>(nx) * ny * nz, 0);
+    std::string bmap_line;
+    std::vector<long> bvalues;
+    bvalues.reserve(nx + 3);
     for (size_t ax = 0; ax < 3; ax++) {
-      {
-        csv_map_0_t::vvvd dummy;
-        bb.push_back(dummy);
-      }
-      csv_map_0_t::vvvd& bxyz = bb.back();
-      bxyz.reserve(nz);
       for (size_t iz = 0; iz < nz; iz++) {
-        {
-          csv_map_0_t::vvd dummy;
-          bxyz.push_back(dummy);
-        }
-        csv_map_0_t::vvd& bxy = bxyz.back();
-        bxy.reserve(ny);
         for (size_t iy = 0; iy < ny; iy++) {
-          std::string bmap_line;
           safe_getline(fin, bmap_line);
-          std::vector<std::string> btokens;
-          boost::split(btokens, bmap_line, boost::is_any_of(","));
-          DT_THROW_IF(btokens.size() != nx + 3, std::logic_error, "Invalid B-line format!");
-          auto axi = boost::lexical_cast<unsigned int>(btokens[0]);
-          auto iyi = boost::lexical_cast<unsigned int>(btokens[1]);
-          auto izi = boost::lexical_cast<unsigned int>(btokens[2]);
-          DT_THROW_IF(axi != ax || iyi != iy || izi != iz, std::logic_error,
-                      "Invalid B map line format!");
-          {
-            csv_map_0_t::vd dummy;
-            bxy.push_back(dummy);
-          }
-          csv_map_0_t::vd& xdata = bxy.back();
-          xdata.reserve(btokens.size() - 3);
-          for (size_t ix = 3; ix < btokens.size(); ix++) {
-            xdata.push_back(boost::lexical_cast<int>(btokens[ix]));
+          DT_THROW_IF(!parse_int_csv(bmap_line, bvalues) || bvalues.size() != nx + 3,
+                      std::logic_error, "Invalid B-line format!");
+          DT_THROW_IF(bvalues[0] != (long)ax || bvalues[1] != (long)iy || bvalues[2] != (long)iz,
+                      std::logic_error, "Invalid B map line format!");
+          int32_t* node = &node_store[3 * ((iz * ny + iy) * nx)];
+          for (size_t ix = 0; ix < nx; ix++) {
+            node[3 * ix + ax] = static_cast<int32_t>(bvalues[ix + 3]);
           }
         }
       }
     }
   }
+  nodes = node_store.data();
+}
+
+uint64_t csv_map_0_t::cache_key_(const std::string& mfn) const {
+  // Identity of the map file and reading units
+  falaise::fnv1a_hash hash;
+  hash.add_file(mfn);
+  hash.add(&length_unit, sizeof(length_unit));
+  hash.add(&kCacheVersion, sizeof(kCacheVersion));
+  return hash.value();
+}
+
+bool csv_map_0_t::load_cache_(const std::string& path, uint64_t key) {
+  std::unique_ptr<falaise::mapped_file> file(new falaise::mapped_file(path));
+  if (file->data() == nullptr || file->size() < sizeof(csv_map_0_cache_header)) {
+    return false;
+  }
+  csv_map_0_cache_header header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+      header.version != kCacheVersion || header.key != key) {
+    return false;
+  }
+  size_t count = 3 * static_cast<size_t>(header.nx) * header.ny * header.nz;
+  if (file->size() != sizeof(header) + count * sizeof(int32_t)) {
+    return false;
+  }
+  nx = header.nx;
+  ny = header.ny;
+  nz = header.nz;
+  origin.set(header.origin[0], header.origin[1], header.origin[2]);
+  dx = header.step[0];
+  dy = header.step[1];
+  dz = header.step[2];
+  // The header size is a multiple of 8, so the mapped nodes are aligned:
+  nodes = reinterpret_cast<const int32_t*>(file->data() + sizeof(header));
+  node_file = std::move(file);
+  return true;
+}
+
+void csv_map_0_t::write_cache_(const std::string& path, uint64_t key) const {
+  csv_map_0_cache_header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+  header.version = kCacheVersion;
+  header.nx = nx;
+  header.ny = ny;
+  header.nz = nz;
+  header.key = key;
+  header.origin[0] = origin.x();
+  header.origin[1] = origin.y();
+  header.origin[2] = origin.z();
+  header.step[0] = dx;
+  header.step[1] = dy;
+  header.step[2] = dz;
+  falaise::write_file_atomically(path, [this, &header](std::ostream& out) {
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(nodes),
+              3 * static_cast<size_t>(nx) * ny * nz * sizeof(int32_t));
+  });
+}
+
+void csv_map_0_t::fetch_cell(int ix, int iy, int iz, csv_map_0_cell& cell) const {
+  // Strides between neighbouring nodes along X, Y and Z:
+  const size_t sx = 3;
+  const size_t sy = 3 * static_cast<size_t>(nx);
+  const size_t sz = sy * ny;
+  const int32_t* n000 = nodes + iz * sz + iy * sy + ix * sx;
+  const size_t offsets[8] = {0,       sx,      sy,           sy + sx,
+                             sz,      sz + sx, sz + sy,      sz + sy + sx};
+  for (int corner = 0; corner < 8; corner++) {
+    const int32_t* node = n000 + offsets[corner];
+    cell.corners[corner][0] = node[0];
+    cell.corners[corner][1] = node[1];
+    cell.corners[corner][2] = node[2];
+    cell.corners[corner][3] = 0.0;
+  }
+  cell.map_id = id;
+  cell.ix = ix;
+  cell.iy = iy;
+  cell.iz = iz;
 }
 
 int csv_map_0_t::interpolate(const geomtools::vector_3d& position_,
@@ -214,28 +387,27 @@ int csv_map_0_t::interpolate(const geomtools::vector_3d& position_,
   double gx = 1.0 - fx;
   double gy = 1.0 - fy;
   double gz = 1.0 - fz;
-  const vvvvd& bb = bmap;
   if (ixl >= 0 && ixl < (int)(nx - 1) && iyl >= 0 && iyl < (int)(ny - 1) && izl >= 0 &&
       izl < (int)(nz - 1)) {
-    for (int ax = 0; ax < 3; ax++) {
-      const vvvd& b3d = bb[ax];
-      int b000 = b3d[izl][iyl][ixl];
-      int b100 = b3d[izl][iyl][ixl + 1];
-      int b010 = b3d[izl][iyl + 1][ixl];
-      int b001 = b3d[izl + 1][iyl][ixl];
-      int b110 = b3d[izl][iyl + 1][ixl + 1];
-      int b011 = b3d[izl + 1][iyl + 1][ixl];
-      int b101 = b3d[izl + 1][iyl][ixl + 1];
-      int b111 = b3d[izl + 1][iyl + 1][ixl + 1];
-      double bf00 = gx * b000 + fx * b100;
-      double bf10 = gx * b010 + fx * b110;
+    // Successive points of a track mostly fall in the same cell, whose corners
+    // are kept per thread (fields may be computed from several threads):
+    thread_local csv_map_0_cell cell;
+    if (cell.map_id != id || cell.ix != ixl || cell.iy != iyl || cell.iz != izl) {
+      fetch_cell(ixl, iyl, izl, cell);
+    }
+    const double(&b)[8][4] = cell.corners;
+    // Same operations as for each component alone, on the 4 lanes at once:
+    alignas(32) double bfff[4];
+    for (int ax = 0; ax < 4; ax++) {
+      double bf00 = gx * b[0][ax] + fx * b[1][ax];
+      double bf10 = gx * b[2][ax] + fx * b[3][ax];
       double bff0 = gy * bf00 + fy * bf10;
-      double bf01 = gx * b001 + fx * b101;
-      double bf11 = gx * b011 + fx * b111;
+      double bf01 = gx * b[4][ax] + fx * b[5][ax];
+      double bf11 = gx * b[6][ax] + fx * b[7][ax];
       double bff1 = gy * bf01 + fy * bf11;
-      double bfff = gz * bff0 + fz * bff1;
-      magnetic_field[ax] = bfff;
+      bfff[ax] = gz * bff0 + fz * bff1;
     }
+    magnetic_field.set(bfff[0], bfff[1], bfff[2]);
   } else {
     geomtools::invalidate(magnetic_field);
     return snemo::geometry::mapped_magnetic_field::STATUS_ERROR;
@@ -299,7 +471,7 @@ namespace geometry {
 
 /// \brief Private working data
 struct mapped_magnetic_field::MapImpl {
-  MapImpl(const std::string& mapfile) : map{mapfile} {};
+  MapImpl(const std::string& mapfile, const std::string& cachedir) : map{mapfile, cachedir} {};
   ~MapImpl() = default;
   csv_map_0_t map;
 };
@@ -327,6 +499,7 @@ void mapped_magnetic_field::reset() {
   _set_initialized(false);
   fieldMap_.reset();
   mapFile_.clear();
+  mapCacheDirectory_.clear();
   _set_defaults();
   this->base_electromagnetic_field::_set_defaults();
 }
@@ -353,7 +526,8 @@ void mapped_magnetic_field::initialize(const datatools::properties& config_,
 
   mapFile_ = ps.get<falaise::path>("map_file", mapFile_);
   // if (mapMode_ == map_mode_t::IMPORT_CSV_MAP_0) { // Useless as this is the only mode
-  fieldMap_.reset(new MapImpl{mapFile_});
+  mapCacheDirectory_ = ps.get<std::string>("map_cache_directory", mapCacheDirectory_);
+  fieldMap_.reset(new MapImpl{mapFile_, mapCacheDirectory_});
   //}
 
   zeroFieldOutsideMap_ = ps.get<bool>("zero_field_outside_map", zeroFieldOutsideMap_);
@@ -367,6 +541,11 @@ void mapped_magnetic_field::setMapFilename(const std::string& mfn) {
   mapFile_ = mfn;
 }
 
+void mapped_magnetic_field::setMapCacheDirectory(const std::string& dir) {
+  DT_THROW_IF(is_initialized(), std::logic_error, "Cannot change the map cache directory !");
+  mapCacheDirectory_ = dir;
+}
+
 void mapped_magnetic_field::setMapMode(map_mode_t mm) {
   DT_THROW_IF(is_initialized(), std::logic_error, "Cannot change the mapping mode!");
   mapMode_ = mm;
@@ -386,9 +565,27 @@ int mapped_magnetic_field::compute_electric_field(const geomtools::vector_3d& /*
 int mapped_magnetic_field::compute_magnetic_field(const ::geomtools::vector_3d& position_,
                                                   double /* time_ */,
                                                   ::geomtools::vector_3d& magnetic_field) const {
+  return computeField_(position_, magnetic_field);
+}
+
+size_t mapped_magnetic_field::computeMagneticFields(size_t count,
+                                                   const geomtools::vector_3d* positions,
+                                                   double /* time */,
+                                                   geomtools::vector_3d* magnetic_fields) const {
+  size_t nsuccess = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (computeField_(positions[i], magnetic_fields[i]) == STATUS_SUCCESS) {
+      nsuccess++;
+    }
+  }
+  return nsuccess;
+}
+
+int mapped_magnetic_field::computeField_(const geomtools::vector_3d& position,
+                                         geomtools::vector_3d& magnetic_field) const {
   int status = STATUS_ERROR;
   if (mapMode_ == map_mode_t::IMPORT_CSV_MAP_0) {
-    status = fieldMap_->map.compute(position_, magnetic_field);
+    status = fieldMap_->map.compute(position, magnetic_field);
     if (invertFieldAlongZ_) {
       double Bz = -magnetic_field.z();
       magnetic_field.setZ(Bz);
@@ -411,8 +608,11 @@ void mapped_magnetic_field::tree_dump(std::ostream& out, const std::string& titl
       << "Mapping mode : " << static_cast<std::underlying_type<map_mode_t>::type>(mapMode_)
       << std::endl;
 
-  out << indent << datatools::i_tree_dumpable::inherit_tag(inherit) << "Map file : '" << mapFile_
+  out << indent << datatools::i_tree_dumpable::tag << "Map file : '" << mapFile_ << "'"
       << std::endl;
+
+  out << indent << datatools::i_tree_dumpable::inherit_tag(inherit) << "Map cache directory : '"
+      << mapCacheDirectory_ << "'" << std::endl;
 }
 
 }  // end of namespace geometry
@@ -33,6 +33,7 @@
 #define FALAISE_SNEMO_GEOMETRY_MAPPED_MAGNETIC_FIELD_H
 
 // Standard library:
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -74,6 +75,15 @@ class mapped_magnetic_field : public ::emfield::base_electromagnetic_field {
   virtual int compute_magnetic_field(const geomtools::vector_3d &position, double time,
                                      geomtools::vector_3d &magnetic_field) const override;
 
+  /// Compute the magnetic field at several positions
+  ///
+  /// Same as compute_magnetic_field for each position, without the virtual dispatch.
+  /// Positions close to each other (e.g. along a track) should be given in sequence,
+  /// so that they share the cached map cell.
+  /// \return the number of positions where the field was computed
+  size_t computeMagneticFields(size_t count, const geomtools::vector_3d *positions, double time,
+                               geomtools::vector_3d *magnetic_fields) const;
+
   /// Smart print
   virtual void tree_dump(std::ostream &out = std::clog, const std::string &title = "",
                          const std::string &indent = "", bool inherit = false) const override;
@@ -81,6 +91,14 @@ class mapped_magnetic_field : public ::emfield::base_electromagnetic_field {
   /// Set the map source filename
   void setMapFilename(const std::string &);
 
+  /// Set the directory of the binary cache of the map (no cache if empty)
+  ///
+  /// The map is parsed from its source file the first time, then stored in a
+  /// binary file of this directory, keyed by the identity of the source file.
+  /// Later initializations memory-map this file instead of parsing the source,
+  /// and processes using the same map share its pages.
+  void setMapCacheDirectory(const std::string &);
+
   /// Set the mapping mode
   void setMapMode(map_mode_t mm);
 
@@ -94,9 +112,15 @@ class mapped_magnetic_field : public ::emfield::base_electromagnetic_field {
   /// Set default attributes values
   void _set_defaults();
 
+ private:
+  /// Compute the magnetic field at a position
+  int computeField_(const geomtools::vector_3d &position,
+                    geomtools::vector_3d &magnetic_field) const;
+
  private:
   map_mode_t mapMode_;        //!< Mapping mode
   std::string mapFile_;       //!< Map filename
+  std::string mapCacheDirectory_;  //!< Directory of the binary cache of the map
   bool zeroFieldOutsideMap_;  //!< Force zero field outside the interpolated map
   bool invertFieldAlongZ_;    //!< Invert the Z component of the field
 
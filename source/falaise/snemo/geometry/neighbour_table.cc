@@ -0,0 +1,39 @@
+// falaise/snemo/geometry/neighbour_table.cc
+
+// Ourselves:
+#include <falaise/snemo/geometry/neighbour_table.h>
+
+namespace snemo {
+
+namespace geometry {
+
+const unsigned int neighbour_table::NMASKS;
+
+void neighbour_table::build(size_t nblocks, const neighbours_function& neighbours) {
+  clear();
+  for (unsigned int mask = 0; mask < NMASKS; mask++) {
+    offsets_[mask].reserve(nblocks + 1);
+    offsets_[mask].push_back(0);
+    for (size_t block = 0; block < nblocks; block++) {
+      std::vector<geomtools::geom_id> blockNeighbours = neighbours(block, mask);
+      ids_[mask].insert(ids_[mask].end(), blockNeighbours.begin(), blockNeighbours.end());
+      offsets_[mask].push_back(ids_[mask].size());
+    }
+    ids_[mask].shrink_to_fit();
+  }
+}
+
+void neighbour_table::clear() {
+  for (unsigned int mask = 0; mask < NMASKS; mask++) {
+    offsets_[mask].clear();
+    ids_[mask].clear();
+  }
+}
+
+bool neighbour_table::empty() const { return offsets_[0].empty(); }
+
+size_t neighbour_table::size() const { return empty() ? 0 : offsets_[0].size() - 1; }
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
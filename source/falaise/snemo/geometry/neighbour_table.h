@@ -0,0 +1,94 @@
+/// \file falaise/snemo/geometry/neighbour_table.h
+/*
+ * Description:
+ *
+ *   Precomputed neighbour lists of the calorimeter blocks, for each
+ *   combination of the grid mask flags.
+ *
+ */
+
+#ifndef FALAISE_SNEMO_GEOMETRY_NEIGHBOUR_TABLE_H
+#define FALAISE_SNEMO_GEOMETRY_NEIGHBOUR_TABLE_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Third party:
+// - Bayeux/geomtools:
+#include <geomtools/geom_id.h>
+
+namespace snemo {
+
+namespace geometry {
+
+/// \brief Non-owning view of a contiguous array of geometry IDs
+class geom_id_range {
+ public:
+  using const_iterator = const geomtools::geom_id*;
+
+  /// Default constructor (empty range)
+  geom_id_range() = default;
+
+  /// Construct the view of [first, last)
+  geom_id_range(const geomtools::geom_id* first, const geomtools::geom_id* last)
+      : first_(first), last_(last) {}
+
+  const_iterator begin() const { return first_; }
+  const_iterator end() const { return last_; }
+  size_t size() const { return last_ - first_; }
+  bool empty() const { return first_ == last_; }
+  const geomtools::geom_id& operator[](size_t i) const { return first_[i]; }
+
+ private:
+  const geomtools::geom_id* first_ = nullptr;
+  const geomtools::geom_id* last_ = nullptr;
+};
+
+/// \brief Neighbour lists of a set of blocks, for every grid mask
+///
+/// Blocks are identified by a dense index chosen by the locator. For each of the
+/// combinations of the SIDE, DIAG and SECOND flags of grid_mask_t, the neighbour
+/// geometry IDs of all blocks are stored back to back in a single array, with an
+/// offset per block, so that a lookup returns a range without any allocation.
+class neighbour_table {
+ public:
+  /// Number of distinct grid masks (combinations of the SIDE, DIAG and SECOND flags)
+  static const unsigned int NMASKS = 8;
+
+  /// Function returning the neighbours of a block for a mask, or an empty list for
+  /// an index that is not a block
+  using neighbours_function = std::function<std::vector<geomtools::geom_id>(size_t, uint8_t)>;
+
+  /// Build the lists of blocks [0, nblocks)
+  void build(size_t nblocks, const neighbours_function& neighbours);
+
+  /// Remove all lists
+  void clear();
+
+  /// Check if the table is built
+  bool empty() const;
+
+  /// Return the number of blocks
+  size_t size() const;
+
+  /// Return the neighbours of a block for a mask (flags other than SIDE, DIAG and
+  /// SECOND are ignored)
+  geom_id_range get(size_t block, uint8_t mask) const {
+    const std::vector<uint32_t>& offsets = offsets_[mask & (NMASKS - 1)];
+    const geomtools::geom_id* ids = ids_[mask & (NMASKS - 1)].data();
+    return geom_id_range(ids + offsets[block], ids + offsets[block + 1]);
+  }
+
+ private:
+  std::vector<uint32_t> offsets_[NMASKS];        //!< First neighbour of each block, per mask
+  std::vector<geomtools::geom_id> ids_[NMASKS];  //!< Neighbours of all blocks, per mask
+};
+
+}  // end of namespace geometry
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_GEOMETRY_NEIGHBOUR_TABLE_H
@@ -20,10 +20,12 @@
 
 // Ourselves:
 #include <falaise/snemo/geometry/xcalo_locator.h>
+#include <falaise/snemo/geometry/geom_info_table.h>
 
 #include "private/categories.h"
 
 // Standard library:
+#include <array>
 #include <stdexcept>
 
 // Third party:
@@ -66,6 +68,7 @@ void xcalo_locator::initialize(const datatools::properties &config_) {
   DT_THROW_IF(moduleNumber_ == geomtools::geom_id::INVALID_ADDRESS, std::logic_error,
               "Missing module number ! Use the 'setModuleNumber' method before !");
   construct_();
+  buildNeighbourTable_();
   isInitialized_ = true;
 }
 
@@ -81,6 +84,8 @@ uint32_t xcalo_locator::getModuleNumber() const { return moduleNumber_; }
 
 void xcalo_locator::setModuleNumber(uint32_t id) { moduleNumber_ = id; }
 
+void xcalo_locator::setGeomInfoTable(const geom_info_table *table) { geomInfoTable_ = table; }
+
 double xcalo_locator::blockWidth() const { return caloBlockBox_->get_x(); }
 
 double xcalo_locator::blockHeight() const { return caloBlockBox_->get_y(); }
@@ -465,6 +470,25 @@ std::vector<geomtools::geom_id> xcalo_locator::getNeighbourGIDs(uint32_t side, u
   return ids_;
 }
 
+geom_id_range xcalo_locator::getNeighbourRange(const geomtools::geom_id &gid, uint8_t mask) const {
+  DT_THROW_IF(gid.get_depth() != 5, std::logic_error,
+              "Invalid depth (" << gid.get_depth() << " != 5)!");
+  DT_THROW_IF(
+      gid.get(moduleAddressIndex_) != moduleNumber_, std::logic_error,
+      "Invalid module number (" << gid.get(moduleAddressIndex_) << "!=" << moduleNumber_ << ")!");
+  return getNeighbourRange(gid.get(sideAddressIndex_), gid.get(wallAddressIndex_),
+                           gid.get(columnAddressIndex_), gid.get(rowAddressIndex_), mask);
+}
+
+geom_id_range xcalo_locator::getNeighbourRange(uint32_t side, uint32_t wall, uint32_t column,
+                                               uint32_t row, uint8_t mask) const {
+  if ((mask & grid_mask_t::SECOND) != 0) {
+    DT_LOG_NOTICE(get_logging_priority(),
+                  "Looking for second order neighbour of 'xcalo' locator is not implemented !");
+  }
+  return neighbourTable_.get(blockIndex_(side, wall, column, row), mask);
+}
+
 std::vector<geomtools::geom_id> xcalo_locator::getNeighbourGIDs(const geomtools::geom_id &gid,
                                                                 uint8_t mask) const {
   DT_THROW_IF(gid.get_depth() != 5, std::logic_error,
@@ -726,7 +750,9 @@ bool xcalo_locator::find_geom_id(const geomtools::vector_3d &world_position_, in
     gid.set(rowAddressIndex_, row_number);
     if (gid.is_valid()) {
       // 2012-05-31 FM : use ginfo from mapping (see below)
-      const geomtools::geom_info *ginfo_ptr = geomMapping_->get_geom_info_ptr(gid);
+      const geomtools::geom_info *ginfo_ptr = geomInfoTable_ != nullptr
+                                                  ? geomInfoTable_->getInfo(gid)
+                                                  : geomMapping_->get_geom_info_ptr(gid);
       if (ginfo_ptr == nullptr) {
         gid.invalidate();
         return false;
@@ -847,6 +873,7 @@ void xcalo_locator::tree_dump(std::ostream &out, const std::string &title,
 }
 
 void xcalo_locator::set_defaults_() {
+  neighbourTable_.clear();
   moduleNumber_ = geomtools::geom_id::INVALID_ADDRESS;
   blockPart_ = geomtools::geom_id::INVALID_ADDRESS;
 
@@ -879,9 +906,50 @@ void xcalo_locator::set_defaults_() {
     frontCaloBlock_X_[i].clear();
   }
 
+  geomInfoTable_ = nullptr;
   isInitialized_ = false;
 }
 
+size_t xcalo_locator::blockIndex_(uint32_t side, uint32_t wall, uint32_t column,
+                                  uint32_t row) const {
+  DT_THROW_IF(side >= utils::NSIDES, std::logic_error,
+              "Invalid side number (" << side << ">= " << utils::NSIDES << ")!");
+  DT_THROW_IF(column >= numberOfColumns(side, wall), std::logic_error,
+              "Invalid column number (" << column << ">" << numberOfColumns(side, wall) - 1
+                                        << ")!");
+  DT_THROW_IF(row >= numberOfRows(side, wall), std::logic_error,
+              "Invalid row number (" << row << ">" << numberOfRows(side, wall) - 1 << ")!");
+  size_t index = 0;
+  for (uint32_t iside = 0; iside <= side; iside++) {
+    for (uint32_t iwall = 0; iwall < NWALLS_PER_SIDE; iwall++) {
+      if (iside == side && iwall == wall) {
+        return index + column * numberOfRows(side, wall) + row;
+      }
+      index += numberOfColumns(iside, iwall) * numberOfRows(iside, iwall);
+    }
+  }
+  return index;
+}
+
+void xcalo_locator::buildNeighbourTable_() {
+  // Blocks in the order of their index:
+  std::vector<std::array<uint32_t, 4>> blocks;
+  for (uint32_t side = 0; side < utils::NSIDES; side++) {
+    for (uint32_t wall = 0; wall < NWALLS_PER_SIDE; wall++) {
+      for (uint32_t column = 0; column < numberOfColumns(side, wall); column++) {
+        for (uint32_t row = 0; row < numberOfRows(side, wall); row++) {
+          blocks.push_back({{side, wall, column, row}});
+        }
+      }
+    }
+  }
+  // Second order neighbours are not implemented
+  neighbourTable_.build(blocks.size(), [this, &blocks](size_t block, uint8_t mask) {
+    return getNeighbourGIDs(blocks[block][0], blocks[block][1], blocks[block][2],
+                            blocks[block][3], mask & ~grid_mask_t::SECOND);
+  });
+}
+
 void xcalo_locator::construct_() {
   geomMapping_ = &get_geo_manager().get_mapping();
   const geomtools::id_mgr &idManager = get_geo_manager().get_id_mgr();
@@ -42,6 +42,7 @@
 
 // This project:
 #include <falaise/property_set.h>
+#include <falaise/snemo/geometry/neighbour_table.h>
 #include <falaise/snemo/geometry/utils.h>
 
 /** forward declaration */
@@ -57,6 +58,9 @@ class box;
 namespace snemo {
 
 namespace geometry {
+
+class geom_info_table;
+
 /// \brief Wall identifier constants (SuperNEMO module Y axis)
 struct xcalo_wall_t {
   enum xcalo_wal_t_enum_ {
@@ -100,6 +104,11 @@ class xcalo_locator : public geomtools::base_locator, public datatools::i_tree_d
    */
   void setModuleNumber(uint32_t id);
 
+  /**! Resolve the geometry IDs of the blocks through a dense table rather than
+   *   through the geometry mapping (the table must outlive the locator).
+   */
+  void setGeomInfoTable(const geom_info_table* table);
+
   /**! @return the width of a calorimeter block.
    */
   double blockWidth() const;
@@ -171,6 +180,19 @@ class xcalo_locator : public geomtools::base_locator, public datatools::i_tree_d
   std::vector<geomtools::geom_id> getNeighbourGIDs(const geomtools::geom_id& gid,
                                                    uint8_t mask_ = grid_mask_t::FIRST) const;
 
+  /** Given a block at specific side, wall, column and row, return the range of the geometry IDs of
+   * associated neighbouring blocks, as computed by getNeighbourGIDs but from tables precomputed
+   * at initialization, without allocation. The range is valid as long as the locator.
+   */
+  geom_id_range getNeighbourRange(uint32_t side, uint32_t wall, uint32_t column, uint32_t row,
+                                  uint8_t mask = grid_mask_t::FIRST) const;
+
+  /** Given a block with a specific geometry ID, return the range of the geometry IDs of
+   * associated neighbouring blocks (see above).
+   */
+  geom_id_range getNeighbourRange(const geomtools::geom_id& gid,
+                                  uint8_t mask = grid_mask_t::FIRST) const;
+
   // ----- COORDINATE CALCULATIONS -----
   /**! @return the Y-position of a wall for specific side and wall (in module coordinate system).
    */
@@ -266,7 +288,15 @@ class xcalo_locator : public geomtools::base_locator, public datatools::i_tree_d
   bool isBlockPartitioned() const;
 
  private:
+  /// Return the index of a block in the neighbour table
+  size_t blockIndex_(uint32_t side, uint32_t wall, uint32_t column, uint32_t row) const;
+
+  /// Precompute the neighbours of all blocks
+  void buildNeighbourTable_();
+
   bool isInitialized_;
+  const geom_info_table* geomInfoTable_;
+  neighbour_table neighbourTable_;  //!< Neighbours of the blocks for every mask
 
   // Configuration parameters :
   uint32_t moduleNumber_;
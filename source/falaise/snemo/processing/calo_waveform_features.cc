@@ -0,0 +1,360 @@
+// -*- mode: c++ ; -*-
+/// \file falaise/snemo/processing/calo_waveform_features.cc
+
+// Ourselves:
+#include "calo_waveform_features.h"
+
+// Standard library:
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace snemo {
+
+  namespace processing {
+
+    namespace {
+
+      /// \brief Portable integer reductions over waveform samples
+      struct scalar_kernel
+      {
+        /// Sum of the samples in [begin, end)
+        static int64_t sum(const int16_t * p, size_t begin, size_t end)
+        {
+          int64_t total = 0;
+          for (size_t i = begin; i < end; i++) total += p[i];
+          return total;
+        }
+
+        /// Sum of the squared samples in [begin, end)
+        static int64_t sum_squares(const int16_t * p, size_t begin, size_t end)
+        {
+          int64_t total = 0;
+          for (size_t i = begin; i < end; i++) total += p[i] * p[i];
+          return total;
+        }
+
+        /// Minimum sample and its first index (INT16_MAX and 0 for an empty waveform)
+        static void first_min(const int16_t * p, size_t n, int16_t & min, size_t & index)
+        {
+          min = std::numeric_limits<int16_t>::max();
+          index = 0;
+          for (size_t i = 0; i < n; i++) {
+            if (p[i] < min) {
+              min = p[i];
+              index = i;
+            }
+          }
+        }
+
+        /// Last index in [lo, hi] of a sample >= threshold, lo-1 if none
+        static int last_at_or_above(const int16_t * p, int lo, int hi, int16_t threshold)
+        {
+          for (int i = hi; i >= lo; i--) {
+            if (p[i] >= threshold) return i;
+          }
+          return lo - 1;
+        }
+
+        /// First index in [lo, end) of a sample >= threshold, end if none
+        static int first_at_or_above(const int16_t * p, int lo, int end, int16_t threshold)
+        {
+          for (int i = lo; i < end; i++) {
+            if (p[i] >= threshold) return i;
+          }
+          return end;
+        }
+      };
+
+#if defined(__SSE2__)
+      /// Number of vectors accumulated in 32-bit lanes before they are flushed: each
+      /// lane gains at most 2*32768 per vector
+      const size_t kMaxVectorsPerFlush = 16384;
+
+      int16_t horizontal_min_epi16(__m128i m)
+      {
+        m = _mm_min_epi16(m, _mm_srli_si128(m, 8));
+        m = _mm_min_epi16(m, _mm_srli_si128(m, 4));
+        m = _mm_min_epi16(m, _mm_srli_si128(m, 2));
+        return static_cast<int16_t>(_mm_extract_epi16(m, 0));
+      }
+
+      int64_t horizontal_sum_epi32(__m128i acc)
+      {
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+        return int64_t{lanes[0]} + lanes[1] + lanes[2] + lanes[3];
+      }
+
+      /// \brief SSE2 integer reductions over waveform samples
+      struct sse2_kernel
+      {
+        static int64_t sum(const int16_t * p, size_t begin, size_t end)
+        {
+          const __m128i ones = _mm_set1_epi16(1);
+          int64_t total = 0;
+          size_t i = begin;
+          while (end - i >= 8) {
+            const size_t block_end = i + std::min((end - i) / 8, kMaxVectorsPerFlush) * 8;
+            __m128i acc = _mm_setzero_si128();
+            for (; i < block_end; i += 8) {
+              const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+              acc = _mm_add_epi32(acc, _mm_madd_epi16(v, ones));
+            }
+            total += horizontal_sum_epi32(acc);
+          }
+          return total + scalar_kernel::sum(p, i, end);
+        }
+
+        static int64_t sum_squares(const int16_t * p, size_t begin, size_t end)
+        {
+          // Pairs of squares are at most 2^31: widen them as unsigned 32-bit values
+          const __m128i zero = _mm_setzero_si128();
+          __m128i acc = _mm_setzero_si128();
+          size_t i = begin;
+          for (; end - i >= 8; i += 8) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const __m128i squares = _mm_madd_epi16(v, v);
+            acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(squares, zero));
+            acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(squares, zero));
+          }
+          alignas(16) int64_t lanes[2];
+          _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+          return lanes[0] + lanes[1] + scalar_kernel::sum_squares(p, i, end);
+        }
+
+        static void first_min(const int16_t * p, size_t n, int16_t & min, size_t & index)
+        {
+          if (n < 8) {
+            scalar_kernel::first_min(p, n, min, index);
+            return;
+          }
+          __m128i vmin = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+          size_t i = 8;
+          for (; n - i >= 8; i += 8) {
+            vmin = _mm_min_epi16(vmin, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i)));
+          }
+          min = horizontal_min_epi16(vmin);
+          for (; i < n; i++) min = std::min(min, p[i]);
+          // Locate the first occurrence of the minimum
+          const __m128i target = _mm_set1_epi16(min);
+          for (i = 0; n - i >= 8; i += 8) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(v, target));
+            if (mask != 0) {
+              index = i + __builtin_ctz(mask) / 2;
+              return;
+            }
+          }
+          for (; p[i] != min; i++) {
+          }
+          index = i;
+        }
+
+        static int last_at_or_above(const int16_t * p, int lo, int hi, int16_t threshold)
+        {
+          const __m128i vthreshold = _mm_set1_epi16(threshold);
+          int i = hi;
+          for (; i - 7 >= lo; i -= 8) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i - 7));
+            const int mask = ~_mm_movemask_epi8(_mm_cmplt_epi16(v, vthreshold)) & 0xFFFF;
+            if (mask != 0) {
+              return i - 7 + (31 - __builtin_clz(mask)) / 2;
+            }
+          }
+          return scalar_kernel::last_at_or_above(p, lo, i, threshold);
+        }
+
+        static int first_at_or_above(const int16_t * p, int lo, int end, int16_t threshold)
+        {
+          const __m128i vthreshold = _mm_set1_epi16(threshold);
+          int i = lo;
+          for (; end - i >= 8; i += 8) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            const int mask = ~_mm_movemask_epi8(_mm_cmplt_epi16(v, vthreshold)) & 0xFFFF;
+            if (mask != 0) {
+              return i + __builtin_ctz(mask) / 2;
+            }
+          }
+          return scalar_kernel::first_at_or_above(p, i, end, threshold);
+        }
+      };
+#endif  // __SSE2__
+
+#if defined(__AVX2__)
+      /// \brief AVX2 integer reductions over waveform samples
+      ///
+      /// The short baseline sums and threshold scans use the SSE2 code.
+      struct avx2_kernel : public sse2_kernel
+      {
+        static int64_t sum(const int16_t * p, size_t begin, size_t end)
+        {
+          const __m256i ones = _mm256_set1_epi16(1);
+          int64_t total = 0;
+          size_t i = begin;
+          while (end - i >= 16) {
+            const size_t block_end = i + std::min((end - i) / 16, kMaxVectorsPerFlush) * 16;
+            __m256i acc = _mm256_setzero_si256();
+            for (; i < block_end; i += 16) {
+              const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+              acc = _mm256_add_epi32(acc, _mm256_madd_epi16(v, ones));
+            }
+            total += horizontal_sum_epi32(_mm256_castsi256_si128(acc));
+            total += horizontal_sum_epi32(_mm256_extracti128_si256(acc, 1));
+          }
+          return total + sse2_kernel::sum(p, i, end);
+        }
+
+        static void first_min(const int16_t * p, size_t n, int16_t & min, size_t & index)
+        {
+          if (n < 16) {
+            sse2_kernel::first_min(p, n, min, index);
+            return;
+          }
+          __m256i vmin = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+          size_t i = 16;
+          for (; n - i >= 16; i += 16) {
+            vmin = _mm256_min_epi16(vmin,
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i)));
+          }
+          min = horizontal_min_epi16(
+            _mm_min_epi16(_mm256_castsi256_si128(vmin), _mm256_extracti128_si256(vmin, 1)));
+          for (; i < n; i++) min = std::min(min, p[i]);
+          // Locate the first occurrence of the minimum
+          const __m256i target = _mm256_set1_epi16(min);
+          for (i = 0; n - i >= 16; i += 16) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            const auto mask =
+              static_cast<unsigned int>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(v, target)));
+            if (mask != 0) {
+              index = i + __builtin_ctz(mask) / 2;
+              return;
+            }
+          }
+          for (; p[i] != min; i++) {
+          }
+          index = i;
+        }
+      };
+
+      typedef avx2_kernel best_kernel;
+      const char * const kBestKernelName = "avx2";
+#elif defined(__SSE2__)
+      typedef sse2_kernel best_kernel;
+      const char * const kBestKernelName = "sse2";
+#else
+      typedef scalar_kernel best_kernel;
+      const char * const kBestKernelName = "scalar";
+#endif
+
+      /// Measure a waveform from the integer reductions of a kernel
+      ///
+      /// The floating point expressions are the ones of the original scalar
+      /// precalibration, evaluated in the same order.
+      template <typename Kernel>
+      void measure(const int16_t * w, size_t nsamples_, const calo_waveform_config & config,
+                   calo_waveform_features & f)
+      {
+        const int nsamples = static_cast<int>(nsamples_);
+
+        // Baseline (sums of integers are exact in double precision)
+        const size_t nbaseline = std::min(static_cast<size_t>(std::max(config.baseline_nsamples, 0)), nsamples_);
+        const double baseline_sum = static_cast<double>(Kernel::sum(w, 0, nbaseline));
+        const double baseline_sum2 = static_cast<double>(Kernel::sum_squares(w, 0, nbaseline));
+        f.baseline_adc_mean = baseline_sum / config.baseline_nsamples;
+        f.baseline_adc_sigma2 = baseline_sum2 / config.baseline_nsamples - f.baseline_adc_mean * f.baseline_adc_mean;
+
+        // Amplitude
+        size_t peak_sample = 0;
+        Kernel::first_min(w, nsamples_, f.peak_adc, peak_sample);
+        f.peak_sample = static_cast<int>(peak_sample);
+        f.amplitude_adc = f.peak_adc - f.baseline_adc_mean;
+
+        // Charge
+        f.charge_sample_start = std::max(f.peak_sample - config.charge_integration_nsamples_before_peak, 0);
+        f.charge_sample_stop = std::min(f.charge_sample_start + config.charge_integration_nsamples, nsamples);
+        double charge_sum = 0;
+        if (f.charge_sample_stop > f.charge_sample_start) {
+          charge_sum = static_cast<double>(Kernel::sum(w, f.charge_sample_start, f.charge_sample_stop));
+        }
+        charge_sum -= (f.charge_sample_stop - f.charge_sample_start) * f.baseline_adc_mean;
+        f.charge_adc = charge_sum;
+
+        // Time CFD
+        f.cfd_threshold_adc = f.baseline_adc_mean + config.cfd_ratio * f.amplitude_adc;
+
+        // Samples compare as (sample >= threshold) iff (sample >= ceil(threshold))
+        bool never_above = false;
+        int16_t threshold = std::numeric_limits<int16_t>::min();
+        if (!(f.cfd_threshold_adc <= std::numeric_limits<int16_t>::max())) {
+          never_above = true;
+        } else if (f.cfd_threshold_adc > std::numeric_limits<int16_t>::min()) {
+          threshold = static_cast<int16_t>(std::ceil(f.cfd_threshold_adc));
+        }
+
+        // Look for waveform sample crossing threshold (front side of the pulse)
+        int sample_i = 0;
+        if (!never_above && f.peak_sample > 0) {
+          sample_i = std::max(Kernel::last_at_or_above(w, 1, f.peak_sample, threshold), 0);
+        }
+
+        // Interpolate with pol1 the two consecutives samples to retrieve the falling time
+        f.falling_cfd_sample = 0;
+        if (sample_i != (nsamples - 2) && sample_i + 1 < nsamples) {
+          const double sample_x1 = sample_i;
+          const double sample_x2 = sample_i + 1;
+          const double sample_y1 = w[sample_i];
+          const double sample_y2 = w[sample_i + 1];
+          const double pol1_a = (sample_y2 - sample_y1) / (sample_x2 - sample_x1);
+          const double pol1_b = sample_y1 - pol1_a * sample_x1;
+          f.falling_cfd_sample = (f.cfd_threshold_adc - pol1_b) / pol1_a;
+        }
+
+        // Look for waveform sample crossing threshold (back side of the pulse)
+        sample_i = nsamples;
+        if (!never_above) {
+          sample_i = Kernel::first_at_or_above(w, f.peak_sample, nsamples, threshold);
+        }
+
+        // Interpolate with pol1 the two consecutives samples to retrieve the rising time
+        f.rising_cfd_sample = 0;
+        if (sample_i < (nsamples - 2) && sample_i > 0) {
+          const double sample_x1 = sample_i - 1;
+          const double sample_x2 = sample_i;
+          const double sample_y1 = w[sample_i - 1];
+          const double sample_y2 = w[sample_i];
+          const double pol1_a = (sample_y2 - sample_y1) / (sample_x2 - sample_x1);
+          const double pol1_b = sample_y1 - pol1_a * sample_x1;
+          f.rising_cfd_sample = (f.cfd_threshold_adc - pol1_b) / pol1_a;
+        }
+      }
+
+    }  // namespace
+
+    void measure_calo_waveform(const int16_t * samples_, size_t nsamples_,
+                               const calo_waveform_config & config_,
+                               calo_waveform_features & features_)
+    {
+      measure<best_kernel>(samples_, nsamples_, config_, features_);
+    }
+
+    void measure_calo_waveform_scalar(const int16_t * samples_, size_t nsamples_,
+                                      const calo_waveform_config & config_,
+                                      calo_waveform_features & features_)
+    {
+      measure<scalar_kernel>(samples_, nsamples_, config_, features_);
+    }
+
+    const char * calo_waveform_kernel_name() { return kBestKernelName; }
+
+  }  // end of namespace processing
+
+}  // end of namespace snemo
+
+// end of falaise/snemo/processing/calo_waveform_features.cc
@@ -0,0 +1,77 @@
+// -*- mode: c++ ; -*-
+/// \file falaise/snemo/processing/calo_waveform_features.h
+/*
+ * Description:
+ *
+ *   Software measurement of the features of a calorimeter waveform
+ *   (baseline, peak, charge and CFD crossings), as used by the udd2pcd
+ *   module.
+ *
+ *   The integer reductions over the samples (sums, minimum search and
+ *   threshold scans) are vectorized with AVX2 or SSE2 when the target
+ *   supports them, with a portable scalar fallback. All of them are exact,
+ *   and the floating point results are computed from them in the same
+ *   order in every implementation, so that the measurements do not depend
+ *   on the instruction set.
+ *
+ */
+
+#ifndef FALAISE_SNEMO_PROCESSING_CALO_WAVEFORM_FEATURES_H
+#define FALAISE_SNEMO_PROCESSING_CALO_WAVEFORM_FEATURES_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+
+namespace snemo {
+
+  namespace processing {
+
+    /// \brief Configuration of the software measurement of calorimeter waveforms
+    struct calo_waveform_config
+    {
+      int baseline_nsamples = 16;                        //!< Number of samples of the baseline
+      int charge_integration_nsamples = 992;             //!< Number of samples of the charge window
+      int charge_integration_nsamples_before_peak = 64;  //!< Samples of the charge window before the peak
+      double cfd_ratio = 0.25;                           //!< Fraction of the amplitude for the CFD time
+    };
+
+    /// \brief Software measurement of a calorimeter waveform, in ADC and sample units
+    struct calo_waveform_features
+    {
+      double baseline_adc_mean = 0.0;      //!< Mean of the baseline samples
+      double baseline_adc_sigma2 = 0.0;    //!< Variance of the baseline samples
+      int16_t peak_adc = 0;                //!< Minimum sample value
+      int peak_sample = 0;                 //!< First sample with the minimum value
+      double amplitude_adc = 0.0;          //!< Peak value relative to the baseline
+      int charge_sample_start = 0;         //!< First sample of the charge window
+      int charge_sample_stop = 0;          //!< Past-the-end sample of the charge window
+      double charge_adc = 0.0;             //!< Sum of the charge window relative to the baseline
+      double cfd_threshold_adc = 0.0;      //!< CFD threshold
+      double falling_cfd_sample = 0.0;     //!< Interpolated CFD crossing before the peak
+      double rising_cfd_sample = 0.0;      //!< Interpolated CFD crossing after the peak
+    };
+
+    /// Measure the features of a waveform
+    ///
+    /// Uses the vectorized kernel of the target when available.
+    void measure_calo_waveform(const int16_t * samples_, size_t nsamples_,
+                               const calo_waveform_config & config_,
+                               calo_waveform_features & features_);
+
+    /// Measure the features of a waveform with the portable scalar kernel
+    void measure_calo_waveform_scalar(const int16_t * samples_, size_t nsamples_,
+                                      const calo_waveform_config & config_,
+                                      calo_waveform_features & features_);
+
+    /// Return the name of the instruction set used by measure_calo_waveform
+    /// ("avx2", "sse2" or "scalar")
+    const char * calo_waveform_kernel_name();
+
+  }  // end of namespace processing
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_PROCESSING_CALO_WAVEFORM_FEATURES_H
+
+// end of falaise/snemo/processing/calo_waveform_features.h
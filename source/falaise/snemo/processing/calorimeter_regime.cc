@@ -52,6 +52,27 @@ CalorimeterModel::CalorimeterModel(falaise::property_set const& ps)
   }
 }
 
+CalorimeterModel::CalorimeterModel(const Parameters& pars)
+    : highEnergyThreshold{pars.highEnergyThreshold},
+      lowEnergyThreshold{pars.lowEnergyThreshold},
+      energyResolution{pars.energyResolution},
+      alphaQuenching_0{pars.alphaQuenching[0]},
+      alphaQuenching_1{pars.alphaQuenching[1]},
+      alphaQuenching_2{pars.alphaQuenching[2]},
+      relaxationTime{pars.relaxationTime} {}
+
+CalorimeterModel::Parameters CalorimeterModel::getParameters() const {
+  Parameters pars;
+  pars.energyResolution = energyResolution;
+  pars.highEnergyThreshold = highEnergyThreshold;
+  pars.lowEnergyThreshold = lowEnergyThreshold;
+  pars.alphaQuenching[0] = alphaQuenching_0;
+  pars.alphaQuenching[1] = alphaQuenching_1;
+  pars.alphaQuenching[2] = alphaQuenching_2;
+  pars.relaxationTime = relaxationTime;
+  return pars;
+}
+
 double CalorimeterModel::smearEnergy(mygsl::rng& rng, const double energy) const {
   // 2015-01-08 XG: Implement a better energy calibration based on Poisson
   // statistics for the number of photons inside scintillator. This
@@ -36,9 +36,24 @@ namespace processing {
 /// optical lines
 class CalorimeterModel {
  public:
+  /// \brief Values of the parameters of a model
+  struct Parameters {
+    double energyResolution;     //!< Energy resolution (FWHM) for electrons at 1 MeV
+    double highEnergyThreshold;  //!< High energy threshold
+    double lowEnergyThreshold;   //!< Low energy threshold
+    double alphaQuenching[3];    //!< Parameters for alpha quenching
+    double relaxationTime;       //!< Scintillator relaxation time
+  };
+
   CalorimeterModel() = default;
   explicit CalorimeterModel(falaise::property_set const& ps);
 
+  /// Construct from the values of the parameters
+  explicit CalorimeterModel(const Parameters& pars);
+
+  /// Return the values of the parameters
+  Parameters getParameters() const;
+
   /// Randomize the measured energy value given the true energy
   double smearEnergy(mygsl::rng& rng, const double energy) const;
 
@@ -0,0 +1,54 @@
+/// \file falaise/snemo/processing/detail/tracker_cell_grid.h
+/*
+ * Description:
+ *
+ *   Dense numbering of the drift cells of the SuperNEMO tracker, used by the
+ *   processing modules that bucket tracker hits per cell.
+ *
+ */
+
+#ifndef FALAISE_SNEMO_PROCESSING_DETAIL_TRACKER_CELL_GRID_H
+#define FALAISE_SNEMO_PROCESSING_DETAIL_TRACKER_CELL_GRID_H 1
+
+// Standard library:
+#include <cstddef>
+#include <cstdint>
+
+namespace snemo {
+
+namespace processing {
+
+namespace detail {
+
+/// \brief Drift cells of the tracker numbered side by side, layer by layer, then row by row
+///
+/// The cells of a layer of a side are contiguous in the numbering.
+struct tracker_cell_grid {
+  // Enumerators rather than static members, so that the header needs no definitions
+  enum : uint32_t {
+    NSIDES = 2,    //!< Number of tracker sides
+    NLAYERS = 9,   //!< Number of layers per side
+    NROWS = 113    //!< Number of rows per layer
+  };
+  enum : size_t {
+    NCELLS = size_t{NSIDES} * NLAYERS * NROWS  //!< Number of drift cells
+  };
+
+  /// Check if a cell address lies in the grid
+  static bool contains(uint32_t side, uint32_t layer, uint32_t row) {
+    return side < NSIDES && layer < NLAYERS && row < NROWS;
+  }
+
+  /// Return the number of a cell, whose address must lie in the grid
+  static size_t index(uint32_t side, uint32_t layer, uint32_t row) {
+    return (static_cast<size_t>(side) * NLAYERS + layer) * NROWS + row;
+  }
+};
+
+}  // namespace detail
+
+}  // namespace processing
+
+}  // namespace snemo
+
+#endif  // FALAISE_SNEMO_PROCESSING_DETAIL_TRACKER_CELL_GRID_H
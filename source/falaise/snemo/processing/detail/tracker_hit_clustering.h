@@ -0,0 +1,226 @@
+/// \file falaise/snemo/processing/detail/tracker_hit_clustering.h
+/*
+ * Description:
+ *
+ *   Basic time/space clusterisation of the precalibrated tracker hits of
+ *   a record, as run by the udd2pcd module.
+ *
+ */
+
+#ifndef FALAISE_SNEMO_PROCESSING_DETAIL_TRACKER_HIT_CLUSTERING_H
+#define FALAISE_SNEMO_PROCESSING_DETAIL_TRACKER_HIT_CLUSTERING_H 1
+
+// Standard library:
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// This project:
+#include <falaise/snemo/processing/detail/tracker_cell_grid.h>
+
+namespace snemo {
+
+namespace processing {
+
+namespace detail {
+
+/// \brief Cell address and anode time of a tracker hit, as used by the clusterisation
+struct cluster_cell
+{
+  uint32_t side;
+  uint32_t layer;
+  uint32_t row;
+  double anode_time;
+};
+
+/// Time/space neighboring criteria of the basic clusterisation, where hit_ is
+/// compared to the earlier hit cluster_hit_
+inline bool are_neighbour_cells(const cluster_cell & cluster_hit_, const cluster_cell & hit_,
+                                double radius2_threshold_, double deltat_threshold_)
+{
+  // 1) skip if tracker hits are not on the same side
+  if (hit_.side != cluster_hit_.side)
+    return false;
+
+  // 2) compute and perform space correlation
+  const int delta_row = cluster_hit_.row - hit_.row;
+  const int delta_layer = cluster_hit_.layer - hit_.layer;
+  const float delta_radius = delta_row*delta_row + delta_layer*delta_layer;
+
+  if (delta_radius > radius2_threshold_)
+    return false;
+
+  // 3) compute and perform time correlation
+  const double delta_anode_time = cluster_hit_.anode_time - hit_.anode_time;
+
+  if (std::abs(delta_anode_time) > deltat_threshold_)
+    return false;
+
+  return true;
+}
+
+/// \brief Disjoint sets of hit indexes (union-find)
+class disjoint_sets
+{
+public:
+  explicit disjoint_sets(size_t size_) : _parents_(size_)
+  {
+    for (size_t i = 0; i < size_; i++) _parents_[i] = i;
+  }
+
+  /// Return the representative of the set of an element
+  size_t find(size_t i_)
+  {
+    while (_parents_[i_] != i_) {
+      // Path halving
+      _parents_[i_] = _parents_[_parents_[i_]];
+      i_ = _parents_[i_];
+    }
+    return i_;
+  }
+
+  /// Merge the sets of two elements, the smallest representative is kept
+  void unite(size_t i_, size_t j_)
+  {
+    i_ = find(i_);
+    j_ = find(j_);
+    if (i_ < j_) {
+      _parents_[j_] = i_;
+    } else if (j_ < i_) {
+      _parents_[i_] = j_;
+    }
+  }
+
+private:
+  std::vector<size_t> _parents_;
+};
+
+/// Group tracker hits in clusters of time/space neighbors
+///
+/// The clusters are the connected components of the neighboring relation,
+/// ordered by their first hit, each with its hits in increasing order. This
+/// is the partition, and the order of the clusters, built by adding the hits
+/// one by one and merging all the clusters in which they have a neighbor.
+///
+/// The hits are bucketed by drift cell, so that each hit is only compared to
+/// the hits of the cells within the radius threshold.
+inline std::vector<std::vector<int>> make_tracker_hit_clusters(const std::vector<cluster_cell> & cells_,
+                                                               double radius2_threshold_,
+                                                               double deltat_threshold_)
+{
+  using grid = tracker_cell_grid;
+  const size_t NCELLS = grid::NCELLS;
+  const int NLAYERS = grid::NLAYERS;
+  const int NROWS = grid::NROWS;
+  // Below this number of hits, the cell buckets cost more than they save
+  const size_t SMALL_NHITS = 32;
+  const size_t nhits = cells_.size();
+
+  disjoint_sets clusters(nhits);
+  auto link = [&](size_t ihit_, size_t jhit_) {
+    const size_t first = std::min(ihit_, jhit_);
+    const size_t second = std::max(ihit_, jhit_);
+    if (are_neighbour_cells(cells_[first], cells_[second], radius2_threshold_, deltat_threshold_)) {
+      clusters.unite(first, second);
+    }
+  };
+
+  if (nhits <= SMALL_NHITS) {
+    // Few hits: compare all pairs
+    for (size_t ihit = 1; ihit < nhits; ihit++) {
+      for (size_t jhit = 0; jhit < ihit; jhit++) {
+        link(jhit, ihit);
+      }
+    }
+  } else {
+    // Bucket the hits by cell (counting sort), hits with unexpected addresses aside
+    std::vector<size_t> cell_keys(nhits, NCELLS);
+    std::vector<int> outliers;
+    std::vector<size_t> cell_starts(NCELLS + 1, 0);
+    for (size_t ihit = 0; ihit < nhits; ihit++) {
+      const cluster_cell & cell = cells_[ihit];
+      if (grid::contains(cell.side, cell.layer, cell.row)) {
+        cell_keys[ihit] = grid::index(cell.side, cell.layer, cell.row);
+        cell_starts[cell_keys[ihit] + 1]++;
+      } else {
+        outliers.push_back(ihit);
+      }
+    }
+    for (size_t icell = 0; icell < NCELLS; icell++) {
+      cell_starts[icell + 1] += cell_starts[icell];
+    }
+    std::vector<int> cell_hits(cell_starts[NCELLS]);
+    {
+      std::vector<size_t> fill(cell_starts.begin(), cell_starts.end() - 1);
+      for (size_t ihit = 0; ihit < nhits; ihit++) {
+        if (cell_keys[ihit] < NCELLS) {
+          cell_hits[fill[cell_keys[ihit]]++] = ihit;
+        }
+      }
+    }
+
+    // Bounds of the searched cells (squared distances are small integers, so
+    // they compare exactly to the threshold)
+    int cell_reach = NROWS;
+    if (radius2_threshold_ < 0.0) {
+      cell_reach = -1;
+    } else if (radius2_threshold_ < double(NROWS) * NROWS) {
+      cell_reach = static_cast<int>(std::floor(std::sqrt(radius2_threshold_)));
+    }
+
+    for (size_t ihit = 0; ihit < nhits; ihit++) {
+      if (cell_keys[ihit] == NCELLS) {
+        continue;
+      }
+      const cluster_cell & cell = cells_[ihit];
+      const int layer_min = std::max(static_cast<int>(cell.layer) - cell_reach, 0);
+      const int layer_max = std::min(static_cast<int>(cell.layer) + cell_reach, NLAYERS - 1);
+      const int row_min = std::max(static_cast<int>(cell.row) - cell_reach, 0);
+      const int row_max = std::min(static_cast<int>(cell.row) + cell_reach, NROWS - 1);
+      for (int layer = layer_min; layer <= layer_max; layer++) {
+        // The cells of a layer are contiguous in rows
+        const size_t layer_key = grid::index(cell.side, layer, 0);
+        const size_t first = cell_starts[layer_key + row_min];
+        const size_t last = cell_starts[layer_key + row_max + 1];
+        for (size_t icandidate = first; icandidate < last; icandidate++) {
+          const size_t jhit = cell_hits[icandidate];
+          if (jhit < ihit) {
+            link(jhit, ihit);
+          }
+        }
+      }
+    }
+
+    // Hits with unexpected addresses are compared to all other hits
+    for (int outlier : outliers) {
+      for (size_t jhit = 0; jhit < nhits; jhit++) {
+        if (jhit != static_cast<size_t>(outlier)) {
+          link(outlier, jhit);
+        }
+      }
+    }
+  }
+
+  // Clusters in the order of their first hit
+  std::vector<std::vector<int>> hit_clusters;
+  std::vector<int> cluster_indexes(nhits, -1);
+  for (size_t ihit = 0; ihit < nhits; ihit++) {
+    const size_t root = clusters.find(ihit);
+    if (cluster_indexes[root] < 0) {
+      cluster_indexes[root] = hit_clusters.size();
+      hit_clusters.emplace_back();
+    }
+    hit_clusters[cluster_indexes[root]].push_back(ihit);
+  }
+  return hit_clusters;
+}
+
+}  // namespace detail
+
+}  // namespace processing
+
+}  // namespace snemo
+
+#endif  // FALAISE_SNEMO_PROCESSING_DETAIL_TRACKER_HIT_CLUSTERING_H
@@ -6,7 +6,9 @@
 #include <falaise/snemo/processing/geiger_regime.h>
 
 // Standard library:
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <sstream>
 
 // Third party:
@@ -88,20 +90,80 @@ double calculateTZero(double timeCut, double cellRadius) {
   return tZero;
 }
 
-mygsl::tabulated_function makeTimeFromRadius(double timeCut, BasicTimeToRadius timeToRadius) {
+// Also returns the radii of the points of the function
+mygsl::tabulated_function makeTimeFromRadius(double timeCut, BasicTimeToRadius timeToRadius,
+                                             std::vector<double>& radii) {
   mygsl::tabulated_function fn;
   const double timeBegin = 0.0 * CLHEP::microsecond;
   const double timeStep = 0.2 * CLHEP::microsecond;
   const double timeEnd = timeCut + 0.5 * timeStep;
 
+  radii.clear();
   for (double driftTime = timeBegin; driftTime < timeEnd; driftTime += timeStep) {
-    fn.add_point(timeToRadius(driftTime), driftTime, false);
+    const double radius = timeToRadius(driftTime);
+    fn.add_point(radius, driftTime, false);
+    radii.push_back(radius);
   }
 
   fn.lock_table("linear");
   return fn;
 }
 
+// Target errors of the lookup tables, well below the radial (~0.4 mm) and
+// anode TDC (12.5 ns) resolutions
+const double kRadiusTableTolerance = 1.0 * CLHEP::micrometer;
+const double kTimeTableTolerance = 1.0 * CLHEP::ns;
+const size_t kMinTableIntervals = 64;
+const size_t kMaxTableIntervals = 65536;
+
+// Largest deviation between a function and its interpolation on [a, b], found
+// by golden-section search: exact if the function is convex or concave on [a, b]
+template <typename Function, typename Table>
+double maxDeviation(const Function& f, const Table& table, double a, double b) {
+  auto deviation = [&](double x) { return std::abs(f(x) - table(x)); };
+  const double g = 0.5 * (std::sqrt(5.0) - 1.0);
+  double c = b - g * (b - a);
+  double d = a + g * (b - a);
+  double dc = deviation(c);
+  double dd = deviation(d);
+  for (int iter = 0; iter < 24; iter++) {
+    if (dc > dd) {
+      b = d;
+      d = c;
+      dd = dc;
+      c = b - g * (b - a);
+      dc = deviation(c);
+    } else {
+      a = c;
+      c = d;
+      dc = dd;
+      d = a + g * (b - a);
+      dd = deviation(d);
+    }
+  }
+  return std::max(dc, dd);
+}
+
+// Tabulate a function on [xMin, xMax], doubling the number of intervals until
+// the error reported by errorOf is below the tolerance
+template <typename Function, typename Table, typename Error>
+void tabulateWithin(const Function& f, double xMin, double xMax, double tolerance,
+                    const Error& errorOf, Table& table) {
+  for (size_t intervals = kMinTableIntervals;; intervals *= 2) {
+    table.xMin = xMin;
+    table.invStep = xMax > xMin ? intervals / (xMax - xMin) : 0.0;
+    const size_t nnodes = xMax > xMin ? intervals + 1 : 1;
+    table.values.resize(nnodes);
+    for (size_t i = 0; i < nnodes; i++) {
+      table.values[i] = f(i + 1 == nnodes ? xMax : xMin + i * (xMax - xMin) / intervals);
+    }
+    table.maxError = errorOf(table);
+    if (table.maxError <= tolerance || nnodes == 1 || intervals >= kMaxTableIntervals) {
+      return;
+    }
+  }
+}
+
 }  // namespace
 
 namespace snemo {
@@ -109,38 +171,13 @@ namespace snemo {
 namespace processing {
 
 geiger_regime::geiger_regime() {
-  // Default cell dimensions:
-  cellRadius_ = 44. * 0.5 * CLHEP::mm;
-  cellDiagonal_ = cellRadius_ * sqrt(2.0);
-  cellLength_ = 2900. * CLHEP::mm;
-
-  // Default TDC electronics resolution:
-  anodeTimeResolution_ = 12.5 * CLHEP::ns;
-  cathodeTimeResolution_ = 100.0 * CLHEP::ns;
-
-  // Default resolution parameters (see I.Nasteva's work):
-  // Longitudinal
-  zResolution_ = 1.0 * CLHEP::cm;
-  zResolutionSingleCathode_ = 5.0 * CLHEP::cm;
-
-  // Radial (parameterized)
-  rResolution_a_ = 0.425 * CLHEP::mm;
-  rResolution_b_ = 0.0083;  // dimensionless
-  rResolution_r0_ = 12.25 * CLHEP::mm;
-
-  coreAnodeEfficiency_ = 1.0;
-  coreCathodeEfficiency_ = 1.0;
-  plasmaSpeed_ = 5.0 * CLHEP::cm / CLHEP::microsecond;
-  plasmaSpeedError_ = 0.5 * CLHEP::cm / CLHEP::microsecond;
-
-  tCut_ = 10. * CLHEP::microsecond;
-
-  // timeToDriftCellRadius_ and the function are derived.
-  timeToDriftCellRadius_ = calculateTZero(tCut_, cellRadius_);
-  timeFromRadius_ = makeTimeFromRadius(tCut_, BasicTimeToRadius{timeToDriftCellRadius_});
+  init_defaults_();
+  // timeToDriftCellRadius_ and the functions are derived.
+  buildDriftRelations_();
 }
 
-geiger_regime::geiger_regime(const datatools::properties& dps) : geiger_regime::geiger_regime() {
+geiger_regime::geiger_regime(const datatools::properties& dps) {
+  init_defaults_();
   falaise::property_set ps{dps};
 
   // NB: these are slightly more complex than ideal, because we
@@ -207,8 +244,106 @@ geiger_regime::geiger_regime(const datatools::properties& dps) : geiger_regime::
     rResolution_r0_ = ps.get<falaise::length_t>("sigma_r_r0")();
   }
 
+  if (ps.has_key("drift_lookup_tables")) {
+    useLookupTables_ = ps.get<bool>("drift_lookup_tables");
+  }
+
+  buildDriftRelations_();
+}
+
+void geiger_regime::init_defaults_() {
+  // Default cell dimensions:
+  cellRadius_ = 44. * 0.5 * CLHEP::mm;
+  cellDiagonal_ = cellRadius_ * sqrt(2.0);
+  cellLength_ = 2900. * CLHEP::mm;
+
+  // Default TDC electronics resolution:
+  anodeTimeResolution_ = 12.5 * CLHEP::ns;
+  cathodeTimeResolution_ = 100.0 * CLHEP::ns;
+
+  // Default resolution parameters (see I.Nasteva's work):
+  // Longitudinal
+  zResolution_ = 1.0 * CLHEP::cm;
+  zResolutionSingleCathode_ = 5.0 * CLHEP::cm;
+
+  // Radial (parameterized)
+  rResolution_a_ = 0.425 * CLHEP::mm;
+  rResolution_b_ = 0.0083;  // dimensionless
+  rResolution_r0_ = 12.25 * CLHEP::mm;
+
+  coreAnodeEfficiency_ = 1.0;
+  coreCathodeEfficiency_ = 1.0;
+  plasmaSpeed_ = 5.0 * CLHEP::cm / CLHEP::microsecond;
+  plasmaSpeedError_ = 0.5 * CLHEP::cm / CLHEP::microsecond;
+
+  tCut_ = 10. * CLHEP::microsecond;
+}
+
+void geiger_regime::buildDriftRelations_() {
   timeToDriftCellRadius_ = calculateTZero(tCut_, cellRadius_);
-  timeFromRadius_ = makeTimeFromRadius(tCut_, BasicTimeToRadius(timeToDriftCellRadius_));
+  std::vector<double> radii;
+  timeFromRadius_ =
+      makeTimeFromRadius(tCut_, BasicTimeToRadius{timeToDriftCellRadius_}, radii);
+
+  sigmaRadiusAtCellRadius_ = getRadialResolution(cellRadius_);
+  maxCalibratedRadius_ = timeFromRadius_.x_max();
+  timeAtMaxCalibratedRadius_ = timeFromRadius_(maxCalibratedRadius_);
+  timeAtCellRadiusMinusSigma_ = timeFromRadius_(cellRadius_ - sigmaRadiusAtCellRadius_);
+
+  coreRadiusTable_ = lookup_table{};
+  tailRadiusTable_ = lookup_table{};
+  meanTimeTable_ = lookup_table{};
+  if (!useLookupTables_) {
+    return;
+  }
+
+  // drift time->radius: smooth on each side of the transition time
+  auto smoothError = [](const BasicTimeToRadius& f) {
+    return [f](const lookup_table& table) -> double {
+      double error = 0.0;
+      const double step = 1.0 / table.invStep;
+      for (size_t i = 0; i + 1 < table.values.size(); i++) {
+        const double a = table.xMin + i * step;
+        error = std::max(error, maxDeviation(f, table, a, a + step));
+      }
+      return error;
+    };
+  };
+  const BasicTimeToRadius coreRadius{};
+  const BasicTimeToRadius tailRadius{std::numeric_limits<double>::lowest()};
+  const double tTransition = std::min(timeToDriftCellRadius_, tCut_);
+  tabulateWithin(coreRadius, 0.0, tTransition, kRadiusTableTolerance, smoothError(coreRadius),
+                 coreRadiusTable_);
+  if (tTransition < tCut_) {
+    tabulateWithin(tailRadius, tTransition, tCut_, kRadiusTableTolerance,
+                   smoothError(tailRadius), tailRadiusTable_);
+  }
+
+  // drift radius->time: the function is linear between its points, so is the
+  // difference with the table, which is largest at one of the points
+  auto pointsError = [this, &radii](const lookup_table& table) -> double {
+    double error = 0.0;
+    for (double radius : radii) {
+      error = std::max(error, std::abs(timeFromRadius_(radius) - table(radius)));
+    }
+    return error;
+  };
+  tabulateWithin([this](double radius) { return timeFromRadius_(radius); },
+                 timeFromRadius_.x_min(), maxCalibratedRadius_, kTimeTableTolerance, pointsError,
+                 meanTimeTable_);
+}
+
+double geiger_regime::lookup_table::operator()(double x) const {
+  const double u = (x - xMin) * invStep;
+  if (!(u > 0.0)) {
+    return values.front();
+  }
+  const size_t last = values.size() - 1;
+  if (u >= last) {
+    return values.back();
+  }
+  const auto i = static_cast<size_t>(u);
+  return values[i] + (u - i) * (values[i + 1] - values[i]);
 }
 
 double geiger_regime::getCellDiameter() const { return 2.0 * cellRadius_; }
@@ -240,7 +375,7 @@ double geiger_regime::getAnodeEfficiency(double radius) const {
   }
 
   if (radius < cellDiagonal_) {
-    const double sr0 = getRadialResolution(cellRadius_);
+    const double sr0 = sigmaRadiusAtCellRadius_;
     return coreAnodeEfficiency_ * exp(-(radius - cellRadius_) / sr0);
   }
 
@@ -271,7 +406,8 @@ double geiger_regime::getRadialResolution(double r) const {
   const double a = rResolution_a_;
   const double b = rResolution_b_;
   const double r0 = rResolution_r0_;
-  const double rResolution = a * (1.0 + b * std::pow((r - r0) / CLHEP::mm, 2));
+  const double dr = (r - r0) / CLHEP::mm;
+  const double rResolution = a * (1.0 + b * dr * dr);
   return rResolution * CLHEP::mm;
 }
 
@@ -281,7 +417,7 @@ double geiger_regime::smearZ(mygsl::rng& ran_, double z_, double sigma_z_) const
 
 double geiger_regime::smearRadius(mygsl::rng& ran_, double r_) const {
   double r{datatools::invalid_real_double()};
-  double sr0 = getRadialResolution(cellRadius_);
+  double sr0 = sigmaRadiusAtCellRadius_;
   if (r_ < (cellRadius_ + 2. * sr0)) {
     const double sr = getRadialResolution(r_);
     r = ran_.gaussian(r_, sr);
@@ -308,38 +444,62 @@ void geiger_regime::calibrateRadiusFromTime(double drift_time_, double& drift_ra
   datatools::invalidate(drift_radius_);
   datatools::invalidate(sigma_drift_radius_);
   if (drift_time_ < tCut_) {
-    drift_radius_ = base_t_2_r(drift_time_);
+    drift_radius_ = getDriftRadius(drift_time_);
     sigma_drift_radius_ = getRadialResolution(drift_radius_);
   }
 }
 
+double geiger_regime::getDriftRadius(double drift_time_) const {
+  if (!useLookupTables_) {
+    return base_t_2_r(drift_time_);
+  }
+  if (drift_time_ > timeToDriftCellRadius_) {
+    return tailRadiusTable_(drift_time_);
+  }
+  return coreRadiusTable_(drift_time_);
+}
+
+double geiger_regime::getMeanDriftTime(double drift_radius_) const {
+  if (!useLookupTables_) {
+    return timeFromRadius_(drift_radius_);
+  }
+  return meanTimeTable_(drift_radius_);
+}
+
+bool geiger_regime::isUsingLookupTables() const { return useLookupTables_; }
+
+double geiger_regime::getDriftRadiusTableError() const {
+  return std::max(coreRadiusTable_.maxError, tailRadiusTable_.maxError);
+}
+
+double geiger_regime::getMeanDriftTimeTableError() const { return meanTimeTable_.maxError; }
+
 double geiger_regime::getRandomTimeGivenRadius(mygsl::rng& ran_, double drift_distance_) const {
   DT_THROW_IF(drift_distance_ < 0.0, std::range_error, "Negative drift distance !");
 
   double drift_time{datatools::invalid_real_double()};
 
   if (drift_distance_ <= cellDiagonal_) {
-    const double rcut = timeFromRadius_.x_max();
-    const double tcut = timeFromRadius_(rcut);
+    const double rcut = maxCalibratedRadius_;
+    const double tcut = timeAtMaxCalibratedRadius_;
 
     if (drift_distance_ <= rcut) {
-      double sr = getRadialResolution(drift_distance_);
-      if (drift_distance_ > cellRadius_) {
-        sr = getRadialResolution(cellRadius_);
+      double sr = sigmaRadiusAtCellRadius_;
+      if (drift_distance_ <= cellRadius_) {
+        sr = getRadialResolution(drift_distance_);
       }
       double r_min = drift_distance_ - sr;
       if (r_min < 0.0) {
         r_min = 0.0;
       }
-      const double t_min = timeFromRadius_(r_min);
-      const double t_mean = timeFromRadius_(drift_distance_);
+      const double t_min = getMeanDriftTime(r_min);
+      const double t_mean = getMeanDriftTime(drift_distance_);
       const double mean_time = t_mean;
       const double sigma_time = (t_mean - t_min);
       drift_time = ran_.gaussian(mean_time, sigma_time);
       // protect against pathological times :
       if (drift_distance_ > cellRadius_) {
-        const double sr0 = getRadialResolution(cellRadius_);
-        const double st0 = timeToDriftCellRadius_ - timeFromRadius_(cellRadius_ - sr0);
+        const double st0 = timeToDriftCellRadius_ - timeAtCellRadiusMinusSigma_;
         const double tinf = timeToDriftCellRadius_ - 2 * st0;
         if (drift_time < tinf) {
           drift_time = 2 * tinf - drift_time;
@@ -413,6 +573,17 @@ void geiger_regime::tree_dump(std::ostream& out, const std::string& title,
       << " ns" << std::endl;
   out << indent << datatools::i_tree_dumpable::tag << "r0            = " << cellRadius_ / CLHEP::mm
       << " mm" << std::endl;
+  out << indent << datatools::i_tree_dumpable::tag << "Lookup tables = " << std::boolalpha
+      << useLookupTables_ << std::endl;
+  if (useLookupTables_) {
+    out << indent << datatools::i_tree_dumpable::skip_tag << datatools::i_tree_dumpable::tag
+        << "t->r : " << coreRadiusTable_.values.size() + tailRadiusTable_.values.size()
+        << " nodes, error < " << getDriftRadiusTableError() / CLHEP::micrometer << " um"
+        << std::endl;
+    out << indent << datatools::i_tree_dumpable::skip_tag << datatools::i_tree_dumpable::last_tag
+        << "r->t : " << meanTimeTable_.values.size() << " nodes, error < "
+        << getMeanDriftTimeTableError() / CLHEP::ns << " ns" << std::endl;
+  }
   out << indent << datatools::i_tree_dumpable::inherit_tag(inherit)
       << "rdiag         = " << cellDiagonal_ / CLHEP::mm << " mm" << std::endl;
 }
@@ -683,6 +854,25 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::geiger_regime, ocd_) {
             "                                                                 \n");
   }
 
+  {
+    // Description of the 'drift_lookup_tables' configuration property :
+    datatools::configuration_property_description& cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("drift_lookup_tables")
+        .set_terse_description("Flag to evaluate the drift time/radius relations from lookup tables")
+        .set_traits(datatools::TYPE_BOOLEAN)
+        .set_long_description(
+            "The drift time->radius and radius->time relations are tabulated   \n"
+            "on uniform grids at initialization, with errors below 1 um and   \n"
+            "1 ns respectively. If false, they are evaluated from their        \n"
+            "analytic and tabulated forms for each hit.                        \n")
+        .set_default_value_boolean(true)
+        .add_example(
+            "Set the default value::                          \n"
+            "                                                 \n"
+            "  drift_lookup_tables : boolean = true           \n"
+            "                                                 \n");
+  }
+
   // Additionnal configuration hints :
   ocd_.set_configuration_hints(
       "Here is a full configuration example in the                      \n"
@@ -702,6 +892,7 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::geiger_regime, ocd_) {
       "  base_cathode_efficiency : real = 1.0                           \n"
       "  plasma_longitudinal_speed : real as velocity = 5.0 cm/us       \n"
       "  sigma_plasma_longitudinal_speed : real as velocity = 0.5 cm/us \n"
+      "  drift_lookup_tables : boolean = true                           \n"
       "                                                                 \n");
 
   ocd_.set_validation_support(true);
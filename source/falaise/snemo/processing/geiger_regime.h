@@ -22,6 +22,7 @@
 // Standard library:
 #include <iostream>
 #include <string>
+#include <vector>
 
 // Third party:
 // - Bayeux/datatools
@@ -106,14 +107,46 @@ class geiger_regime : public datatools::i_tree_dumpable {
   void calibrateRadiusFromTime(double drift_time_, double& drift_radius_,
                                double& sigma_drift_radius_) const;
 
+  /// Return the drift radius for a drift time below the time cut
+  double getDriftRadius(double drift_time_) const;
+
+  /// Return the mean drift time for a drift radius below the maximum calibrated radius
+  double getMeanDriftTime(double drift_radius_) const;
+
+  /// Check if the drift time/radius relations are evaluated from lookup tables
+  bool isUsingLookupTables() const;
+
+  /// Return the maximum error of the drift radius lookup table
+  double getDriftRadiusTableError() const;
+
+  /// Return the maximum error of the mean drift time lookup table
+  double getMeanDriftTimeTableError() const;
+
   /// Smart print
   virtual void tree_dump(std::ostream& out = std::clog, const std::string& title = "",
                          const std::string& indent = "", bool inherit = false) const;
 
  private:
+  /// \brief Function tabulated on a uniform grid and linearly interpolated
+  struct lookup_table {
+    /// Interpolate the function, clamped to the tabulated range
+    double operator()(double x) const;
+
+    double xMin = 0.0;           //!< First node
+    double invStep = 0.0;        //!< Inverse of the distance between nodes
+    std::vector<double> values;  //!< Values at nodes
+    double maxError = 0.0;       //!< Maximum deviation from the tabulated function
+  };
+
   /// Compute the drift radius from the drift time
   double base_t_2_r(double time_, int mode_ = 0) const;
 
+  /// Set the default parameters, without building the drift relations
+  void init_defaults_();
+
+  /// Build the drift time/radius relations and their lookup tables
+  void buildDriftRelations_();
+
   double cellRadius_;                         //!< Fiducial drift radius of a cell
   double cellDiagonal_;                       //!< Radius of circle containing corners of cell
   double cellLength_;                         //!< Fiducial drift length of a cell
@@ -131,6 +164,15 @@ class geiger_regime : public datatools::i_tree_dumpable {
   mygsl::tabulated_function timeFromRadius_;  //!< drift radius->time function
   double timeToDriftCellRadius_;              //!< Drift time equivalent to cell radius
   double tCut_;  //!< Cut on drift time (related, maybe identical, to threshold for delayed hits)
+
+  bool useLookupTables_ = true;         //!< Evaluate the drift relations from lookup tables
+  lookup_table coreRadiusTable_;        //!< drift time->radius up to the transition time
+  lookup_table tailRadiusTable_;        //!< drift time->radius above the transition time
+  lookup_table meanTimeTable_;          //!< drift radius->time
+  double sigmaRadiusAtCellRadius_;      //!< Radial resolution at the cell radius
+  double maxCalibratedRadius_;          //!< Largest radius of the drift radius->time function
+  double timeAtMaxCalibratedRadius_;    //!< Drift time at the largest calibrated radius
+  double timeAtCellRadiusMinusSigma_;   //!< Drift time one radial resolution inside the cell
 };
 
 }  // end of namespace processing
@@ -7,22 +7,32 @@
 #include "mock_calorimeter_s2c_module_utils.h"
 
 // Standard library:
+#include <cstring>
+#include <fstream>
 #include <sstream>
 #include <stdexcept>
 
 // Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
+
 // - Bayeux/datatools:
+#include <datatools/properties.h>
 #include <datatools/service_manager.h>
+#include <datatools/units.h>
 #include <datatools/utils.h>
 // - Bayeux/geomtools:
 #include <geomtools/geometry_service.h>
+#include <geomtools/id_mgr.h>
 #include <geomtools/manager.h>
 // - Bayeux/mctools:
 #include <mctools/simulated_data.h>
 #include <mctools/utils.h>
 
 // This project :
+#include <falaise/binary_cache.h>
 #include <falaise/snemo/datamodels/data_model.h>
+#include <falaise/snemo/datamodels/geomid_utils.h>
 #include <falaise/snemo/services/services.h>
 #include <falaise/snemo/rc/calorimeter_om_status.h>
 
@@ -30,6 +40,184 @@ namespace snemo {
 
 namespace processing {
 
+namespace {
+
+/// Geometry categories of the blocks whose regimes are indexed by OM number
+const char* const kOMBlockCategories[] = {"calorimeter_block", "xcalo_block", "gveto_block"};
+
+/// \brief Calorimeter regime database entry, as stored in the binary cache
+struct calo_regime_record {
+  uint32_t type;                        //!< Geometry ID type
+  uint32_t depth;                       //!< Geometry ID depth
+  uint32_t address[8];                  //!< Geometry ID addresses
+  CalorimeterModel::Parameters params;  //!< Regime parameters
+};
+
+/// \brief Header of the binary cache of a regime database (native endianness)
+///
+/// The header is followed by the records of the database entries.
+struct calo_regime_cache_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t count;
+  uint64_t key;
+};
+
+const char kCacheMagic[8] = {'F', 'L', 'C', 'A', 'L', 'R', 'E', 'G'};
+const uint32_t kCacheVersion = 1;
+
+geomtools::geom_id record_geom_id(const calo_regime_record& record) {
+  geomtools::geom_id gid;
+  gid.set_type(record.type);
+  for (uint32_t i = 0; i < record.depth; i++) {
+    gid.set(i, record.address[i]);
+  }
+  return gid;
+}
+
+/// Parse a regime database file
+std::vector<calo_regime_record> read_regime_database(const std::string& path,
+                                                     datatools::logger::priority logging) {
+  std::ifstream database_file_(path.c_str());
+  DT_THROW_IF(!database_file_, std::runtime_error,
+              "Cannot open calorimeter regime database '" << path << "' !");
+
+  // Remove first line (header)
+  std::string a_line_;
+  std::getline(database_file_, a_line_);
+
+  std::vector<calo_regime_record> records;
+  std::vector<std::string> stream_fields_;
+  while (std::getline(database_file_, a_line_)) {
+    if (a_line_.empty()) {
+      continue;
+    }
+
+    // Retrieve each field separated by "\t"
+    stream_fields_.clear();
+    for (size_t begin = 0;;) {
+      const size_t end = a_line_.find('\t', begin);
+      stream_fields_.push_back(a_line_.substr(begin, end - begin));
+      if (end == std::string::npos) {
+        break;
+      }
+      begin = end + 1;
+    }
+    DT_THROW_IF(stream_fields_.size() < 6, std::logic_error,
+                "Invalid calorimeter regime entry '" << a_line_ << "' !");
+
+    // field 0 : geom_id
+    DT_LOG_DEBUG(logging, "read '" << stream_fields_[0] << "'");
+    std::istringstream a_geomid_iss(stream_fields_[0]);
+    geomtools::geom_id a_geomid_;
+    a_geomid_iss >> a_geomid_;
+
+    // Make sure geom_id is syntaxically valid
+    DT_THROW_IF(!a_geomid_.is_valid(), std::logic_error,
+                "geom_id syntax of '" << a_geomid_iss.str() << "' is not valid !");
+
+    // main wall geom_id need an additional depth '*'
+    if (a_geomid_.get_type() == 1302) {
+      a_geomid_.set_any(a_geomid_.get_depth());
+    }
+
+    calo_regime_record record;
+    std::memset(&record, 0, sizeof(record));
+    DT_THROW_IF(a_geomid_.get_depth() > 8, std::logic_error,
+                "Unsupported depth of geom_id '" << a_geomid_ << "' !");
+    record.type = a_geomid_.get_type();
+    record.depth = a_geomid_.get_depth();
+    for (uint32_t i = 0; i < record.depth; i++) {
+      record.address[i] = a_geomid_.get(i);
+    }
+
+    // field1: energy resolution
+    falaise::fraction_t a_fwhm_value_{
+        datatools::units::get_value_with_unit(stream_fields_[1]) / CLHEP::perCent, "%"};
+
+    // field2/field3: high/low energy threshold
+    falaise::energy_t a_ht_value_{
+        datatools::units::get_value_with_unit(stream_fields_[2]) / CLHEP::keV, "keV"};
+    falaise::energy_t a_lt_value_{
+        datatools::units::get_value_with_unit(stream_fields_[3]) / CLHEP::keV, "keV"};
+
+    // field4: alpha quenching parameters
+    datatools::properties::data::vdouble some_alpha_quenching_pars_(3, 0.0);
+    std::istringstream alpha_quenching_iss(stream_fields_[4]);
+    for (double& par : some_alpha_quenching_pars_) {
+      alpha_quenching_iss >> par;
+    }
+
+    // field5: scintillator relaxation time
+    falaise::time_t a_sc_relax_time_{
+        datatools::units::get_value_with_unit(stream_fields_[5]) / CLHEP::ns, "ns"};
+
+    falaise::property_set a_calorimeter_regime_ps;
+    a_calorimeter_regime_ps.put("energy.resolution", a_fwhm_value_);
+    a_calorimeter_regime_ps.put("energy.high_threshold", a_ht_value_);
+    a_calorimeter_regime_ps.put("energy.low_threshold", a_lt_value_);
+    a_calorimeter_regime_ps.put("alpha_quenching_parameters", some_alpha_quenching_pars_);
+    a_calorimeter_regime_ps.put("scintillator_relaxation_time", a_sc_relax_time_);
+    record.params = CalorimeterModel{a_calorimeter_regime_ps}.getParameters();
+
+    records.push_back(record);
+  }
+  return records;
+}
+
+/// Key of the cache of a regime database: hash of the file identity
+uint64_t regime_cache_key(const std::string& path) {
+  falaise::fnv1a_hash hash;
+  hash.add_file(path);
+  hash.add(&kCacheVersion, sizeof(kCacheVersion));
+  return hash.value();
+}
+
+/// Read the records from a cache file, return false if it is missing or stale
+bool load_regime_cache(const std::string& path, uint64_t key,
+                       std::vector<calo_regime_record>& records) {
+  std::ifstream in(path.c_str(), std::ios::binary);
+  if (!in) {
+    return false;
+  }
+  calo_regime_cache_header header;
+  if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+      header.version != kCacheVersion || header.key != key) {
+    return false;
+  }
+  std::vector<calo_regime_record> cached(header.count);
+  const auto size = static_cast<std::streamsize>(cached.size() * sizeof(calo_regime_record));
+  if (!in.read(reinterpret_cast<char*>(cached.data()), size) || in.peek() != EOF) {
+    return false;
+  }
+  for (const auto& record : cached) {
+    if (record.depth > 8) {
+      return false;
+    }
+  }
+  records.swap(cached);
+  return true;
+}
+
+/// Write the records to a cache file (written to a temporary file then renamed)
+void write_regime_cache(const std::string& path, uint64_t key,
+                        const std::vector<calo_regime_record>& records) {
+  calo_regime_cache_header header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+  header.version = kCacheVersion;
+  header.count = records.size();
+  header.key = key;
+  falaise::write_file_atomically(path, [&header, &records](std::ostream& out) {
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              records.size() * sizeof(calo_regime_record));
+  });
+}
+
+}  // namespace
+
 // Registration instantiation macro :
 DPP_MODULE_REGISTRATION_IMPLEMENT(mock_calorimeter_s2c_module,
                                   "snemo::processing::mock_calorimeter_s2c_module")
@@ -57,6 +245,17 @@ void mock_calorimeter_s2c_module::initialize(const datatools::properties& ps,
   caloTypes = fps.get<std::vector<std::string>>("hit_categories", {"calo", "xcalo", "gveto"});
 
   caloModels = {};
+  omModels.clear();
+  omModelIds.clear();
+  omBlockCategories.clear();
+  const geomtools::id_mgr& idManager = geoManager->get_id_mgr();
+  for (const char* category : kOMBlockCategories) {
+    if (idManager.has_category_info(category)) {
+      const geomtools::id_mgr::category_info& info = idManager.get_category_info(category);
+      omBlockCategories.push_back({info.get_type(), static_cast<uint32_t>(info.get_depth())});
+    }
+  }
+  regimeCacheDirectory = fps.get<std::string>("calorimeter_regime_cache_directory", "");
 
   // 2022-06-13 FM : use default paths for regime and fit DB files
 
@@ -116,75 +315,61 @@ void mock_calorimeter_s2c_module::reset() { this->base_module::_set_initialized(
 
 void mock_calorimeter_s2c_module::parse_calorimeter_regime_database(const std::string & database_path_)
 {
-  std::ifstream database_file_ (database_path_.c_str());
-
-  // Remove first line (header)
-  std::string a_line_;
-  std::getline(database_file_, a_line_);
-
-  int nb_lines = 0;
-
-  while ( std::getline(database_file_, a_line_) ) {
-
-    std::stringstream a_stream (a_line_);
-
-    // Retrieve each field separated by "\t"
-    std::string a_field_;
-    std::vector<std::string> stream_fields_;
-    while ( std::getline(a_stream, a_field_, '\t') ) {
-      stream_fields_.push_back(a_field_);
+  std::vector<calo_regime_record> records;
+  std::string cachePath;
+  uint64_t key = 0;
+  if (!regimeCacheDirectory.empty() && boost::filesystem::exists(database_path_)) {
+    key = regime_cache_key(database_path_);
+    cachePath = falaise::cache_file_path(regimeCacheDirectory, "calo-regime", key, ".bin");
+    if (load_regime_cache(cachePath, key, records)) {
+      DT_LOG_NOTICE(get_logging_priority(), "loaded " << records.size() << " entries of "
+                                            << database_path_ << " from " << cachePath);
     }
+  }
 
-    // field 0 : geom_id
-    std::string a_geomid_string_ = stream_fields_[0];
-    // database_file_ >> a_geomid_string_;
-    DT_LOG_DEBUG(get_logging_priority(), "read '" << a_geomid_string_ << "'");
-
-    std::istringstream a_geomid_iss (a_geomid_string_);
-    geomtools::geom_id a_geomid_;
-    a_geomid_iss >> a_geomid_;
-
-    // Make sure geom_id is syntaxically valid
-    DT_THROW_IF(!a_geomid_.is_valid(), std::logic_error, "geom_id syntax of '" << a_geomid_iss.str() << "' is not valid !");
-
-    // main wall geom_id need an additional depth '*'
-    if (a_geomid_.get_type() == 1302)
-      a_geomid_.set_any(a_geomid_.get_depth());
-
-    // field1: energy resolution
-    falaise::fraction_t a_fwhm_value_ {datatools::units::get_value_with_unit(stream_fields_[1])/CLHEP::perCent, "%"};
-
-    // field2/field3: high/low energy threshold
-    falaise::energy_t a_ht_value_   {datatools::units::get_value_with_unit(stream_fields_[2])/CLHEP::keV, "keV"};
-    falaise::energy_t a_lt_value_   {datatools::units::get_value_with_unit(stream_fields_[3])/CLHEP::keV, "keV"};
-
-    // field4: alpha quenching parameters
-    datatools::properties::data::vdouble some_alpha_quenching_pars_;
-    std::istringstream alpha_quenching_iss (stream_fields_[4]);
-    for (int par = 0; par < 3 ; ++par) {
-      double a_alpha_quenching_par;
-      alpha_quenching_iss >> a_alpha_quenching_par;
-      some_alpha_quenching_pars_.push_back(a_alpha_quenching_par);
+  if (records.empty()) {
+    records = read_regime_database(database_path_, get_logging_priority());
+    DT_LOG_NOTICE(get_logging_priority(), "parsed " << records.size() << " entries in " <<  database_path_);
+    if (!cachePath.empty()) {
+      // A missing cache must never prevent the module from being initialized
+      try {
+        write_regime_cache(cachePath, key, records);
+      } catch (std::exception& error) {
+        DT_LOG_WARNING(get_logging_priority(), "Cannot store calorimeter regime cache '"
+                                               << cachePath << "': " << error.what());
+      }
     }
+  }
 
-    // field5: scintillator relaxation time
-    falaise::time_t a_sc_relax_time_ {datatools::units::get_value_with_unit(stream_fields_[5])/CLHEP::ns, "ns"};
-
-    falaise::property_set a_calorimeter_regime_ps;
-    a_calorimeter_regime_ps.put("energy.resolution",     a_fwhm_value_);
-    a_calorimeter_regime_ps.put("energy.high_threshold", a_ht_value_);
-    a_calorimeter_regime_ps.put("energy.low_threshold",  a_lt_value_);
-    a_calorimeter_regime_ps.put("alpha_quenching_parameters",   some_alpha_quenching_pars_);
-    a_calorimeter_regime_ps.put("scintillator_relaxation_time", a_sc_relax_time_);
-
-    // create and store this regim in the model map
-    CalorimeterModel a_calorimeter_regime_ (a_calorimeter_regime_ps);
-    caloModels[a_geomid_] = a_calorimeter_regime_;
+  // create and store each regime in the model tables
+  for (const auto& record : records) {
+    store_calorimeter_regime(record_geom_id(record), CalorimeterModel{record.params});
+  }
+}
 
-    nb_lines++;
+int mock_calorimeter_s2c_module::om_slot(const geomtools::geom_id& gid) const {
+  for (const auto& category : omBlockCategories) {
+    if (gid.get_type() == category.type) {
+      // Only IDs of whole blocks, as listed in the regime database, have their OM number
+      return gid.get_depth() == category.depth ? snemo::datamodel::om_num(gid) : -1;
+    }
   }
+  return -1;
+}
 
-  DT_LOG_NOTICE(get_logging_priority(), "parsed " << nb_lines << " entries in " <<  database_path_);
+void mock_calorimeter_s2c_module::store_calorimeter_regime(const geomtools::geom_id& gid,
+                                                           const CalorimeterModel& model) {
+  const int om = om_slot(gid);
+  if (om >= 0 && static_cast<size_t>(om) >= omModelIds.size()) {
+    omModels.resize(om + 1);
+    omModelIds.resize(om + 1);
+  }
+  if (om >= 0 && (!omModelIds[om].is_valid() || omModelIds[om] == gid)) {
+    omModelIds[om] = gid;
+    omModels[om] = model;
+    return;
+  }
+  caloModels[gid] = model;
 }
 
 std::vector<double> mock_calorimeter_s2c_module::parse_pol3d_parameters(const std::string & parameters_path)
@@ -232,8 +417,14 @@ dpp::base_module::process_status mock_calorimeter_s2c_module::process(datatools:
 
 const CalorimeterModel& mock_calorimeter_s2c_module::get_calorimeter_regime(const geomtools::geom_id & gid)
 {
-  DT_THROW_IF(caloModels.find(gid) == caloModels.end(), std::logic_error, "Missing calorimeter regime for '" << gid << "' !");
-  return caloModels.at(gid);
+  const int om = om_slot(gid);
+  if (om >= 0 && static_cast<size_t>(om) < omModelIds.size() && omModelIds[om] == gid) {
+    return omModels[om];
+  }
+  // IDs of other modules or unexpected addresses:
+  auto found = caloModels.find(gid);
+  DT_THROW_IF(found == caloModels.end(), std::logic_error, "Missing calorimeter regime for '" << gid << "' !");
+  return found->second;
 }
 
 // Here collect the 'calorimeter' raw hits from the simulation data source
@@ -684,6 +875,25 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::mock_calorimeter_s2c_module,
             "                                 \n");
   }
 
+  {
+    // Description of the 'calorimeter_regime_cache_directory' configuration property :
+    datatools::configuration_property_description& cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("calorimeter_regime_cache_directory")
+        .set_terse_description("Directory of the binary cache of the calorimeter regime database")
+        .set_traits(datatools::TYPE_STRING)
+        .set_mandatory(false)
+        .set_long_description(
+            "If set, the entries parsed from the calorimeter regime database are \n"
+            "stored in a binary file of this directory, identified by the path,  \n"
+            "size and modification time of the database, from which later jobs  \n"
+            "restore them. By default, the database is parsed at each start.    \n")
+        .add_example(
+            "Use a cache directory::                                            \n"
+            "                                                                   \n"
+            "  calorimeter_regime_cache_directory : string as path = \"/tmp/flcache\" \n"
+            "                                                                   \n");
+  }
+
   /*
   {
     // Description of the 'hit_categories' configuration property :
@@ -742,6 +952,7 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::mock_calorimeter_s2c_module,
       "  pol3d_parameters_mwall_5inch_path : string as path = \"@falaise:snemo/demonstrator/reconstruction/db/fit_parameters_10D_MW_5inch.db\" \n"
       "  pol3d_parameters_xwall_path       : string as path = \"@falaise:snemo/demonstrator/reconstruction/db/fit_parameters_10D_XW.db\" \n"
       "  pol3d_parameters_gveto_path       : string as path = \"@falaise:snemo/demonstrator/reconstruction/db/fit_parameters_10D_GV.db\" \n"
+      "  calorimeter_regime_cache_directory : string as path = \"/tmp/flcache\" \n"
       "                                                              \n");
       /*
        // Old version per OM types:
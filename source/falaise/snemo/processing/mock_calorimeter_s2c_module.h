@@ -63,6 +63,9 @@ class mock_calorimeter_s2c_module : public dpp::base_module {
   virtual void reset();
 
   /// Parse calorimeter regime database file
+  ///
+  /// If a cache directory is set, the parsed entries are restored from, or
+  /// stored to, a binary cache file identified by the database file.
   void parse_calorimeter_regime_database(const std::string & database_path_);
 
   // Parse pol3d parameters file
@@ -88,12 +91,28 @@ class mock_calorimeter_s2c_module : public dpp::base_module {
   void process_impl(const mctools::simulated_data& simdata,
                     snemo::datamodel::CalorimeterHitHdlCollection& calohits);
 
+  /// Return the OM number of a block ID with a regime in the per-OM tables, -1 if none
+  int om_slot(const geomtools::geom_id& gid) const;
+
+  /// Store the calorimeter regime of an OM
+  void store_calorimeter_regime(const geomtools::geom_id& gid, const CalorimeterModel& model);
+
+  /// \brief Geometry ID type and depth of the blocks of an OM category
+  struct om_block_category {
+    uint32_t type;   //!< Geometry ID type
+    uint32_t depth;  //!< Geometry ID depth
+  };
+
  private:
   snemo::service_handle<snemo::geometry_svc> geoManager{};  //!< The geometry manager
   mygsl::rng RNG_{};                     //!< PRN generator
   std::vector<std::string> caloTypes{};  //!< Calorimeter hit categories
   typedef std::map<geomtools::geom_id, CalorimeterModel> CaloModelMap;
-  CaloModelMap caloModels{};            //!< Calorimeter regime tools
+  std::vector<CalorimeterModel> omModels{};       //!< Calorimeter regimes indexed by OM number
+  std::vector<geomtools::geom_id> omModelIds{};   //!< Geometry ID of the regime of each OM number
+  std::vector<om_block_category> omBlockCategories{};  //!< Block categories indexed by OM number
+  CaloModelMap caloModels{};            //!< Calorimeter regimes of IDs without OM number
+  std::string regimeCacheDirectory{};   //!< Directory of the regime database cache (none if empty)
   std::string sdInputTag{};             //!< The label of the simulated data bank
   std::string cdOutputTag{};            //!< The label of the calibrated data bank
   double timeWindow{100. * CLHEP::ns};  //!< Time width of a calo cluster
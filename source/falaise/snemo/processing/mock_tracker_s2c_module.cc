@@ -6,6 +6,7 @@
 #include "mock_tracker_s2c_module.h"
 
 // Standard library:
+#include <algorithm>
 #include <sstream>
 #include <stdexcept>
 
@@ -26,6 +27,7 @@
 #include <falaise/snemo/datamodels/data_model.h>
 #include <falaise/snemo/services/services.h>
 #include "detail/mock_raw_tracker_hit.h"
+#include "detail/tracker_cell_grid.h"
 #include "falaise/property_set.h"
 #include "falaise/quantity.h"
 #include <falaise/snemo/rc/tracker_cell_status.h>
@@ -38,6 +40,70 @@ namespace processing {
 DPP_MODULE_REGISTRATION_IMPLEMENT(mock_tracker_s2c_module,
                                   "snemo::processing::mock_tracker_s2c_module")
 
+/// Raw tracker hits of the current event, with a dense table mapping each drift
+/// cell (side, layer, row) to the index of its hit. Only the slots of the cells
+/// hit during an event are reset, so the storage is reused without reallocation.
+struct mock_tracker_s2c_module::raw_hit_store {
+  using cell_grid = detail::tracker_cell_grid;
+  static const int32_t NO_HIT = -1;
+
+  raw_tracker_hit_col_t hits{};          //!< Hits in order of creation
+  std::vector<int32_t> cellHits =        //!< Index of the hit of each cell
+      std::vector<int32_t>(cell_grid::NCELLS, int32_t{NO_HIT});
+  std::vector<uint32_t> touchedCells{};  //!< Cells with a hit in the current event
+
+  /// Return the index of the cell of a drift cell GID, or -1 if it is out of the table
+  static int32_t cellIndex(const geomtools::geom_id& gid) {
+    if (gid.get_depth() < 4) {
+      return -1;
+    }
+    const uint32_t side = gid.get(1);
+    const uint32_t layer = gid.get(2);
+    const uint32_t row = gid.get(3);
+    if (!cell_grid::contains(side, layer, row)) {
+      return -1;
+    }
+    return static_cast<int32_t>(cell_grid::index(side, layer, row));
+  }
+
+  /// Return the hit with a given GID, or nullptr if none
+  snreco::detail::mock_raw_tracker_hit* find(const geomtools::geom_id& gid, int32_t cell) {
+    if (cell >= 0) {
+      const int32_t ihit = cellHits[cell];
+      if (ihit == NO_HIT) {
+        return nullptr;
+      }
+      if (hits[ihit].get_geom_id() == gid) {
+        return &hits[ihit];
+      }
+    }
+    // Not a SuperNEMO drift cell address (other module...): search all hits
+    geomtools::base_hit::has_geom_id_predicate pred_has_gid(gid);
+    auto found = std::find_if(hits.begin(), hits.end(), pred_has_gid);
+    return found == hits.end() ? nullptr : &*found;
+  }
+
+  /// Append a new hit, registered to a cell if it has none yet
+  snreco::detail::mock_raw_tracker_hit& add(int32_t cell) {
+    if (cell >= 0 && cellHits[cell] == NO_HIT) {
+      cellHits[cell] = static_cast<int32_t>(hits.size());
+      touchedCells.push_back(cell);
+    }
+    hits.emplace_back();
+    return hits.back();
+  }
+
+  void clear() {
+    for (uint32_t cell : touchedCells) {
+      cellHits[cell] = NO_HIT;
+    }
+    touchedCells.clear();
+    hits.clear();
+  }
+};
+
+mock_tracker_s2c_module::~mock_tracker_s2c_module() { this->reset(); }
+
 void mock_tracker_s2c_module::initialize(const datatools::properties& ps,
                                          datatools::service_manager& services,
                                          dpp::module_handle_dict_type& /* unused */) {
@@ -92,10 +158,15 @@ void mock_tracker_s2c_module::initialize(const datatools::properties& ps,
   // to this calibrated hit
   _store_mc_truth_track_ids_ = fps.get<bool>("store_mc_truth_track_ids", false);
 
+  rawHits_.reset(new raw_hit_store);
+
   this->base_module::_set_initialized(true);
 }
 
-void mock_tracker_s2c_module::reset() { this->base_module::_set_initialized(false); }
+void mock_tracker_s2c_module::reset() {
+  rawHits_.reset();
+  this->base_module::_set_initialized(false);
+}
 
 // Processing :
 dpp::base_module::process_status mock_tracker_s2c_module::process(datatools::things& event) {
@@ -124,10 +195,11 @@ dpp::base_module::process_status mock_tracker_s2c_module::process(datatools::thi
  * and build the final list of digitized 'tracker' hits.
  *
  */
-mock_tracker_s2c_module::raw_tracker_hit_col_t mock_tracker_s2c_module::digitizeHits_(
+const mock_tracker_s2c_module::raw_tracker_hit_col_t& mock_tracker_s2c_module::digitizeHits_(
     const sim_tracker_hit_col_t& steps) {
   // reset the output raw tracker hits collection:
-  raw_tracker_hit_col_t rawTrackerDigits{};
+  raw_hit_store& rawTrackerDigits = *rawHits_;
+  rawTrackerDigits.clear();
 
   // pickup the ID mapping from the geometry manager:
   const geomtools::mapping& the_mapping = geoManager->get_mapping();
@@ -232,12 +304,11 @@ mock_tracker_s2c_module::raw_tracker_hit_col_t mock_tracker_s2c_module::digitize
     }
 
     // find if some tracker hit already uses this geom ID:
-    geomtools::base_hit::has_geom_id_predicate pred_has_gid(gid);
-    auto found = std::find_if(rawTrackerDigits.begin(), rawTrackerDigits.end(), pred_has_gid);
-    if (found == rawTrackerDigits.end()) {
+    const int32_t cell = raw_hit_store::cellIndex(gid);
+    snreco::detail::mock_raw_tracker_hit* found = rawTrackerDigits.find(gid, cell);
+    if (found == nullptr) {
       // This geom_id is not used by any previous tracker hit: we create a new tracker hit !
-      rawTrackerDigits.emplace_back(snreco::detail::mock_raw_tracker_hit{});
-      snreco::detail::mock_raw_tracker_hit& new_raw_tracker_hit = rawTrackerDigits.back();
+      snreco::detail::mock_raw_tracker_hit& new_raw_tracker_hit = rawTrackerDigits.add(cell);
 
       // assign a hit ID and the geometry ID to the hit:
       new_raw_tracker_hit.set_hit_id(raw_tracker_hit_id);
@@ -313,7 +384,7 @@ mock_tracker_s2c_module::raw_tracker_hit_col_t mock_tracker_s2c_module::digitize
     }
   }
 
-  return rawTrackerDigits;
+  return rawTrackerDigits.hits;
 }
 
 /** Calibrate tracker hits from digitization informations:
@@ -463,7 +534,7 @@ mock_tracker_s2c_module::cal_tracker_hit_col_t mock_tracker_s2c_module::calibrat
 
 mock_tracker_s2c_module::cal_tracker_hit_col_t mock_tracker_s2c_module::process_(
     const sim_tracker_hit_col_t& hits) {
-  raw_tracker_hit_col_t rawTrackerHits{digitizeHits_(hits)};
+  const raw_tracker_hit_col_t& rawTrackerHits = digitizeHits_(hits);
   return calibrateHits_(rawTrackerHits);
 }
 
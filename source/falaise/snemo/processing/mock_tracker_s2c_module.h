@@ -19,6 +19,7 @@
 
 // Standard library:
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -52,7 +53,7 @@ namespace processing {
 class mock_tracker_s2c_module : public dpp::base_module {
  public:
   // Because dpp::base_module is insane
-  virtual ~mock_tracker_s2c_module() { this->reset(); }
+  virtual ~mock_tracker_s2c_module();
 
   /// Initialization
   virtual void initialize(datatools::properties const& ps, datatools::service_manager& services,
@@ -67,11 +68,15 @@ class mock_tracker_s2c_module : public dpp::base_module {
  private:
   // Rationalized typenames
   using sim_tracker_hit_col_t = mctools::simulated_data::hit_handle_collection_type;
-  using raw_tracker_hit_col_t = std::list<snreco::detail::mock_raw_tracker_hit>;
+  using raw_tracker_hit_col_t = std::vector<snreco::detail::mock_raw_tracker_hit>;
   using cal_tracker_hit_col_t = snemo::datamodel::TrackerHitHdlCollection;
 
+  /// Working storage of the raw tracker hits, indexed by drift cell
+  struct raw_hit_store;
+
   /// Digitize tracker hits
-  raw_tracker_hit_col_t digitizeHits_(const sim_tracker_hit_col_t& steps);
+  /// \return the raw hits in order of first hit cell, valid until the next call
+  const raw_tracker_hit_col_t& digitizeHits_(const sim_tracker_hit_col_t& steps);
 
   /// Calibrate tracker hits (longitudinal and transverse spread)
   cal_tracker_hit_col_t calibrateHits_(const raw_tracker_hit_col_t& digits);
@@ -84,6 +89,7 @@ class mock_tracker_s2c_module : public dpp::base_module {
   std::string _hit_category_{};     //!< The category of the input Geiger hits
   geiger_regime _geiger_{};         //!< Geiger regime tools
   mygsl::rng RNG_{};                //!< internal PRN generator
+  std::unique_ptr<raw_hit_store> rawHits_;  //!< Raw tracker hits, reused from event to event
   double _peripheral_drift_time_threshold_{
       datatools::invalid_real_double()};  //!< Peripheral drift time threshold
   double _delayed_drift_time_threshold_{
@@ -3,10 +3,20 @@
 
 // Ourselves:
 #include "udd2pcd_module.h"
+#include "calo_waveform_features.h"
+#include "detail/tracker_hit_clustering.h"
 
 // Standard library:
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 // Third party:
 // - Bayeux/datatools:
@@ -34,6 +44,121 @@ namespace snemo {
     DPP_MODULE_REGISTRATION_IMPLEMENT(udd2pcd_module,
                                       "snemo::processing::udd2pcd_module")
 
+    /// \brief Pool of threads sharing the iterations of a loop with the calling thread
+    class udd2pcd_module::worker_pool
+    {
+    public:
+      /// Start the worker threads
+      explicit worker_pool(unsigned int nthreads_)
+      {
+        for (unsigned int ithread = 0; ithread < nthreads_; ithread++) {
+          _threads_.emplace_back(&worker_pool::_run_, this);
+        }
+      }
+
+      /// Stop and join the worker threads
+      ~worker_pool()
+      {
+        {
+          std::lock_guard<std::mutex> lock(_mutex_);
+          _stop_ = true;
+        }
+        _start_.notify_all();
+        for (auto & thread : _threads_) {
+          thread.join();
+        }
+      }
+
+      worker_pool(const worker_pool &) = delete;
+      worker_pool & operator=(const worker_pool &) = delete;
+
+      /// Return the number of threads running the loops, the calling one included
+      size_t size() const { return _threads_.size() + 1; }
+
+      /// Run task_(i) for each i in [0, n_) and return when all iterations are done
+      ///
+      /// The first exception thrown by an iteration is rethrown.
+      void run(size_t n_, const std::function<void(size_t)> & task_)
+      {
+        {
+          std::lock_guard<std::mutex> lock(_mutex_);
+          _task_ = &task_;
+          _size_ = n_;
+          _next_ = 0;
+          _error_ = nullptr;
+          _busy_ = _threads_.size();
+          _generation_++;
+        }
+        _start_.notify_all();
+        _work_(task_);
+        std::exception_ptr error;
+        {
+          std::unique_lock<std::mutex> lock(_mutex_);
+          _done_.wait(lock, [this] { return _busy_ == 0; });
+          _task_ = nullptr;
+          error = _error_;
+        }
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+
+    private:
+      /// Run the iterations of the current loop not yet taken by another thread
+      void _work_(const std::function<void(size_t)> & task_)
+      {
+        for (size_t i = _next_++; i < _size_; i = _next_++) {
+          try {
+            task_(i);
+          } catch (...) {
+            std::lock_guard<std::mutex> lock(_mutex_);
+            if (!_error_) {
+              _error_ = std::current_exception();
+            }
+          }
+        }
+      }
+
+      /// Worker thread main loop
+      void _run_()
+      {
+        size_t generation = 0;
+        while (true) {
+          const std::function<void(size_t)> * task = nullptr;
+          {
+            std::unique_lock<std::mutex> lock(_mutex_);
+            _start_.wait(lock, [&] { return _stop_ || _generation_ != generation; });
+            if (_stop_) {
+              return;
+            }
+            generation = _generation_;
+            task = _task_;
+          }
+          _work_(*task);
+          {
+            std::lock_guard<std::mutex> lock(_mutex_);
+            if (--_busy_ == 0) {
+              _done_.notify_one();
+            }
+          }
+        }
+      }
+
+      std::mutex _mutex_;                                    //!< Protects the loop state
+      std::condition_variable _start_;                       //!< Signalled when a loop starts
+      std::condition_variable _done_;                        //!< Signalled when the workers are done
+      const std::function<void(size_t)> * _task_ = nullptr;  //!< Body of the current loop
+      size_t _size_ = 0;                                     //!< Number of iterations of the current loop
+      std::atomic<size_t> _next_{0};                         //!< Next iteration to run
+      size_t _generation_ = 0;                               //!< Number of loops started
+      size_t _busy_ = 0;                                     //!< Workers still running the current loop
+      bool _stop_ = false;                                   //!< Flag to stop the workers
+      std::exception_ptr _error_;                            //!< First exception of the current loop
+      std::vector<std::thread> _threads_;                    //!< Worker threads
+    };
+
+    udd2pcd_module::~udd2pcd_module() { this->reset(); }
+
     void udd2pcd_module::initialize(const datatools::properties& ps,
                                     datatools::service_manager& /*unused*/,
                                     dpp::module_handle_dict_type& /*unused*/) {
@@ -59,6 +184,15 @@ namespace snemo {
       _calo_time_cfd_ratio_ = fps.get<double>("calo_time_cfd_ratio", 4./16.);
       _calo_discard_empty_waveform_ = fps.get<bool>("calo_discard_empty_waveform", false);
 
+      _calo_waveform_config_.baseline_nsamples = _calo_baseline_nsamples_;
+      _calo_waveform_config_.charge_integration_nsamples = _calo_charge_integration_nsamples_;
+      _calo_waveform_config_.charge_integration_nsamples_before_peak = _calo_charge_integration_nsamples_before_peak_;
+      _calo_waveform_config_.cfd_ratio = _calo_time_cfd_ratio_;
+
+      const int calo_parallel_threads = fps.get<int>("calo.parallel_threads", 1);
+      DT_THROW_IF(calo_parallel_threads < 1, std::domain_error,
+                  "Invalid number of calorimeter precalibration threads (" << calo_parallel_threads << ") !");
+
       std::string udd2pcd_calo_method_label = fps.get<std::string>("calo_method", "fwmeas");
       if (udd2pcd_calo_method_label == "fwmeas") {
         _calo_pcd_algo_ = ALGO_CALO_FWMEASUREMENT;
@@ -69,6 +203,16 @@ namespace snemo {
         _calo_pcd_algo_ = ALGO_CALO_FWMEASUREMENT;
       }
 
+      // Only the swmeas waveform analysis runs in parallel, the calling thread
+      // taking part in the loops
+      _calo_workers_.reset();
+      if (_calo_pcd_algo_ == ALGO_CALO_SWMEASUREMENT && calo_parallel_threads > 1) {
+        _calo_workers_.reset(new worker_pool(calo_parallel_threads - 1));
+      } else if (calo_parallel_threads > 1) {
+        DT_LOG_WARNING(get_logging_priority(), "Property 'calo.parallel_threads' is ignored by the '"
+                       << udd2pcd_calo_method_label << "' calo method");
+      }
+
       DT_LOG_NOTICE(get_logging_priority(), "calorimeter udd2pcd firmware measurement configuration:");
       DT_LOG_NOTICE(get_logging_priority(), "|- adc2volt          = " << _calo_adc2volt_/(1E-3*CLHEP::volt) << " mV/tick");
       DT_LOG_NOTICE(get_logging_priority(), "|- sampling period   = " << _calo_sampling_period_/(CLHEP::nanosecond) << " ns");
@@ -76,7 +220,8 @@ namespace snemo {
       DT_LOG_NOTICE(get_logging_priority(), "|- baseline nsamples = " << _calo_baseline_nsamples_);
       DT_LOG_NOTICE(get_logging_priority(), "|- charge integration nsamples = " << _calo_charge_integration_nsamples_);
       DT_LOG_NOTICE(get_logging_priority(), "|- pre-charge nsamples         = " << _calo_charge_integration_nsamples_before_peak_);
-      DT_LOG_NOTICE(get_logging_priority(), "`- falling time cfd ratio      = " << _calo_time_cfd_ratio_);
+      DT_LOG_NOTICE(get_logging_priority(), "|- falling time cfd ratio      = " << _calo_time_cfd_ratio_);
+      DT_LOG_NOTICE(get_logging_priority(), "`- parallel threads            = " << (_calo_workers_ ? _calo_workers_->size() : 1));
 
       // Configure tracker pre-calibration method
 
@@ -104,7 +249,10 @@ namespace snemo {
       this->base_module::_set_initialized(true);
     }
 
-    void udd2pcd_module::reset() { this->base_module::_set_initialized(false); }
+    void udd2pcd_module::reset() {
+      _calo_workers_.reset();
+      this->base_module::_set_initialized(false);
+    }
 
     // Processing :
     dpp::base_module::process_status udd2pcd_module::process(datatools::things& event) {
@@ -224,16 +372,13 @@ namespace snemo {
         new_pcd_calo->set_charge(fwmeas_charge);
         new_pcd_calo->set_time(fwmeas_time);
 
-        // Additional information into pCD calo datatools::properties
-        datatools::properties& pcd_calo_hit_properties = new_pcd_calo->grab_auxiliaries();
+        // Store the time cfd in record window
+        new_pcd_calo->set_time_cfd(fwmeas_time_cfd);
 
-        // -> store the time cfd in record window
-        pcd_calo_hit_properties.store("time_cfd_ns", fwmeas_time_cfd/CLHEP::ns);
-
-        // -> compute and store the pulse width
+        // Compute and store the pulse width
         const double fwmeas_rising_time_cfd = (fwmeas_rising_time_cfd_d/256.0) * CALO_SAMPLING_PERIOD;
         const double fwmes_width = fwmeas_rising_time_cfd - fwmeas_time_cfd;
-        pcd_calo_hit_properties.store("pulse_width_ns", fwmes_width/CLHEP::ns);
+        new_pcd_calo->set_pulse_width(fwmes_width);
 
         // Append the new pCD calorimeter hit
         calo_hits_.push_back(new_pcd_calo);
@@ -248,164 +393,31 @@ namespace snemo {
     void udd2pcd_module::precalibrate_calo_hits_swmeas(const snemo::datamodel::unified_digitized_data & udd_data_,
                                                        snemo::datamodel::PreCalibratedCalorimeterHitHdlCollection & calo_hits_) {
 
-      // Constants
-      const double CALO_ADC2VOLT = _calo_adc2volt_;
-      const double CALO_SAMPLING_PERIOD = _calo_sampling_period_;
-      const double CALO_POSTRIGGER_TIME = _calo_postrigger_time_;
-      const double CALO_TIME_WINDOW = 1024 * _calo_sampling_period_;
-
       // Retrieve UDD calorimeter digitized hits
       const auto& udd_calo_hits = udd_data_.get_calorimeter_hits();
 
-      // Loop over UDD calorimeter digitized hits
-      for (auto& a_udd_calo_hit : udd_calo_hits) {
-
-        // Discard empty waveforms
-        if (_calo_discard_empty_waveform_) {
-
-          bool discard_calo_hit = true;
-
-          // Keep hit with HT flag
-          if (a_udd_calo_hit->is_high_threshold())
-            discard_calo_hit = false;
-          // Keep hit with LT only flag
-          else if (a_udd_calo_hit->is_low_threshold_only())
-            discard_calo_hit = false;
-          // Keep hit with signal >10mV : It (rarely) happens to get signal without HT/LT !
-          // Usually such calorimeter hit was not part of the trigger decision (random coinc.)
-          // and it won't be usefull for physics, but let's keep it in the event just in case..
-          else if (((a_udd_calo_hit->get_fwmeas_peak_amplitude()/8.0) * CALO_ADC2VOLT) > (10E-3 *CLHEP::volt))
-            discard_calo_hit = false;
-
-          if (discard_calo_hit)
-            continue;
-        }
-
-        DT_LOG_TRACE(get_logging_priority(), "Precalibrating calo hit from " << snemo::datamodel::om_label(a_udd_calo_hit->get_geom_id()));
-
-        // Produce a new precalibrated calorimeter hit
-        auto new_pcd_calo = datatools::make_handle<snemo::datamodel::precalibrated_calorimeter_hit>();
-
-        // Keep same hit number for calorimeter's digitized hit and precalibrated hit
-        new_pcd_calo->set_hit_id(a_udd_calo_hit->get_hit_id());
-        new_pcd_calo->set_geom_id(a_udd_calo_hit->get_geom_id());
-
-        const std::vector<int16_t> & a_udd_calo_waveform = a_udd_calo_hit->get_waveform();
-
-        // Baseline
-        double swmeas_baseline_sum=0, swmeas_baseline_sum2=0;
-        for (int sample=0; sample<_calo_baseline_nsamples_; sample++) {
-          const int16_t & waveform_sample = a_udd_calo_waveform[sample];
-          swmeas_baseline_sum += waveform_sample;
-          swmeas_baseline_sum2 += waveform_sample*waveform_sample;
-        }
-
-        const double swmeas_baseline_adc_mean = swmeas_baseline_sum/_calo_baseline_nsamples_;
-        const double swmeas_baseline_adc_sigma2 = swmeas_baseline_sum2/_calo_baseline_nsamples_ - swmeas_baseline_adc_mean*swmeas_baseline_adc_mean;
-        const double swmeas_baseline_value = (swmeas_baseline_adc_mean - 2048) * CALO_ADC2VOLT;
-        const double swmeas_baseline_error = sqrt(swmeas_baseline_adc_sigma2) * CALO_ADC2VOLT;
-        new_pcd_calo->set_baseline(swmeas_baseline_value);
-        new_pcd_calo->set_sigma_baseline(swmeas_baseline_error);
-
-        // Amplitude
-        int16_t min_amplitude_adc = INT16_MAX;
-        int16_t min_amplitude_sample = 0;
-
-        const int16_t nsamples = a_udd_calo_waveform.size();
-
-        for (int16_t sample=0; sample<nsamples; sample++) {
-          const int16_t & waveform_sample = a_udd_calo_waveform[sample];
-          if (waveform_sample < min_amplitude_adc) {
-            min_amplitude_adc = waveform_sample;
-            min_amplitude_sample = sample;
-          }
-        }
-
-        const double swmeas_amplitude_adc = min_amplitude_adc - swmeas_baseline_adc_mean;
-        const double swmeas_amplitude_adc_sigma2 = 0.5*0.5 + swmeas_baseline_adc_sigma2;
-        const double swmeas_amplitude_value = swmeas_amplitude_adc * CALO_ADC2VOLT;
-        const double swmeas_amplitude_error = sqrt(swmeas_amplitude_adc_sigma2) * CALO_ADC2VOLT;
-        new_pcd_calo->set_amplitude(swmeas_amplitude_value);
-        new_pcd_calo->set_sigma_amplitude(swmeas_amplitude_error);
-
-        // Charge
-        int16_t charge_sample_start = min_amplitude_sample - _calo_charge_integration_nsamples_before_peak_;
-        if (charge_sample_start < 0) charge_sample_start = 0;
-        int16_t charge_sample_stop = charge_sample_start + _calo_charge_integration_nsamples_;
-        if (charge_sample_stop > nsamples) charge_sample_stop = nsamples;
-
-        double swmeas_charge_sum = 0;
-        for (int16_t sample=charge_sample_start; sample<charge_sample_stop; sample++) {
-          const int16_t & waveform_sample = a_udd_calo_waveform[sample];
-          swmeas_charge_sum += waveform_sample;
-        }
-
-        swmeas_charge_sum -= (charge_sample_stop-charge_sample_start)*swmeas_baseline_adc_mean;
-
-        const double swmeas_charge = swmeas_charge_sum * CALO_ADC2VOLT * CALO_SAMPLING_PERIOD;
-        const double swmeas_charge_sigma2 = (0.5*0.5 + swmeas_baseline_adc_sigma2)*(charge_sample_stop-charge_sample_start);
-        const double swmeas_charge_error = sqrt(swmeas_charge_sigma2) * CALO_ADC2VOLT * CALO_SAMPLING_PERIOD;
-        new_pcd_calo->set_charge(swmeas_charge);
-        new_pcd_calo->set_sigma_charge(swmeas_charge_error);
-
-        // Time CFD
-        const double cfd_threshold_adc = swmeas_baseline_adc_mean + _calo_time_cfd_ratio_*swmeas_amplitude_adc;
-
-        // Look for waveform sample crossing threshold (front side of the pulse)
-        int16_t sample_i = 0;
-        for (sample_i=min_amplitude_sample ; sample_i>0; sample_i--) {
-          const int16_t & waveform_sample = a_udd_calo_waveform[sample_i];
-          if (waveform_sample >= cfd_threshold_adc)
-            break;
-        }
-
-        // Interpolate with pol1 the two consecutives samples to retrieve the falling time
-        double swmeas_falling_time_cfd_sample = 0;
-        if (sample_i != (nsamples-2)) {
-          const double sample_x1 = sample_i;
-          const double sample_x2 = sample_i+1;
-          const double sample_y1 = a_udd_calo_waveform[sample_x1];
-          const double sample_y2 = a_udd_calo_waveform[sample_x2];
-          const double pol1_a = (sample_y2-sample_y1)/(sample_x2-sample_x1);
-          const double pol1_b = sample_y1-pol1_a*sample_x1;
-          swmeas_falling_time_cfd_sample = (cfd_threshold_adc-pol1_b)/pol1_a;
-        }
-
-        const double time_tdc = a_udd_calo_hit->get_timestamp() * 6.25 * CLHEP::ns;
-        const double swmeas_falling_time_cfd = swmeas_falling_time_cfd_sample * CALO_SAMPLING_PERIOD;
-        const double swmeas_falling_time = time_tdc - CALO_TIME_WINDOW + CALO_POSTRIGGER_TIME + swmeas_falling_time_cfd;
-        new_pcd_calo->set_time(swmeas_falling_time);
-        // new_pcd_calo->set_sigma_time();
-
-        // Look for waveform sample crossing threshold (back side of the pulse)
-        for (sample_i=min_amplitude_sample ; sample_i<1024; sample_i++) {
-          const int16_t & waveform_sample = a_udd_calo_waveform[sample_i];
-          if (waveform_sample >= cfd_threshold_adc)
-            break;
-        }
-
-        // Interpolate with pol1 the two consecutives samples to retrieve the rising time
-        double swmeas_rising_time_cfd_sample = 0;
-        if (sample_i < (1024-2)) {
-          const double sample_x1 = sample_i-1;
-          const double sample_x2 = sample_i;
-          const double sample_y1 = a_udd_calo_waveform[sample_x1];
-          const double sample_y2 = a_udd_calo_waveform[sample_x2];
-          const double pol1_a = (sample_y2-sample_y1)/(sample_x2-sample_x1);
-          const double pol1_b = sample_y1-pol1_a*sample_x1;
-          swmeas_rising_time_cfd_sample = (cfd_threshold_adc-pol1_b)/pol1_a;
+      // Precalibrate each hit into its own slot, in parallel if worker threads are
+      // configured, then append the slots in the order of the UDD hits so that the
+      // output does not depend on the scheduling
+      std::vector<snemo::datamodel::PreCalibratedCalorimeterHitHdl> new_pcd_calos(udd_calo_hits.size());
+      auto precalibrate = [&](size_t ihit) {
+        new_pcd_calos[ihit] = precalibrate_calo_hit_swmeas(udd_calo_hits[ihit].get());
+      };
+      if (_calo_workers_ && new_pcd_calos.size() > 1) {
+        _calo_workers_->run(new_pcd_calos.size(), precalibrate);
+      } else {
+        for (size_t ihit = 0; ihit < new_pcd_calos.size(); ihit++) {
+          precalibrate(ihit);
         }
+      }
 
-        // Additional information into pCD calo datatools::properties
-        datatools::properties& pcd_calo_hit_properties = new_pcd_calo->grab_auxiliaries();
+      for (auto& new_pcd_calo : new_pcd_calos) {
 
-        // -> store the time cfd in record window
-        pcd_calo_hit_properties.store("time_cfd_ns", swmeas_falling_time_cfd/CLHEP::ns);
+        // Discarded empty waveform
+        if (!new_pcd_calo.has_data())
+          continue;
 
-        // -> compute and store the pulse width
-        const double swmeas_rising_time_cfd = swmeas_rising_time_cfd_sample * CALO_SAMPLING_PERIOD;
-        const double swmes_width = swmeas_rising_time_cfd - swmeas_falling_time_cfd;
-        pcd_calo_hit_properties.store("pulse_width_ns", swmes_width/CLHEP::ns);
+        DT_LOG_TRACE(get_logging_priority(), "Precalibrated calo hit from " << snemo::datamodel::om_label(new_pcd_calo->get_geom_id()));
 
         // Append the new pCD calorimeter hit
         calo_hits_.push_back(new_pcd_calo);
@@ -415,6 +427,92 @@ namespace snemo {
       }
     }
 
+    // Precalibrate a calorimeter hit from its waveform (called from the worker threads):
+    snemo::datamodel::PreCalibratedCalorimeterHitHdl
+    udd2pcd_module::precalibrate_calo_hit_swmeas(const snemo::datamodel::calorimeter_digitized_hit & a_udd_calo_hit_) const {
+
+      // Constants
+      const double CALO_ADC2VOLT = _calo_adc2volt_;
+      const double CALO_SAMPLING_PERIOD = _calo_sampling_period_;
+      const double CALO_POSTRIGGER_TIME = _calo_postrigger_time_;
+      const double CALO_TIME_WINDOW = 1024 * _calo_sampling_period_;
+
+      // Discard empty waveforms
+      if (_calo_discard_empty_waveform_) {
+
+        bool discard_calo_hit = true;
+
+        // Keep hit with HT flag
+        if (a_udd_calo_hit_.is_high_threshold())
+          discard_calo_hit = false;
+        // Keep hit with LT only flag
+        else if (a_udd_calo_hit_.is_low_threshold_only())
+          discard_calo_hit = false;
+        // Keep hit with signal >10mV : It (rarely) happens to get signal without HT/LT !
+        // Usually such calorimeter hit was not part of the trigger decision (random coinc.)
+        // and it won't be usefull for physics, but let's keep it in the event just in case..
+        else if (((a_udd_calo_hit_.get_fwmeas_peak_amplitude()/8.0) * CALO_ADC2VOLT) > (10E-3 *CLHEP::volt))
+          discard_calo_hit = false;
+
+        if (discard_calo_hit)
+          return snemo::datamodel::PreCalibratedCalorimeterHitHdl{};
+      }
+
+      // Produce a new precalibrated calorimeter hit
+      auto new_pcd_calo = datatools::make_handle<snemo::datamodel::precalibrated_calorimeter_hit>();
+
+      // Keep same hit number for calorimeter's digitized hit and precalibrated hit
+      new_pcd_calo->set_hit_id(a_udd_calo_hit_.get_hit_id());
+      new_pcd_calo->set_geom_id(a_udd_calo_hit_.get_geom_id());
+
+      const std::vector<int16_t> & a_udd_calo_waveform = a_udd_calo_hit_.get_waveform();
+
+      // Baseline, peak, charge and CFD crossings of the waveform
+      calo_waveform_features swmeas;
+      measure_calo_waveform(a_udd_calo_waveform.data(), a_udd_calo_waveform.size(), _calo_waveform_config_, swmeas);
+
+      // Baseline
+      const double swmeas_baseline_adc_mean = swmeas.baseline_adc_mean;
+      const double swmeas_baseline_adc_sigma2 = swmeas.baseline_adc_sigma2;
+      const double swmeas_baseline_value = (swmeas_baseline_adc_mean - 2048) * CALO_ADC2VOLT;
+      const double swmeas_baseline_error = sqrt(swmeas_baseline_adc_sigma2) * CALO_ADC2VOLT;
+      new_pcd_calo->set_baseline(swmeas_baseline_value);
+      new_pcd_calo->set_sigma_baseline(swmeas_baseline_error);
+
+      // Amplitude
+      const double swmeas_amplitude_adc = swmeas.amplitude_adc;
+      const double swmeas_amplitude_adc_sigma2 = 0.5*0.5 + swmeas_baseline_adc_sigma2;
+      const double swmeas_amplitude_value = swmeas_amplitude_adc * CALO_ADC2VOLT;
+      const double swmeas_amplitude_error = sqrt(swmeas_amplitude_adc_sigma2) * CALO_ADC2VOLT;
+      new_pcd_calo->set_amplitude(swmeas_amplitude_value);
+      new_pcd_calo->set_sigma_amplitude(swmeas_amplitude_error);
+
+      // Charge
+      const int charge_nsamples = swmeas.charge_sample_stop - swmeas.charge_sample_start;
+      const double swmeas_charge = swmeas.charge_adc * CALO_ADC2VOLT * CALO_SAMPLING_PERIOD;
+      const double swmeas_charge_sigma2 = (0.5*0.5 + swmeas_baseline_adc_sigma2)*charge_nsamples;
+      const double swmeas_charge_error = sqrt(swmeas_charge_sigma2) * CALO_ADC2VOLT * CALO_SAMPLING_PERIOD;
+      new_pcd_calo->set_charge(swmeas_charge);
+      new_pcd_calo->set_sigma_charge(swmeas_charge_error);
+
+      // Time CFD (front side of the pulse)
+      const double time_tdc = a_udd_calo_hit_.get_timestamp() * 6.25 * CLHEP::ns;
+      const double swmeas_falling_time_cfd = swmeas.falling_cfd_sample * CALO_SAMPLING_PERIOD;
+      const double swmeas_falling_time = time_tdc - CALO_TIME_WINDOW + CALO_POSTRIGGER_TIME + swmeas_falling_time_cfd;
+      new_pcd_calo->set_time(swmeas_falling_time);
+      // new_pcd_calo->set_sigma_time();
+
+      // Store the time cfd in record window
+      new_pcd_calo->set_time_cfd(swmeas_falling_time_cfd);
+
+      // Compute and store the pulse width (back side of the pulse)
+      const double swmeas_rising_time_cfd = swmeas.rising_cfd_sample * CALO_SAMPLING_PERIOD;
+      const double swmes_width = swmeas_rising_time_cfd - swmeas_falling_time_cfd;
+      new_pcd_calo->set_pulse_width(swmes_width);
+
+      return new_pcd_calo;
+    }
+
     void udd2pcd_module::process_calo_impl(const snemo::datamodel::unified_digitized_data & udd_data_,
                                            snemo::datamodel::precalibrated_data & pcd_data_) {
 
@@ -503,14 +601,11 @@ namespace snemo {
           new_pcd_tracker->set_sigma_top_cathode_drift_time(0.5*sqrt(2)*TRACKER_TDC_TICK);
         }
 
-        // Convert and fill the earliest R[1-4] timestamp in properties
+        // Convert and fill the earliest R[1-4] timestamp
         for (int ANODE_Ri=1; ANODE_Ri<5; ANODE_Ri++) {
           if (first_anode_timestamp[ANODE_Ri] != std::numeric_limits<int64_t>::max()) {
             const double first_anode_ri_time = first_anode_timestamp[ANODE_Ri] * TRACKER_TDC_TICK;
-            std::string ri_key = "R" + std::to_string(ANODE_Ri) + "_us";
-            new_pcd_tracker->grab_auxiliaries().store_real(ri_key, (first_anode_ri_time-first_anode_time)/(CLHEP::microsecond));
-            // std::string sigma_ri_key = "sigma_R" + std::to_string(ANODE_Ri) + "_drift_time";
-            // new_pcd_tracker->grab_auxiliaries().store_real(sigma_ri_key, 0.5*sqrt(2)*TRACKER_TDC_TICK);
+            new_pcd_tracker->set_anodic_ri_time(ANODE_Ri, first_anode_ri_time-first_anode_time);
           }
         }
 
@@ -529,114 +624,27 @@ namespace snemo {
       const double TRACKER_CLUSTERISATION_RADIUS2_THRES = _tracker_basic_cluster_radius_threshold_*_tracker_basic_cluster_radius_threshold_;
       const double TRACKER_CLUSTERISATION_DELTAT_THRES = _tracker_basic_cluster_deltat_threshold_;
 
-      // Temporary storage of clusters = vector of cluster
-      // (with 1 cluster = vector of tracker hit index)
-      std::vector<std::vector<int>> pcd_tracker_hit_clusters;
-
       // Retrieve pCD tracker hits
       auto & pcd_tracker_hits = pcd_data_.tracker_hits();
 
-      // Iterate over all tracker hits
-      for (size_t pcd_tracker_hit_index=0; pcd_tracker_hit_index<pcd_tracker_hits.size(); pcd_tracker_hit_index++) {
-
-        auto & pcd_tracker_hit = pcd_tracker_hits.at(pcd_tracker_hit_index).get();
-
-        // Storage of cluster indexe(s) (identified from previous iteration of this loop)
-        // in which at least 1 tracker hit will match the time/space neighboring criteria
-        // with respect to the current pcd_tracker_hit. If one or more cluster will be there,
-        // they will have to be merged!
-        std::vector<size_t> matching_cluster_indexes;
-
-        // Retrieve time/space data
-        const double & pcd_tracker_anode_time = pcd_tracker_hit.get_anodic_time();
+      // Retrieve time/space data
+      std::vector<detail::cluster_cell> pcd_tracker_cells;
+      pcd_tracker_cells.reserve(pcd_tracker_hits.size());
+      for (const auto & pcd_tracker_hit_handle : pcd_tracker_hits) {
+        const auto & pcd_tracker_hit = pcd_tracker_hit_handle.get();
         const geomtools::geom_id & pcd_tracker_geomid = pcd_tracker_hit.get_geom_id();
-        const uint32_t & pcd_tracker_side  = pcd_tracker_geomid.get(1);
-        const uint32_t & pcd_tracker_row   = pcd_tracker_geomid.get(3);
-        const uint32_t & pcd_tracker_layer = pcd_tracker_geomid.get(2);
-
-        // Iterate over all existing cluster
-        for (size_t cluster_index=0; cluster_index<pcd_tracker_hit_clusters.size(); cluster_index++) {
-
-          // Retrieve the vector of tracker hit indexes
-          const std::vector<int> & cluster_pcd_tracker_hit_indexes = pcd_tracker_hit_clusters.at(cluster_index);
-
-          // Iterate over all cells from the current cluster
-          for (const int & cluster_pcd_tracker_hit_index : cluster_pcd_tracker_hit_indexes) {
-
-            const auto & cluster_pcd_tracker_hit = pcd_tracker_hits.at(cluster_pcd_tracker_hit_index).get();
-
-            // Retrieve time/space data
-            const double & cluster_pcd_tracker_anode_time = cluster_pcd_tracker_hit.get_anodic_time();
-            const geomtools::geom_id & cluster_pcd_tracker_geomid = cluster_pcd_tracker_hit.get_geom_id();
-            const uint32_t & cluster_pcd_tracker_side  = cluster_pcd_tracker_geomid.get(1);
-            const uint32_t & cluster_pcd_tracker_layer = cluster_pcd_tracker_geomid.get(2);
-            const uint32_t & cluster_pcd_tracker_row   = cluster_pcd_tracker_geomid.get(3);
-
-            // Now perform time/space comparison of pcd_tracker_hit with cluster_pcd_tracker_hit
-
-            // 1) skip if tracker hits are not on the same side
-            if (pcd_tracker_side != cluster_pcd_tracker_side)
-              continue;
-
-            // 2) compute and perform space correlation
-            const int delta_row = cluster_pcd_tracker_row - pcd_tracker_row;
-            const int delta_layer = cluster_pcd_tracker_layer - pcd_tracker_layer;
-            const float delta_radius = delta_row*delta_row + delta_layer*delta_layer;
-
-            if (delta_radius > TRACKER_CLUSTERISATION_RADIUS2_THRES)
-              continue;
-
-            // 3) compute and perform time correlation
-            const double delta_anode_time = cluster_pcd_tracker_anode_time - pcd_tracker_anode_time;
-
-            if (abs(delta_anode_time) > TRACKER_CLUSTERISATION_DELTAT_THRES)
-              continue;
-
-            // if we reach this part, pcd_tracker_hit and cluster_pcd_tracker_hit
-            // are considered as neighbor: pcd_tracker_hit will be add in the cluster
-            matching_cluster_indexes.push_back(cluster_index);
-
-            break;
-
-          } // for (cluster_pcd_tracker_hit_index)
-
-        } // for (cluster_index)
-
-        // if pcd_tracker_hit does not matching any cluster, we will
-        // create a new cluster and fill it with the index of the hit
-        if (matching_cluster_indexes.size() == 0) {
-          std::vector<int> new_pcd_tracker_hit_cluster;
-          new_pcd_tracker_hit_cluster.push_back(pcd_tracker_hit_index);
-          pcd_tracker_hit_clusters.push_back(new_pcd_tracker_hit_cluster);
-        }
-
-        // if pcd_tracker_hit is matching only 1 single cluster,
-        // we just add the index of the tracker hit in the cluster
-        else if (matching_cluster_indexes.size() == 1) {
-          const size_t matching_cluster_index = matching_cluster_indexes.front();
-          pcd_tracker_hit_clusters[matching_cluster_index].push_back(pcd_tracker_hit_index);
-        }
-
-        // if pcd_tracker_hit is matching several cluster, we add the index
-        // of the current tracker hit in the first matching cluster, then
-        // we merge (and erase) all other clusters into the first one
-        else {
-          const size_t matching_cluster_index = matching_cluster_indexes.front();
-          pcd_tracker_hit_clusters[matching_cluster_index].push_back(pcd_tracker_hit_index);
-
-          for (size_t cluster_i=matching_cluster_indexes.size()-1; cluster_i>0; --cluster_i) {
-
-            const size_t & cluster_index = matching_cluster_indexes[cluster_i];
-
-            for (const int & tracker_index : pcd_tracker_hit_clusters[cluster_index])
-              pcd_tracker_hit_clusters[matching_cluster_index].push_back(tracker_index);
-
-            pcd_tracker_hit_clusters.erase(pcd_tracker_hit_clusters.begin() + cluster_index);
-          }
-
-        }
+        detail::cluster_cell pcd_tracker_cell;
+        pcd_tracker_cell.side  = pcd_tracker_geomid.get(1);
+        pcd_tracker_cell.layer = pcd_tracker_geomid.get(2);
+        pcd_tracker_cell.row   = pcd_tracker_geomid.get(3);
+        pcd_tracker_cell.anode_time = pcd_tracker_hit.get_anodic_time();
+        pcd_tracker_cells.push_back(pcd_tracker_cell);
+      }
 
-      } // for (pcd_tracker_hit_index)
+      // Temporary storage of clusters = vector of cluster
+      // (with 1 cluster = vector of tracker hit index)
+      const std::vector<std::vector<int>> pcd_tracker_hit_clusters =
+        detail::make_tracker_hit_clusters(pcd_tracker_cells, TRACKER_CLUSTERISATION_RADIUS2_THRES, TRACKER_CLUSTERISATION_DELTAT_THRES);
 
       DT_LOG_DEBUG(get_logging_priority(), pcd_tracker_hit_clusters.size() << " cluster(s) identified");
 
@@ -976,6 +984,26 @@ DOCD_CLASS_IMPLEMENT_LOAD_BEGIN(snemo::processing::udd2pcd_module, ocd_) {
                    "                                  \n");
   }
 
+  {
+    // Description of the 'calo.parallel_threads' configuration property :
+    datatools::configuration_property_description& cpd = ocd_.add_property_info();
+    cpd.set_name_pattern("calo.parallel_threads")
+      .set_terse_description("Number of threads precalibrating the calorimeter hits of an event")
+      .set_traits(datatools::TYPE_INTEGER)
+      .set_mandatory(false)
+      .set_long_description(
+                            "With the 'swmeas' method, the waveforms of an event are analysed \n"
+                            "by this number of threads, the processing thread included. The   \n"
+                            "hits are stored in the order of the UDD hits whatever the number \n"
+                            "of threads. It is ignored by the 'fwmeas' method.                \n")
+      .set_default_value_integer(1)
+      .add_example(
+                   "Analyse the waveforms with 4 threads::    \n"
+                   "                                          \n"
+                   "  calo.parallel_threads : integer = 4     \n"
+                   "                                          \n");
+  }
+
   // Additionnal configuration hints :
   ocd_.set_configuration_hints(
                                "Here is a full configuration example in the \n"
@@ -16,6 +16,7 @@
 
 // Standard library:
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -28,6 +29,7 @@
 // This project :
 #include <falaise/snemo/datamodels/unified_digitized_data.h>
 #include <falaise/snemo/datamodels/precalibrated_data.h>
+#include <falaise/snemo/processing/calo_waveform_features.h>
 #include <falaise/snemo/processing/module.h>
 #include <falaise/snemo/services/geometry.h>
 #include <falaise/snemo/services/service_handle.h>
@@ -60,7 +62,7 @@ namespace snemo {
 
     public:
       // Because dpp::base_module is insane
-      virtual ~udd2pcd_module() { this->reset(); }
+      virtual ~udd2pcd_module();
 
       /// Initialization
       virtual void initialize(const datatools::properties& ps, datatools::service_manager& /*unused*/,
@@ -82,6 +84,10 @@ namespace snemo {
       void precalibrate_calo_hits_swmeas(const snemo::datamodel::unified_digitized_data & udd_data_,
                                          snemo::datamodel::PreCalibratedCalorimeterHitHdlCollection & calo_hits_);
 
+      /// Precalibrate a calorimeter hit with swmeas, return an empty handle if the hit is discarded
+      snemo::datamodel::PreCalibratedCalorimeterHitHdl
+      precalibrate_calo_hit_swmeas(const snemo::datamodel::calorimeter_digitized_hit & udd_calo_hit_) const;
+
       /// Main process calo function
       void process_calo_impl(const snemo::datamodel::unified_digitized_data & udd_data_,
                              snemo::datamodel::precalibrated_data & pcd_data_);
@@ -98,7 +104,9 @@ namespace snemo {
                                 snemo::datamodel::precalibrated_data & pcd_data_);
 
     private:
-      
+
+      class worker_pool;
+
       std::string _udd_input_tag_{};  //!< The label of the unified digitized bank
       std::string _pcd_output_tag_{}; //!< The label of the precalibrated data bank
 
@@ -112,6 +120,8 @@ namespace snemo {
       int    _calo_charge_integration_nsamples_before_peak_;
       double _calo_time_cfd_ratio_;
       bool   _calo_discard_empty_waveform_;
+      calo_waveform_config _calo_waveform_config_;  //!< Configuration of the swmeas waveform analysis
+      std::unique_ptr<worker_pool> _calo_workers_;   //!< Threads of the swmeas precalibration (none if sequential)
 
       tracker_precalibration_algorithm _tracker_pcd_algo_;
       double _tracker_basic_cluster_radius_threshold_;
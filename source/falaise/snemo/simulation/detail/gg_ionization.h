@@ -0,0 +1,59 @@
+/// \file falaise/snemo/simulation/detail/gg_ionization.h
+/*
+ * Description:
+ *
+ *   Selection of the first-ionization ion/electron pair closest to the
+ *   anode wire among a batch of pairs shot along a step hit in a drift cell.
+ *
+ */
+
+#ifndef FALAISE_SNEMO_SIMULATION_DETAIL_GG_IONIZATION_H
+#define FALAISE_SNEMO_SIMULATION_DETAIL_GG_IONIZATION_H 1
+
+// Standard library:
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace snemo {
+
+namespace simulation {
+
+namespace detail {
+
+/// Return the index of the ionization closest to the anode wire among a batch of
+/// ionizations shot along a step, or the batch size if none lies in the fiducial region
+///
+/// Ionization i lies at start + fraction[i] * step in the drift cell frame. Its squared
+/// drift distance is stored in drift2[i], or +infinity if it is outside the fiducial region
+/// (d2 > max_drift2 or |z| > max_abs_z, boundaries included in the region).
+/// Both loops are free of branches and calls so that the compiler can vectorize them.
+inline size_t find_closest_ionization(size_t count, const double* fraction, const double* start,
+                                      const double* step, double max_drift2, double max_abs_z,
+                                      double* drift2) {
+  const double infinity = std::numeric_limits<double>::infinity();
+  for (size_t i = 0; i < count; i++) {
+    const double x = start[0] + fraction[i] * step[0];
+    const double y = start[1] + fraction[i] * step[1];
+    const double z = start[2] + fraction[i] * step[2];
+    const double d2 = x * x + y * y;
+    drift2[i] = (d2 <= max_drift2 && std::abs(z) <= max_abs_z) ? d2 : infinity;
+  }
+  size_t closest = count;
+  double closest_drift2 = infinity;
+  for (size_t i = 0; i < count; i++) {
+    // The first of equally close ionizations wins, as in the one by one algorithm:
+    const bool closer = drift2[i] < closest_drift2;
+    closest = closer ? i : closest;
+    closest_drift2 = closer ? drift2[i] : closest_drift2;
+  }
+  return closest;
+}
+
+}  // end of namespace detail
+
+}  // end of namespace simulation
+
+}  // end of namespace snemo
+
+#endif  // FALAISE_SNEMO_SIMULATION_DETAIL_GG_IONIZATION_H
@@ -4,7 +4,9 @@
 #include <falaise/snemo/simulation/gg_step_hit_processor.h>
 
 // Standard library:
+#include <cmath>
 #include <fstream>
+#include <limits>
 
 // Third party:
 // - Bayeux/mygsl:
@@ -16,6 +18,7 @@
 
 // This project:
 #include <falaise/snemo/datamodels/gg_track_utils.h>
+#include <falaise/snemo/simulation/detail/gg_ionization.h>
 #include "falaise/property_set.h"
 #include "falaise/quantity.h"
 
@@ -38,6 +41,7 @@ void gg_step_hit_processor::_set_defaults() {
   fiducialCellLength_ = datatools::invalid_real();
   meanIonizationEnergy_ = 50. * CLHEP::eV;
   useContinuousIonization_ = false;
+  useBatchedIonization_ = false;
   computeMinimumApproachPosition_ = false;
   storeTrackInfo_ = false;
   externalRNG_ = nullptr;
@@ -45,6 +49,7 @@ void gg_step_hit_processor::_set_defaults() {
   allCategoryIDs_ = nullptr;
   geigerCellCategoryID_ = geomtools::geom_id::INVALID_TYPE;
   moduleCategoryID_ = geomtools::geom_id::INVALID_TYPE;
+  candidateHitsPerCell_.clear();
 }
 
 void gg_step_hit_processor::reset() { _set_defaults(); }
@@ -62,6 +67,7 @@ void gg_step_hit_processor::initialize(const ::datatools::properties &dps,
   mappingCategory_ = ps.get<std::string>("mapping.category");
   moduleCategory_ = ps.get<std::string>("module.category", moduleCategory_);
   useContinuousIonization_ = ps.get<bool>("use_continuous_ionization", useContinuousIonization_);
+  useBatchedIonization_ = ps.get<bool>("use_batched_ionization", useBatchedIonization_);
   computeMinimumApproachPosition_ =
       ps.get<bool>("compute_minimum_approach_position", computeMinimumApproachPosition_);
   storeTrackInfo_ = ps.get<bool>("store_track_infos", storeTrackInfo_);
@@ -159,6 +165,14 @@ mygsl::rng &gg_step_hit_processor::get_rng() {
   return localRNG_;
 }
 
+std::size_t gg_step_hit_processor::cell_id_hash::operator()(const geomtools::geom_id &gid) const {
+  std::size_t value = gid.get_type();
+  for (size_t i = 0; i < gid.get_depth(); i++) {
+    value = value * 1000003u ^ gid.get(i);
+  }
+  return value;
+}
+
 bool gg_step_hit_processor::match_gg_hit(const mctools::base_step_hit &gg_hit_,
                                          const mctools::base_step_hit &step_hit_) const {
   // check the volume geometry ID:
@@ -281,6 +295,26 @@ void gg_step_hit_processor::_process(
 
   const double locator_tolerance = 0.1 * CLHEP::micrometer;
 
+  // Access to the candidate Geiger hit at some index of the output collection:
+  auto candidate_gg_hit = [&](size_t index_) -> mctools::base_step_hit * {
+    if (useHandles) {
+      auto &gg_hit = (*handleHits)[index_];
+      return gg_hit.has_data() ? &gg_hit.grab() : nullptr;
+    }
+    return &(*plainHits)[index_];
+  };
+
+  // Index the candidate Geiger hits by drift cell, so that a step hit is only
+  // compared to the Geiger hits of its own cell, in collection order:
+  candidateHitsPerCell_.clear();
+  const size_t number_of_hits = useHandles ? handleHits->size() : plainHits->size();
+  for (size_t index = 0; index < number_of_hits; index++) {
+    const mctools::base_step_hit *gg_hit = candidate_gg_hit(index);
+    if (gg_hit != nullptr) {
+      candidateHitsPerCell_[gg_hit->get_geom_id()].push_back(index);
+    }
+  }
+
   for (auto ihit : hitPtrCollection) {
     auto &the_step_hit = const_cast<mctools::base_step_hit &>(*ihit);
 
@@ -490,68 +524,88 @@ void gg_step_hit_processor::_process(
        *                            +
        *                             C (the cell center == origin in DCCF)
        */
-      // loop on ionizations:
-      for (size_t ion = 0; ion < number_of_ionizations; ++ion) {
-        // shoot time and vertex:
-        const double ran = get_rng().uniform();
-        const double ran_ionization_time = hit_time_start + ran * (hit_time_stop - hit_time_start);
-        const geomtools::vector_3d ran_ionization_pos = cell_hit_pos_start + ran * step_dir;
-
-        const double hit_x = ran_ionization_pos.x();
-        const double hit_y = ran_ionization_pos.y();
-        const double hit_z = ran_ionization_pos.z();
-
-        // compute the drift distance to the anodic wire:
-        const double drift_distance = hypot(hit_x, hit_y);
-
-        // compute the impact of the Geiger avalanche on the anodic wire (DCCF):
-        geomtools::vector_3d avalanche_impact_cell_pos(0.0, 0.0, hit_z);
-
-        // Check if the ionization occurs in a fiducial cylinder (if requested):
-
-        // In the drift cell XY plane:
-        if (datatools::is_valid(fiducialCellRadius_)) {
-          // not in the fiducial drift X-Y circular region:
-          if (drift_distance > fiducialCellRadius_) {
-            // drop this ion/electron pair which will not
-            // produce a Geiger avalanche and thus is sterile:
-            continue;
+      if (useBatchedIonization_) {
+        if (number_of_ionizations > 0) {
+          // shoot all the ionizations along the step at once:
+          ionizationRandoms_.resize(number_of_ionizations);
+          ionizationDrift2_.resize(number_of_ionizations);
+          for (size_t ion = 0; ion < number_of_ionizations; ++ion) {
+            ionizationRandoms_[ion] = get_rng().uniform();
+          }
+          const double start[3] = {cell_hit_pos_start.x(), cell_hit_pos_start.y(),
+                                   cell_hit_pos_start.z()};
+          const double step[3] = {step_dir.x(), step_dir.y(), step_dir.z()};
+          const double max_drift2 = datatools::is_valid(fiducialCellRadius_)
+                                        ? fiducialCellRadius_ * fiducialCellRadius_
+                                        : std::numeric_limits<double>::infinity();
+          const double max_abs_z = datatools::is_valid(fiducialCellLength_)
+                                       ? 0.5 * fiducialCellLength_
+                                       : std::numeric_limits<double>::infinity();
+          const size_t closest = detail::find_closest_ionization(
+              number_of_ionizations, ionizationRandoms_.data(), start, step, max_drift2, max_abs_z,
+              ionizationDrift2_.data());
+          if (closest < number_of_ionizations) {
+            // record the closest ion/electron pair as in the one by one algorithm:
+            const double ran = ionizationRandoms_[closest];
+            const geomtools::vector_3d ran_ionization_pos = cell_hit_pos_start + ran * step_dir;
+            min_drift_distance = hypot(ran_ionization_pos.x(), ran_ionization_pos.y());
+            ionization_time_discrete = hit_time_start + ran * (hit_time_stop - hit_time_start);
+            ionization_world_pos_discrete =
+                world_hit_pos_start + ran * (world_hit_pos_stop - world_hit_pos_start);
+            ionization_world_momentum_discrete = world_hit_momentum_start;
+            const geomtools::vector_3d avalanche_impact_cell_pos(0.0, 0.0, ran_ionization_pos.z());
+            cell_world_plcmt.child_to_mother(avalanche_impact_cell_pos,
+                                             avalanche_impact_world_pos_discrete);
           }
         }
+      } else {
+        // loop on ionizations:
+        for (size_t ion = 0; ion < number_of_ionizations; ++ion) {
+          // shoot time and vertex:
+          const double ran = get_rng().uniform();
+          const double ran_ionization_time =
+              hit_time_start + ran * (hit_time_stop - hit_time_start);
+          const geomtools::vector_3d ran_ionization_pos = cell_hit_pos_start + ran * step_dir;
+
+          const double hit_x = ran_ionization_pos.x();
+          const double hit_y = ran_ionization_pos.y();
+          const double hit_z = ran_ionization_pos.z();
+
+          // compute the drift distance to the anodic wire:
+          const double drift_distance = hypot(hit_x, hit_y);
+
+          // compute the impact of the Geiger avalanche on the anodic wire (DCCF):
+          geomtools::vector_3d avalanche_impact_cell_pos(0.0, 0.0, hit_z);
+
+          // Check if the ionization occurs in a fiducial cylinder (if requested):
+
+          // In the drift cell XY plane:
+          if (datatools::is_valid(fiducialCellRadius_)) {
+            // not in the fiducial drift X-Y circular region:
+            if (drift_distance > fiducialCellRadius_) {
+              // drop this ion/electron pair which will not
+              // produce a Geiger avalanche and thus is sterile:
+              continue;
+            }
+          }
 
-        // Along the drift cell Z axis:
-        if (datatools::is_valid(fiducialCellLength_)) {
-          // not in the fiducial drift Z longitudinal region:
-          // drop this ion/electron pair which will not
-          // produce a Geiger avalanche and thus is sterile.
-          if (std::abs(hit_z) > 0.5 * fiducialCellLength_) {
-            continue;
+          // Along the drift cell Z axis:
+          if (datatools::is_valid(fiducialCellLength_)) {
+            // not in the fiducial drift Z longitudinal region:
+            // drop this ion/electron pair which will not
+            // produce a Geiger avalanche and thus is sterile.
+            if (std::abs(hit_z) > 0.5 * fiducialCellLength_) {
+              continue;
+            }
           }
-        }
 
-        if (!datatools::is_valid(min_drift_distance)) {
-          // The first processed ion/electron pair is accepted as
-          // the closest to the anodic wire (so far):
-          min_drift_distance = drift_distance;
-          // record the time of the pair creation:
-          ionization_time_discrete = ran_ionization_time;
-          // record its position:
-          ionization_world_pos_discrete =
-              world_hit_pos_start + ran * (world_hit_pos_stop - world_hit_pos_start);
-          // 2011-12-08 FM: added
-          ionization_world_momentum_discrete = world_hit_momentum_start;
-          // compute the impact of the Geiger avalanche
-          // on the anodic wire (WCS):
-          cell_world_plcmt.child_to_mother(avalanche_impact_cell_pos,
-                                           avalanche_impact_world_pos_discrete);
-        } else {
-          if (drift_distance < min_drift_distance) {
-            // This ion/electron pair is closest than the
-            // current best candidate:
+          if (!datatools::is_valid(min_drift_distance)) {
+            // The first processed ion/electron pair is accepted as
+            // the closest to the anodic wire (so far):
             min_drift_distance = drift_distance;
-            // So we update now the ionization time and position
-            // with this new pair:
+            // record the time of the pair creation:
             ionization_time_discrete = ran_ionization_time;
+            // record its position:
             ionization_world_pos_discrete =
                 world_hit_pos_start + ran * (world_hit_pos_stop - world_hit_pos_start);
             // 2011-12-08 FM: added
@@ -560,9 +614,26 @@ void gg_step_hit_processor::_process(
             // on the anodic wire (WCS):
             cell_world_plcmt.child_to_mother(avalanche_impact_cell_pos,
                                              avalanche_impact_world_pos_discrete);
+          } else {
+            if (drift_distance < min_drift_distance) {
+              // This ion/electron pair is closest than the
+              // current best candidate:
+              min_drift_distance = drift_distance;
+              // So we update now the ionization time and position
+              // with this new pair:
+              ionization_time_discrete = ran_ionization_time;
+              ionization_world_pos_discrete =
+                  world_hit_pos_start + ran * (world_hit_pos_stop - world_hit_pos_start);
+              // 2011-12-08 FM: added
+              ionization_world_momentum_discrete = world_hit_momentum_start;
+              // compute the impact of the Geiger avalanche
+              // on the anodic wire (WCS):
+              cell_world_plcmt.child_to_mother(avalanche_impact_cell_pos,
+                                               avalanche_impact_world_pos_discrete);
+            }
           }
-        }
-      }  // for
+        }  // for
+      }
 
       // at this stage, the space/time coordinates of the best ion/electron
       // pair is available through:
@@ -775,25 +846,15 @@ void gg_step_hit_processor::_process(
         matching_gg = current_gg_hit;
       }
     }
-    // else we scan the whole list of gg hits to find a match :
+    // else we scan the gg hits in the same drift cell to find a match :
     if (matching_gg == nullptr) {
-      if (useHandles) {
-        for (auto &gg_hit : *handleHits) {
-          if (!gg_hit.has_data()) {
-            continue;
-          }
-          mctools::base_step_hit &matching_hit = gg_hit.grab();
-          if (match_gg_hit(matching_hit, the_step_hit)) {
-            // pick up the first matching gg hit :
-            matching_gg = &matching_hit;
-            break;
-          }
-        }
-      } else {
-        for (auto &matching_hit : *plainHits) {
-          if (match_gg_hit(matching_hit, the_step_hit)) {
+      auto cell_hits = candidateHitsPerCell_.find(gid);
+      if (cell_hits != candidateHitsPerCell_.end()) {
+        for (size_t index : cell_hits->second) {
+          mctools::base_step_hit *matching_hit = candidate_gg_hit(index);
+          if (matching_hit != nullptr && match_gg_hit(*matching_hit, the_step_hit)) {
             // pick up the first matching gg hit :
-            matching_gg = &matching_hit;
+            matching_gg = matching_hit;
             break;
           }
         }
@@ -817,6 +878,8 @@ void gg_step_hit_processor::_process(
         // get a reference to the last inserted GG hit :
         current_gg_hit = &(plainHits->back());
       }
+      candidateHitsPerCell_[gid].push_back(useHandles ? handleHits->size() - 1
+                                                      : plainHits->size() - 1);
       // update the attributes of the hit :
       current_gg_hit->set_hit_id(gg_hit_count);
       current_gg_hit->set_geom_id(gid);
@@ -17,6 +17,11 @@
  *  the output step contains the geometry ID of the cell,
  *  the position and time of the fastest ion/electron ionization pair.
  *
+ *  The first-ionization electrons of a step can be shot one by one (default)
+ *  or in batches ("use_batched_ionization" property): all random positions
+ *  along the step are then drawn at once and their drift distances computed
+ *  in a vectorizable loop before the closest one is selected.
+ *
  *  CAUTION: this processor can manage only one geometry mapping category
  *  so care should be taken to attach only one geometry model (with the proper
  *  mapping category) to this processor.
@@ -29,6 +34,10 @@
 #ifndef FALAISE_SNEMO_SIMULATION_GG_STEP_HIT_PROCESSOR_H
 #define FALAISE_SNEMO_SIMULATION_GG_STEP_HIT_PROCESSOR_H 1
 
+// Standard library:
+#include <unordered_map>
+#include <vector>
+
 // Third party:
 // - Bayeux/datatools :
 #include <datatools/time_tools.h>
@@ -106,6 +115,15 @@ class gg_step_hit_processor : public mctools::base_step_hit_processor {
                       mctools::simulated_data::hit_collection_type* plainHits);
 
  private:
+  /// Hash of the geometry ID of a drift cell
+  struct cell_id_hash {
+    std::size_t operator()(const geomtools::geom_id& gid) const;
+  };
+
+  /// Indexes of the candidate Geiger hits in the output collection, per drift cell
+  typedef std::unordered_map<geomtools::geom_id, std::vector<std::size_t>, cell_id_hash>
+      cell_hits_index_type;
+
   std::string moduleCategory_;  /* the name of the mapping
                                  * category of module
                                  */
@@ -140,6 +158,7 @@ class gg_step_hit_processor : public mctools::base_step_hit_processor {
                                  */
 
   bool useContinuousIonization_;
+  bool useBatchedIonization_;  //!< Shoot the first ionizations of a step in a single batch
   bool computeMinimumApproachPosition_;
   bool storeTrackInfo_;
 
@@ -163,6 +182,9 @@ class gg_step_hit_processor : public mctools::base_step_hit_processor {
                                                    */
   geometry::gg_locator fastGeigerCellLocator_;    //!< A fast locator for SuperNEMO Geiger cells
   std::map<uint32_t, geometry::gg_locator> perModuleFastGeigerLocators_;
+  cell_hits_index_type candidateHitsPerCell_;  //!< Working index of the current event's Geiger hits
+  std::vector<double> ionizationRandoms_;      //!< Working batch of step fractions of ionizations
+  std::vector<double> ionizationDrift2_;       //!< Working batch of squared drift distances
 
   // Registration macro :
   MCTOOLS_STEP_HIT_PROCESSOR_REGISTRATION_INTERFACE(gg_step_hit_processor)
@@ -10,8 +10,11 @@
 // Third party:
 // - Bayeux/datatools:
 #include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/io_factory.h>
 #include <datatools/smart_ref.h>
 #include <datatools/units.h>
+#include <datatools/utils.h>
 
 // This project:
 #include <falaise/snemo/datamodels/precalibrated_calorimeter_hit.h>
@@ -55,7 +58,7 @@ int main(/* int argc_, char ** argv_ */) {
       my_calo_hit.set_amplitude(-113.525 * 1E-3 * CLHEP::volt);
       my_calo_hit.set_charge(-3.1724 * 1E-9 * CLHEP::volt * CLHEP::second);
       my_calo_hit.set_time(22.836654123456 * CLHEP::second);
-      my_calo_hit.grab_auxiliaries().store_real("time_cfd", 119.5 * CLHEP::nanosecond);
+      my_calo_hit.set_time_cfd(119.5 * CLHEP::nanosecond);
       my_calo_hit.tree_dump(std::clog, "\nSimple precalibrated calorimeter hit");
     }
 
@@ -72,8 +75,52 @@ int main(/* int argc_, char ** argv_ */) {
       my_calo_hit.set_sigma_charge(0.031724 * 1E-9 * CLHEP::volt * CLHEP::second);
       my_calo_hit.set_time(22.836654123456 * CLHEP::second);
       my_calo_hit.set_sigma_time(0.22836654123 * 1E-9 * CLHEP::second);
-      my_calo_hit.grab_auxiliaries().store_real("time_cfd", 119.5 * CLHEP::nanosecond);
+      my_calo_hit.set_time_cfd(119.5 * CLHEP::nanosecond);
+      my_calo_hit.set_pulse_width(18.75 * CLHEP::nanosecond);
       my_calo_hit.tree_dump(std::clog, "\nSimple precalibrated calorimeter hit with errors");
+
+      {
+        datatools::data_writer xout("test_precalibrated_calorimeter_hit.xml", datatools::using_multi_archives);
+        datatools::data_writer bout("test_precalibrated_calorimeter_hit.data", datatools::using_multi_archives);
+        xout.store(my_calo_hit);
+        bout.store(my_calo_hit);
+      }
+
+      for (const std::string& filename : {"test_precalibrated_calorimeter_hit.xml",
+                                          "test_precalibrated_calorimeter_hit.data"}) {
+        sdm::precalibrated_calorimeter_hit loaded_calo_hit;
+        datatools::data_reader in(filename, datatools::using_multi_archives);
+        in.load(loaded_calo_hit);
+        loaded_calo_hit.tree_dump(std::clog, "\nPrecalibrated calorimeter hit (from " + filename + ")");
+        DT_THROW_IF(loaded_calo_hit.get_time_cfd() != my_calo_hit.get_time_cfd(), std::logic_error,
+                    "CFD time was not restored from '" << filename << "'!");
+        DT_THROW_IF(loaded_calo_hit.get_pulse_width() != my_calo_hit.get_pulse_width(), std::logic_error,
+                    "Pulse width was not restored from '" << filename << "'!");
+        DT_THROW_IF(!loaded_calo_hit.get_auxiliaries().empty(), std::logic_error,
+                    "Unexpected auxiliary properties in '" << filename << "'!");
+      }
+    }
+
+    {
+      // Version 0 archive, with the CFD time and the pulse width as auxiliary properties in ns
+      const std::string filename =
+        datatools::fetch_path_with_env("${FALAISE_TESTING_DIR}/samples/test_precalibrated_calorimeter_hit-v0.xml");
+      sdm::precalibrated_calorimeter_hit legacy_calo_hit;
+      legacy_calo_hit.set_time_cfd(1.0 * CLHEP::nanosecond);
+      datatools::data_reader in(filename, datatools::using_multi_archives);
+      in.load(legacy_calo_hit);
+      legacy_calo_hit.tree_dump(std::clog, "\nPrecalibrated calorimeter hit (from version 0 archive)");
+      DT_THROW_IF(legacy_calo_hit.get_time() != 1156.25 * CLHEP::nanosecond, std::logic_error,
+                  "Time was not loaded from '" << filename << "'!");
+      DT_THROW_IF(legacy_calo_hit.get_time_cfd() != 12.5 * CLHEP::nanosecond, std::logic_error,
+                  "CFD time was not imported from '" << filename << "'!");
+      DT_THROW_IF(legacy_calo_hit.get_pulse_width() != 30.25 * CLHEP::nanosecond, std::logic_error,
+                  "Pulse width was not imported from '" << filename << "'!");
+      const datatools::properties & legacy_aux = legacy_calo_hit.get_auxiliaries();
+      DT_THROW_IF(legacy_aux.has_key("time_cfd_ns") || legacy_aux.has_key("pulse_width_ns"), std::logic_error,
+                  "Legacy auxiliary properties were not removed!");
+      DT_THROW_IF(!legacy_aux.has_key("user.weight") || legacy_aux.fetch_real("user.weight") != 0.5, std::logic_error,
+                  "Other auxiliary properties were not kept!");
     }
 
     {
@@ -100,7 +147,7 @@ int main(/* int argc_, char ** argv_ */) {
 	calo_hit.set_amplitude(drand48() * -113.525 * 1E-3 * CLHEP::volt);
 	calo_hit.set_charge(drand48() * -3.1724 * 1E-9 * CLHEP::volt * CLHEP::second);
 	calo_hit.set_time(drand48() * 22.836654123 * CLHEP::second);
-	calo_hit.grab_auxiliaries().store_real("time_cfd", 119.5 * CLHEP::nanosecond);
+	calo_hit.set_time_cfd(119.5 * CLHEP::nanosecond);
         if (drand48() < 0.1) {
           calo_hit.grab_auxiliaries().store_flag("special_flag");
         }
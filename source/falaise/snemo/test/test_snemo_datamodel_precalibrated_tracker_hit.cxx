@@ -5,11 +5,15 @@
 #include <exception>
 #include <iostream>
 #include <string>
+#include <utility>
 
 // Third party
 // - Bayeux/datatools
 #include <datatools/clhep_units.h>
+#include <datatools/exception.h>
+#include <datatools/io_factory.h>
 #include <datatools/smart_ref.h>
+#include <datatools/utils.h>
 
 // This project
 #include <falaise/snemo/datamodels/precalibrated_tracker_hit.h>
@@ -29,7 +33,66 @@ int main(/* int argc_, char ** argv_ */) {
       my_gg_hit.set_anodic_time(22.123458 * CLHEP::second);
       my_gg_hit.set_bottom_cathode_drift_time(18.12 * CLHEP::microsecond);
       my_gg_hit.set_top_cathode_drift_time(35.52 * CLHEP::microsecond);
+      my_gg_hit.set_anodic_ri_time(1, 0.0125 * CLHEP::microsecond);
+      my_gg_hit.set_anodic_ri_time(3, 1.8 * CLHEP::microsecond);
       my_gg_hit.tree_dump(std::clog, "Simple precalibrated tracker hit: ");
+
+      {
+        datatools::data_writer xout("test_precalibrated_tracker_hit.xml", datatools::using_multi_archives);
+        datatools::data_writer bout("test_precalibrated_tracker_hit.data", datatools::using_multi_archives);
+        xout.store(my_gg_hit);
+        bout.store(my_gg_hit);
+      }
+
+      for (const std::string& filename : {"test_precalibrated_tracker_hit.xml",
+                                          "test_precalibrated_tracker_hit.data"}) {
+        sdm::precalibrated_tracker_hit loaded_gg_hit;
+        datatools::data_reader in(filename, datatools::using_multi_archives);
+        in.load(loaded_gg_hit);
+        loaded_gg_hit.tree_dump(std::clog, "Precalibrated tracker hit (from " + filename + "): ");
+        for (int ri = 1; ri <= sdm::precalibrated_tracker_hit::NB_ANODIC_RI; ri++) {
+          DT_THROW_IF(loaded_gg_hit.has_anodic_ri_time(ri) != my_gg_hit.has_anodic_ri_time(ri) ||
+                      (my_gg_hit.has_anodic_ri_time(ri) &&
+                       loaded_gg_hit.get_anodic_ri_time(ri) != my_gg_hit.get_anodic_ri_time(ri)),
+                      std::logic_error, "Anodic R" << ri << " time was not restored from '" << filename << "'!");
+        }
+      }
+    }
+
+    {
+      // Version 0 and 1 archives, with the R1-R4 anodic times as auxiliary properties in us
+      const std::string v0_filename =
+        datatools::fetch_path_with_env("${FALAISE_TESTING_DIR}/samples/test_precalibrated_tracker_hit-v0.xml");
+      const std::string v1_filename =
+        datatools::fetch_path_with_env("${FALAISE_TESTING_DIR}/samples/test_precalibrated_tracker_hit-v1.xml");
+      const double v0_ri_times[] = {0.5 * CLHEP::microsecond, datatools::invalid_real(),
+                                    2.25 * CLHEP::microsecond, datatools::invalid_real()};
+      const double v1_ri_times[] = {datatools::invalid_real(), 1.75 * CLHEP::microsecond,
+                                    datatools::invalid_real(), 3.5 * CLHEP::microsecond};
+
+      // The same hit is reused, so that times missing from an archive must be reset
+      sdm::precalibrated_tracker_hit legacy_gg_hit;
+      for (const auto & legacy : {std::make_pair(v1_filename, v1_ri_times),
+                                  std::make_pair(v0_filename, v0_ri_times)}) {
+        const std::string & filename = legacy.first;
+        datatools::data_reader in(filename, datatools::using_multi_archives);
+        in.load(legacy_gg_hit);
+        legacy_gg_hit.tree_dump(std::clog, "Precalibrated tracker hit (from " + filename + "): ");
+        DT_THROW_IF(legacy_gg_hit.get_anodic_time() != 2.5 * CLHEP::microsecond, std::logic_error,
+                    "Anodic time was not loaded from '" << filename << "'!");
+        const datatools::properties & legacy_aux = legacy_gg_hit.get_auxiliaries();
+        for (int ri = 1; ri <= sdm::precalibrated_tracker_hit::NB_ANODIC_RI; ri++) {
+          const double expected = legacy.second[ri - 1];
+          DT_THROW_IF(legacy_gg_hit.has_anodic_ri_time(ri) != datatools::is_valid(expected) ||
+                      (datatools::is_valid(expected) && legacy_gg_hit.get_anodic_ri_time(ri) != expected),
+                      std::logic_error, "Anodic R" << ri << " time was not imported from '" << filename << "'!");
+          DT_THROW_IF(legacy_aux.has_key("R" + std::to_string(ri) + "_us"), std::logic_error,
+                      "Legacy R" << ri << " auxiliary property was not removed!");
+        }
+        DT_THROW_IF(!legacy_aux.has_key("pCD.clustering.cluster_id") ||
+                    legacy_aux.fetch_integer("pCD.clustering.cluster_id") != 3, std::logic_error,
+                    "Clustering auxiliary property was not kept!");
+      }
     }
 
     {
@@ -0,0 +1,63 @@
+// Catch
+#include "catch.hpp"
+
+#include "falaise/snemo/services/geometry.h"
+#include "falaise/snemo/services/service_handle.h"
+#include "falaise/snemo/geometry/config.h"
+#include "falaise/snemo/geometry/geom_info_table.h"
+#include "falaise/snemo/geometry/gg_locator.h"
+#include "falaise/snemo/geometry/locator_plugin.h"
+#include "falaise/snemo/geometry/locator_helpers.h"
+
+#include "bayeux/datatools/multi_properties.h"
+#include "bayeux/datatools/service_manager.h"
+#include "bayeux/geomtools/mapping.h"
+
+TEST_CASE("Dense tables agree with the geometry mapping", "") {
+  datatools::service_manager dummyServices{};
+  datatools::multi_properties config;
+  config.set_key_label("name");
+  config.set_meta_label("type");
+  config.add_section("geometry", "geomtools::geometry_service")
+      .store_path("manager.configuration_file",
+                  snemo::geometry::default_geometry_tag());
+  dummyServices.load(config);
+  dummyServices.initialize();
+  snemo::service_handle<snemo::geometry_svc> gs{dummyServices};
+
+  const snemo::geometry::locator_plugin* lp =
+      snemo::geometry::getSNemoLocator(*(gs.operator->()), "locators_driver");
+  const geomtools::mapping& mapping = gs->get_mapping();
+
+  for (const char* category : {"drift_cell_core", "calorimeter_block", "xcalo_block",
+                               "gveto_block", "calorimeter_optical_module"}) {
+    REQUIRE(lp->hasGeomInfoTable(category));
+    const snemo::geometry::geom_info_table& table = lp->geomInfoTable(category);
+    size_t nMapped = 0;
+    for (const auto& item : mapping.get_geom_infos()) {
+      const geomtools::geom_id& gid = item.first;
+      if (gid.get_type() != table.getType()) {
+        continue;
+      }
+      nMapped++;
+      REQUIRE(table.getInfo(gid) == &item.second);
+      REQUIRE(table.getPlacement(gid) == &item.second.get_world_placement());
+      REQUIRE(table.getShape(gid) == &item.second.get_logical().get_shape());
+    }
+    REQUIRE(nMapped > 0);
+    REQUIRE(table.size() == nMapped);
+
+    // Unmapped and invalid IDs
+    geomtools::geom_id outside(table.getType(), 0);
+    outside.set_depth(table.getDepth());
+    outside.set(0, 1000);
+    REQUIRE(table.getInfo(outside) == nullptr);
+    REQUIRE(table.getInfo(geomtools::geom_id()) == nullptr);
+  }
+
+  // The locators resolve their volumes through the tables
+  const snemo::geometry::gg_locator& gg = lp->geigerLocator();
+  geomtools::geom_id gid;
+  REQUIRE(gg.findCellGID(gg.transformModuleToWorld(gg.getCellPosition(1, 3, 42)), gid));
+  REQUIRE(gid == geomtools::geom_id(gg.cellGIDType(), 0, 1, 3, 42));
+}
@@ -0,0 +1,104 @@
+// Catch
+#include "catch.hpp"
+
+// Standard library
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "falaise/snemo/services/geometry.h"
+#include "falaise/snemo/services/service_handle.h"
+#include "falaise/snemo/geometry/config.h"
+#include "falaise/snemo/geometry/gg_locator.h"
+#include "falaise/snemo/geometry/locator_plugin.h"
+#include "falaise/snemo/geometry/locator_helpers.h"
+
+#include "bayeux/datatools/multi_properties.h"
+#include "bayeux/datatools/service_manager.h"
+#include "bayeux/geomtools/utils.h"
+
+TEST_CASE("Batch location agrees with findCellGID", "") {
+  datatools::service_manager dummyServices{};
+  datatools::multi_properties config;
+  config.set_key_label("name");
+  config.set_meta_label("type");
+  config.add_section("geometry", "geomtools::geometry_service")
+      .store_path("manager.configuration_file",
+                  snemo::geometry::default_geometry_tag());
+  dummyServices.load(config);
+  dummyServices.initialize();
+  snemo::service_handle<snemo::geometry_svc> gs{dummyServices};
+
+  const snemo::geometry::locator_plugin* lp =
+      snemo::geometry::getSNemoLocator(*(gs.operator->()), "locators_driver");
+  const snemo::geometry::gg_locator& gg = lp->geigerLocator();
+
+  // Cell centres, each slightly displaced, plus points spread over the whole
+  // tracker volume, including gaps, edges and outside the chamber
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> z;
+  std::mt19937 rng(314159);
+  std::uniform_real_distribution<double> offset(-0.4, 0.4);
+  for (uint32_t side = 0; side < gg.numberOfSides(); side++) {
+    for (uint32_t layer = 0; layer < gg.numberOfLayers(side); layer++) {
+      for (uint32_t row = 0; row < gg.numberOfRows(side); row++) {
+        geomtools::vector_3d cell = gg.getCellPosition(side, layer, row);
+        cell += geomtools::vector_3d(offset(rng), offset(rng), offset(rng)) * gg.cellRadius();
+        const geomtools::vector_3d world = gg.transformModuleToWorld(cell);
+        x.push_back(world.x());
+        y.push_back(world.y());
+        z.push_back(world.z());
+      }
+    }
+  }
+  const size_t nCells = x.size();
+  const geomtools::vector_3d corner0 = gg.getCellPosition(0, gg.numberOfLayers(0) - 1, 0);
+  const geomtools::vector_3d corner1 =
+      gg.getCellPosition(1, gg.numberOfLayers(1) - 1, gg.numberOfRows(1) - 1);
+  std::uniform_real_distribution<double> spreadX(corner0.x() - 2 * gg.cellDiameter(),
+                                                 corner1.x() + 2 * gg.cellDiameter());
+  std::uniform_real_distribution<double> spreadY(corner0.y() - 2 * gg.cellDiameter(),
+                                                 corner1.y() + 2 * gg.cellDiameter());
+  std::uniform_real_distribution<double> spreadZ(-0.6 * gg.cellLength(), 0.6 * gg.cellLength());
+  for (size_t i = 0; i < 100000; i++) {
+    const geomtools::vector_3d world =
+        gg.transformModuleToWorld(geomtools::vector_3d(spreadX(rng), spreadY(rng), spreadZ(rng)));
+    x.push_back(world.x());
+    y.push_back(world.y());
+    z.push_back(world.z());
+  }
+
+  std::vector<uint32_t> cells(x.size());
+  const size_t located = gg.findCellIndices(x.size(), x.data(), y.data(), z.data(), cells.data());
+
+  size_t expectedLocated = 0;
+  size_t mismatches = 0;
+  for (size_t i = 0; i < x.size(); i++) {
+    geomtools::geom_id gid;
+    const bool found = gg.findCellGID(geomtools::vector_3d(x[i], y[i], z[i]), gid);
+    if (found) {
+      expectedLocated++;
+    }
+    if (i < nCells) {
+      REQUIRE(found);
+    }
+    if (found ? gg.cellGIDFromIndex(cells[i]) != gid
+              : cells[i] != snemo::geometry::gg_locator::INVALID_CELL_INDEX) {
+      mismatches++;
+    }
+  }
+  REQUIRE(mismatches == 0);
+  REQUIRE(located == expectedLocated);
+  REQUIRE(gg.cellGIDFromIndex(snemo::geometry::gg_locator::INVALID_CELL_INDEX).is_valid() ==
+          false);
+
+  // A copy outliving the locator it was copied from locates the same cells
+  std::unique_ptr<snemo::geometry::gg_locator> first{new snemo::geometry::gg_locator(gg)};
+  const snemo::geometry::gg_locator copy{*first};
+  first.reset();
+  std::vector<uint32_t> copyCells(x.size());
+  REQUIRE(copy.findCellIndices(x.size(), x.data(), y.data(), z.data(), copyCells.data()) ==
+          located);
+  REQUIRE(copyCells == cells);
+}
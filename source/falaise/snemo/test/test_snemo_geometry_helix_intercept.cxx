@@ -0,0 +1,70 @@
+// Catch
+#include "catch.hpp"
+
+// Standard library
+#include <cmath>
+#include <random>
+
+#include "falaise/snemo/geometry/helix_intercept.h"
+
+#include "bayeux/geomtools/box.h"
+#include "bayeux/geomtools/helix_3d.h"
+#include "bayeux/geomtools/placement.h"
+
+TEST_CASE("Analytic and stepping box intercepts agree", "") {
+  using snemo::geometry::helix_intercept;
+  using snemo::geometry::vertex_info;
+  const double precision = 1.0 * CLHEP::mm;
+  const double step = 2.0 * CLHEP::cm;
+
+  std::mt19937 rng(314159);
+  std::uniform_real_distribution<double> flat(0.0, 1.0);
+  size_t nfound = 0;
+  for (size_t itrial = 0; itrial < 2000; itrial++) {
+    geomtools::helix_3d helix;
+    helix.set_radius((10.0 + 200.0 * flat(rng)) * CLHEP::cm);
+    helix.set_center(geomtools::vector_3d((flat(rng) - 0.5) * 40.0 * CLHEP::cm,
+                                          (flat(rng) - 0.5) * 40.0 * CLHEP::cm,
+                                          (flat(rng) - 0.5) * 40.0 * CLHEP::cm));
+    helix.set_step((flat(rng) - 0.5) * 200.0 * CLHEP::cm);
+    const double t1 = flat(rng);
+    helix.set_t1(t1);
+    helix.set_t2(t1 + 0.05 + 0.2 * flat(rng));
+
+    const vertex_info::from_bit_type from =
+        flat(rng) < 0.5 ? vertex_info::FROM_FIRST_BIT : vertex_info::FROM_LAST_BIT;
+    const geomtools::vector_3d start =
+        helix.get_point(from == vertex_info::FROM_FIRST_BIT ? helix.get_t1() : helix.get_t2());
+
+    // Calorimeter block-like box near the end of the helix:
+    geomtools::box block((2.0 + 30.0 * flat(rng)) * CLHEP::cm, (2.0 + 30.0 * flat(rng)) * CLHEP::cm,
+                         (2.0 + 30.0 * flat(rng)) * CLHEP::cm);
+    geomtools::placement blockPlacement(start.x() + (flat(rng) - 0.5) * 60.0 * CLHEP::cm,
+                                        start.y() + (flat(rng) - 0.5) * 60.0 * CLHEP::cm,
+                                        start.z() + (flat(rng) - 0.5) * 60.0 * CLHEP::cm,
+                                        2 * M_PI * flat(rng), M_PI * flat(rng),
+                                        2 * M_PI * flat(rng));
+
+    helix_intercept hIntercept(helix, block, blockPlacement, step, precision);
+    REQUIRE(hIntercept.is_use_analytic_solver());
+    helix_intercept::extrapolation_info analyticEi;
+    bool analyticFound = hIntercept.find_intercept(analyticEi, from);
+    hIntercept.set_use_analytic_solver(false);
+    helix_intercept::extrapolation_info steppingEi;
+    bool steppingFound = hIntercept.find_intercept(steppingEi, from);
+
+    if (analyticFound != steppingFound) {
+      // The last step may overshoot the maximum extrapolated length:
+      const helix_intercept::extrapolation_info& ei = analyticFound ? analyticEi : steppingEi;
+      REQUIRE(ei.extrapolated_xy_length > 45.0 * CLHEP::cm);
+      continue;
+    }
+    if (analyticFound) {
+      nfound++;
+      REQUIRE((analyticEi.fii.get_impact() - steppingEi.fii.get_impact()).mag() < precision);
+      REQUIRE(std::abs(analyticEi.extrapolated_length - steppingEi.extrapolated_length) <
+              precision);
+    }
+  }
+  REQUIRE(nfound > 0);
+}
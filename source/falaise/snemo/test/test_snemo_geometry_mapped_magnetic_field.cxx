@@ -27,12 +27,16 @@
 #include <exception>
 #include <iostream>
 #include <string>
+#include <vector>
 
 // Third party:
+// - Boost:
+#include <boost/filesystem.hpp>
 // - Bayeux:
 #include <bayeux/bayeux.h>
 // - Bayeux/datatools:
 #include <datatools/clhep_units.h>
+#include <datatools/exception.h>
 #include <datatools/ioutils.h>
 #include <datatools/library_loader.h>
 #include <datatools/properties.h>
@@ -183,6 +187,59 @@ int main(int argc_, char** argv_) {
       std::clog << "|B| = " << B.mag() / b_unit << " mG" << std::endl;
     }
 
+    {
+      // Build then memory-map the binary cache of the map, the field must not change:
+      boost::filesystem::path cache_dir = boost::filesystem::temp_directory_path() /
+          boost::filesystem::unique_path("test_snemo_geometry_mapped_magnetic_field_%%%%%%%%");
+      boost::filesystem::create_directories(cache_dir);
+      for (int pass = 0; pass < 2; pass++) {
+        snemo::geometry::mapped_magnetic_field cached_mmf;
+        cached_mmf.setMapMode(snemo::geometry::mapped_magnetic_field::map_mode_t::IMPORT_CSV_MAP_0);
+        cached_mmf.setMapFilename(map_filename);
+        cached_mmf.setMapCacheDirectory(cache_dir.string());
+        cached_mmf.setZeroFieldOutsideMap(true);
+        cached_mmf.setInvertedZ(z_inverted);
+        cached_mmf.initialize_simple();
+        geomtools::vector_3d B;
+        geomtools::vector_3d cached_B;
+        for (double x = -1.0 * CLHEP::m; x <= +1.0 * CLHEP::m; x += 0.1 * CLHEP::m) {
+          for (double y = -3.0 * CLHEP::m; y <= +3.0 * CLHEP::m; y += 0.3 * CLHEP::m) {
+            for (double z = -2.0 * CLHEP::m; z <= +2.0 * CLHEP::m; z += 0.2 * CLHEP::m) {
+              geomtools::vector_3d position(x, y, z);
+              mmf.compute_magnetic_field(position, 0.0, B);
+              cached_mmf.compute_magnetic_field(position, 0.0, cached_B);
+              DT_THROW_IF(B != cached_B, std::logic_error,
+                          "Cached map differs at " << position << " (pass " << pass << ")!");
+            }
+          }
+        }
+        cached_mmf.reset();
+      }
+      std::clog << "Cached map matches the CSV map" << std::endl;
+      boost::filesystem::remove_all(cache_dir);
+    }
+
+    {
+      // Batch computation along a straight track through the tracking chamber:
+      std::vector<geomtools::vector_3d> positions;
+      for (double t = 0.0; t <= 1.0; t += 0.001) {
+        positions.emplace_back((-0.4 + 0.8 * t) * CLHEP::m, (-2.0 + 4.0 * t) * CLHEP::m,
+                               (1.5 - 3.0 * t) * CLHEP::m);
+      }
+      std::vector<geomtools::vector_3d> fields(positions.size());
+      size_t nsuccess =
+          mmf.computeMagneticFields(positions.size(), positions.data(), 0.0, fields.data());
+      DT_THROW_IF(nsuccess != positions.size(), std::logic_error, "Batch computation failed!");
+      for (size_t i = 0; i < positions.size(); i++) {
+        geomtools::vector_3d B;
+        mmf.compute_magnetic_field(positions[i], 0.0, B);
+        DT_THROW_IF(B != fields[i], std::logic_error,
+                    "Batch field differs at " << positions[i] << "!");
+      }
+      std::clog << "Batch computation matches " << nsuccess << " single computations"
+                << std::endl;
+    }
+
     mmf.reset();
 
     if (draw) {
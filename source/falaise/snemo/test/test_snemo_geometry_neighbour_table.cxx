@@ -0,0 +1,91 @@
+// Catch
+#include "catch.hpp"
+
+// Standard library
+#include <vector>
+
+#include "falaise/snemo/services/geometry.h"
+#include "falaise/snemo/services/service_handle.h"
+#include "falaise/snemo/geometry/config.h"
+#include "falaise/snemo/geometry/calo_locator.h"
+#include "falaise/snemo/geometry/gveto_locator.h"
+#include "falaise/snemo/geometry/locator_plugin.h"
+#include "falaise/snemo/geometry/locator_helpers.h"
+#include "falaise/snemo/geometry/xcalo_locator.h"
+
+#include "bayeux/datatools/multi_properties.h"
+#include "bayeux/datatools/service_manager.h"
+
+namespace {
+bool same_ids(const snemo::geometry::geom_id_range& range,
+              const std::vector<geomtools::geom_id>& ids) {
+  return std::vector<geomtools::geom_id>(range.begin(), range.end()) == ids;
+}
+}  // namespace
+
+TEST_CASE("Neighbour ranges match the neighbour lists", "") {
+  datatools::service_manager dummyServices{};
+  datatools::multi_properties config;
+  config.set_key_label("name");
+  config.set_meta_label("type");
+  config.add_section("geometry", "geomtools::geometry_service")
+      .store_path("manager.configuration_file",
+                  snemo::geometry::default_geometry_tag());
+  dummyServices.load(config);
+  dummyServices.initialize();
+  snemo::service_handle<snemo::geometry_svc> gs{dummyServices};
+
+  const snemo::geometry::locator_plugin* lp =
+      snemo::geometry::getSNemoLocator(*(gs.operator->()), "locators_driver");
+  const uint8_t masks[] = {snemo::geometry::grid_mask_t::NONE,
+                           snemo::geometry::grid_mask_t::SIDE,
+                           snemo::geometry::grid_mask_t::DIAG,
+                           snemo::geometry::grid_mask_t::FIRST,
+                           snemo::geometry::grid_mask_t::FIRST |
+                               snemo::geometry::grid_mask_t::SECOND};
+
+  SECTION("Main wall") {
+    const snemo::geometry::calo_locator& cl = lp->caloLocator();
+    for (uint32_t side = 0; side < cl.numberOfSides(); side++) {
+      for (uint32_t column = 0; column < cl.numberOfColumns(side); column++) {
+        for (uint32_t row = 0; row < cl.numberOfRows(side); row++) {
+          for (uint8_t mask : masks) {
+            REQUIRE(same_ids(cl.getNeighbourRange(side, column, row, mask),
+                             cl.getNeighbourGIDs(side, column, row, mask)));
+          }
+        }
+      }
+    }
+    REQUIRE_THROWS(cl.getNeighbourRange(0, cl.numberOfColumns(0), 0));
+  }
+
+  SECTION("X walls") {
+    const snemo::geometry::xcalo_locator& xl = lp->xcaloLocator();
+    for (uint32_t side = 0; side < xl.numberOfSides(); side++) {
+      for (uint32_t wall = 0; wall < xl.numberOfWalls(); wall++) {
+        for (uint32_t column = 0; column < xl.numberOfColumns(side, wall); column++) {
+          for (uint32_t row = 0; row < xl.numberOfRows(side, wall); row++) {
+            for (uint8_t mask : masks) {
+              REQUIRE(same_ids(xl.getNeighbourRange(side, wall, column, row, mask),
+                               xl.getNeighbourGIDs(side, wall, column, row, mask)));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("Gamma veto") {
+    const snemo::geometry::gveto_locator& gl = lp->gvetoLocator();
+    for (uint32_t side = 0; side < gl.numberOfSides(); side++) {
+      for (uint32_t wall = 0; wall < gl.numberOfWalls(); wall++) {
+        for (uint32_t column = 0; column < gl.numberOfColumns(side, wall); column++) {
+          for (uint8_t mask : masks) {
+            REQUIRE(same_ids(gl.getNeighbourRange(side, wall, column, mask),
+                             gl.getNeighbourGIDs(side, wall, column, mask)));
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,217 @@
+// Catch
+#include "catch.hpp"
+
+// Standard library
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "falaise/snemo/processing/calo_waveform_features.h"
+
+namespace {
+using snemo::processing::calo_waveform_config;
+using snemo::processing::calo_waveform_features;
+
+/// Reference measurement: the scalar passes formerly run by udd2pcd_module
+calo_waveform_features reference_measurement(const std::vector<int16_t>& waveform,
+                                             const calo_waveform_config& config) {
+  calo_waveform_features f;
+
+  double baseline_sum = 0, baseline_sum2 = 0;
+  for (int sample = 0; sample < config.baseline_nsamples; sample++) {
+    const int16_t& waveform_sample = waveform[sample];
+    baseline_sum += waveform_sample;
+    baseline_sum2 += waveform_sample * waveform_sample;
+  }
+  f.baseline_adc_mean = baseline_sum / config.baseline_nsamples;
+  f.baseline_adc_sigma2 =
+      baseline_sum2 / config.baseline_nsamples - f.baseline_adc_mean * f.baseline_adc_mean;
+
+  int16_t min_amplitude_adc = INT16_MAX;
+  int16_t min_amplitude_sample = 0;
+  const int16_t nsamples = waveform.size();
+  for (int16_t sample = 0; sample < nsamples; sample++) {
+    const int16_t& waveform_sample = waveform[sample];
+    if (waveform_sample < min_amplitude_adc) {
+      min_amplitude_adc = waveform_sample;
+      min_amplitude_sample = sample;
+    }
+  }
+  f.peak_adc = min_amplitude_adc;
+  f.peak_sample = min_amplitude_sample;
+  f.amplitude_adc = min_amplitude_adc - f.baseline_adc_mean;
+
+  int16_t charge_sample_start = min_amplitude_sample - config.charge_integration_nsamples_before_peak;
+  if (charge_sample_start < 0) charge_sample_start = 0;
+  int16_t charge_sample_stop = charge_sample_start + config.charge_integration_nsamples;
+  if (charge_sample_stop > nsamples) charge_sample_stop = nsamples;
+  double charge_sum = 0;
+  for (int16_t sample = charge_sample_start; sample < charge_sample_stop; sample++) {
+    charge_sum += waveform[sample];
+  }
+  charge_sum -= (charge_sample_stop - charge_sample_start) * f.baseline_adc_mean;
+  f.charge_sample_start = charge_sample_start;
+  f.charge_sample_stop = charge_sample_stop;
+  f.charge_adc = charge_sum;
+
+  const double cfd_threshold_adc = f.baseline_adc_mean + config.cfd_ratio * f.amplitude_adc;
+  f.cfd_threshold_adc = cfd_threshold_adc;
+
+  int16_t sample_i = 0;
+  for (sample_i = min_amplitude_sample; sample_i > 0; sample_i--) {
+    if (waveform[sample_i] >= cfd_threshold_adc) break;
+  }
+  f.falling_cfd_sample = 0;
+  if (sample_i != (nsamples - 2)) {
+    const double sample_x1 = sample_i;
+    const double sample_x2 = sample_i + 1;
+    const double sample_y1 = waveform[sample_x1];
+    const double sample_y2 = waveform[sample_x2];
+    const double pol1_a = (sample_y2 - sample_y1) / (sample_x2 - sample_x1);
+    const double pol1_b = sample_y1 - pol1_a * sample_x1;
+    f.falling_cfd_sample = (cfd_threshold_adc - pol1_b) / pol1_a;
+  }
+
+  for (sample_i = min_amplitude_sample; sample_i < 1024; sample_i++) {
+    if (waveform[sample_i] >= cfd_threshold_adc) break;
+  }
+  f.rising_cfd_sample = 0;
+  if (sample_i < (1024 - 2)) {
+    const double sample_x1 = sample_i - 1;
+    const double sample_x2 = sample_i;
+    const double sample_y1 = waveform[sample_x1];
+    const double sample_y2 = waveform[sample_x2];
+    const double pol1_a = (sample_y2 - sample_y1) / (sample_x2 - sample_x1);
+    const double pol1_b = sample_y1 - pol1_a * sample_x1;
+    f.rising_cfd_sample = (cfd_threshold_adc - pol1_b) / pol1_a;
+  }
+  return f;
+}
+
+bool same_bits(double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; }
+
+void require_identical(const calo_waveform_features& a, const calo_waveform_features& b) {
+  REQUIRE(same_bits(a.baseline_adc_mean, b.baseline_adc_mean));
+  REQUIRE(same_bits(a.baseline_adc_sigma2, b.baseline_adc_sigma2));
+  REQUIRE(a.peak_adc == b.peak_adc);
+  REQUIRE(a.peak_sample == b.peak_sample);
+  REQUIRE(same_bits(a.amplitude_adc, b.amplitude_adc));
+  REQUIRE(a.charge_sample_start == b.charge_sample_start);
+  REQUIRE(a.charge_sample_stop == b.charge_sample_stop);
+  REQUIRE(same_bits(a.charge_adc, b.charge_adc));
+  REQUIRE(same_bits(a.cfd_threshold_adc, b.cfd_threshold_adc));
+  REQUIRE(same_bits(a.falling_cfd_sample, b.falling_cfd_sample));
+  REQUIRE(same_bits(a.rising_cfd_sample, b.rising_cfd_sample));
+}
+
+/// Negative pulse over a noisy baseline, as digitized by the calorimeter front-end
+std::vector<int16_t> make_pulse(std::mt19937& rng, int peak, double amplitude) {
+  std::normal_distribution<double> noise(0.0, 2.0);
+  std::vector<int16_t> waveform(1024);
+  for (int i = 0; i < 1024; i++) {
+    double value = 2048 + noise(rng);
+    if (i >= peak - 10) {
+      const double t = i - (peak - 10);
+      value -= amplitude * (t / 10.0) * std::exp(1.0 - t / 10.0);
+    }
+    waveform[i] = static_cast<int16_t>(std::lround(std::max(0.0, std::min(4095.0, value))));
+  }
+  return waveform;
+}
+}  // namespace
+
+TEST_CASE("Waveform kernels reproduce the scalar measurement", "[falaise][processing]") {
+  INFO("kernel: " << snemo::processing::calo_waveform_kernel_name());
+  const calo_waveform_config config;
+  std::mt19937 rng(8128);
+  std::uniform_int_distribution<int> peaks(20, 1000);
+  std::uniform_real_distribution<double> amplitudes(5.0, 2000.0);
+
+  std::vector<std::vector<int16_t>> waveforms;
+  for (int i = 0; i < 2000; i++) {
+    waveforms.push_back(make_pulse(rng, peaks(rng), amplitudes(rng)));
+  }
+  // Peaks at the edges of the window, saturation and repeated minima
+  waveforms.push_back(make_pulse(rng, 1020, 500.0));
+  waveforms.push_back(make_pulse(rng, 10, 3000.0));
+  std::vector<int16_t> saturated = make_pulse(rng, 400, 5000.0);
+  waveforms.push_back(saturated);
+  std::vector<int16_t> first = make_pulse(rng, 500, 300.0);
+  first[1] = -100;
+  first[700] = -100;
+  waveforms.push_back(first);
+  std::vector<int16_t> last = make_pulse(rng, 500, 300.0);
+  last[1023] = -200;
+  waveforms.push_back(last);
+  // Full int16 range
+  std::uniform_int_distribution<int> any(INT16_MIN, INT16_MAX);
+  for (int i = 0; i < 200; i++) {
+    std::vector<int16_t> waveform(1024);
+    for (auto& sample : waveform) sample = static_cast<int16_t>(any(rng));
+    waveforms.push_back(waveform);
+  }
+
+  for (const auto& waveform : waveforms) {
+    const calo_waveform_features expected = reference_measurement(waveform, config);
+    calo_waveform_features vectorized;
+    snemo::processing::measure_calo_waveform(waveform.data(), waveform.size(), config, vectorized);
+    calo_waveform_features scalar;
+    snemo::processing::measure_calo_waveform_scalar(waveform.data(), waveform.size(), config,
+                                                    scalar);
+    require_identical(expected, vectorized);
+    require_identical(expected, scalar);
+  }
+}
+
+TEST_CASE("Waveform kernel benchmark", "[.][benchmark]") {
+  const calo_waveform_config config;
+  std::mt19937 rng(4096);
+  std::uniform_int_distribution<int> peaks(100, 600);
+  std::uniform_real_distribution<double> amplitudes(20.0, 1500.0);
+  std::vector<std::vector<int16_t>> waveforms;
+  for (int i = 0; i < 712; i++) {
+    waveforms.push_back(make_pulse(rng, peaks(rng), amplitudes(rng)));
+  }
+
+  const size_t nloops = 200;
+  using clock = std::chrono::steady_clock;
+  auto timeMeasurement = [&](void (*measure)(const int16_t*, size_t, const calo_waveform_config&,
+                                             calo_waveform_features&)) -> double {
+    double sum = 0.0;
+    const clock::time_point start = clock::now();
+    for (size_t loop = 0; loop < nloops; loop++) {
+      for (const auto& waveform : waveforms) {
+        calo_waveform_features f;
+        measure(waveform.data(), waveform.size(), config, f);
+        sum += f.charge_adc + f.falling_cfd_sample;
+      }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    REQUIRE(sum != 0.0);
+    return elapsed.count() / (nloops * waveforms.size());
+  };
+  auto timeReference = [&]() -> double {
+    double sum = 0.0;
+    const clock::time_point start = clock::now();
+    for (size_t loop = 0; loop < nloops; loop++) {
+      for (const auto& waveform : waveforms) {
+        const calo_waveform_features f = reference_measurement(waveform, config);
+        sum += f.charge_adc + f.falling_cfd_sample;
+      }
+    }
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    REQUIRE(sum != 0.0);
+    return elapsed.count() / (nloops * waveforms.size());
+  };
+
+  std::cout << "former passes  : " << timeReference() << " ns/waveform" << std::endl;
+  std::cout << "scalar kernel  : " << timeMeasurement(snemo::processing::measure_calo_waveform_scalar)
+            << " ns/waveform" << std::endl;
+  std::cout << snemo::processing::calo_waveform_kernel_name() << " kernel    : "
+            << timeMeasurement(snemo::processing::measure_calo_waveform) << " ns/waveform"
+            << std::endl;
+}
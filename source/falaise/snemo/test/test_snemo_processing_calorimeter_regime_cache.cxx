@@ -0,0 +1,145 @@
+// Catch
+#include "catch.hpp"
+
+#include "falaise/property_set.h"
+#include "falaise/quantity.h"
+#include "falaise/snemo/geometry/config.h"
+#include "falaise/snemo/processing/calorimeter_regime.h"
+#include "falaise/snemo/processing/mock_calorimeter_s2c_module.h"
+
+#include "bayeux/datatools/clhep_units.h"
+#include "bayeux/datatools/multi_properties.h"
+#include "bayeux/datatools/properties.h"
+#include "bayeux/datatools/service_manager.h"
+#include "bayeux/datatools/units.h"
+#include "bayeux/datatools/utils.h"
+#include "bayeux/dpp/base_module.h"
+#include "bayeux/geomtools/geom_id.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+using regime_entry = std::pair<geomtools::geom_id, snemo::processing::CalorimeterModel::Parameters>;
+
+// Regimes of the database built as the module originally did, one property_set per entry
+std::vector<regime_entry> read_reference_regimes(const std::string& path) {
+  std::ifstream database(path);
+  REQUIRE(database);
+  std::string line;
+  std::getline(database, line);
+  std::vector<regime_entry> regimes;
+  while (std::getline(database, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::vector<std::string> fields;
+    std::istringstream lineStream(line);
+    std::string field;
+    while (std::getline(lineStream, field, '\t')) {
+      fields.push_back(field);
+    }
+    REQUIRE(fields.size() >= 6);
+    std::istringstream gidStream(fields[0]);
+    geomtools::geom_id gid;
+    gidStream >> gid;
+    if (gid.get_type() == 1302) {
+      gid.set_any(gid.get_depth());
+    }
+    datatools::properties::data::vdouble alphaQuenching(3, 0.0);
+    std::istringstream alphaStream(fields[4]);
+    for (double& par : alphaQuenching) {
+      alphaStream >> par;
+    }
+    falaise::property_set ps;
+    ps.put("energy.resolution",
+           falaise::fraction_t{
+               datatools::units::get_value_with_unit(fields[1]) / CLHEP::perCent, "%"});
+    ps.put("energy.high_threshold",
+           falaise::energy_t{datatools::units::get_value_with_unit(fields[2]) / CLHEP::keV, "keV"});
+    ps.put("energy.low_threshold",
+           falaise::energy_t{datatools::units::get_value_with_unit(fields[3]) / CLHEP::keV, "keV"});
+    ps.put("alpha_quenching_parameters", alphaQuenching);
+    ps.put("scintillator_relaxation_time",
+           falaise::time_t{datatools::units::get_value_with_unit(fields[5]) / CLHEP::ns, "ns"});
+    regimes.emplace_back(gid, snemo::processing::CalorimeterModel{ps}.getParameters());
+  }
+  return regimes;
+}
+
+bool same_parameters(const snemo::processing::CalorimeterModel::Parameters& a,
+                     const snemo::processing::CalorimeterModel::Parameters& b) {
+  return a.energyResolution == b.energyResolution &&
+         a.highEnergyThreshold == b.highEnergyThreshold &&
+         a.lowEnergyThreshold == b.lowEnergyThreshold &&
+         a.alphaQuenching[0] == b.alphaQuenching[0] &&
+         a.alphaQuenching[1] == b.alphaQuenching[1] &&
+         a.alphaQuenching[2] == b.alphaQuenching[2] && a.relaxationTime == b.relaxationTime;
+}
+
+size_t count_cache_files(const std::string& directory) {
+  size_t count = 0;
+  for (boost::filesystem::directory_iterator it(directory), end; it != end; ++it) {
+    count += it->path().extension() == ".bin";
+  }
+  return count;
+}
+}  // namespace
+
+TEST_CASE("OM lookup and regime cache give the models of the database", "") {
+  datatools::service_manager services{};
+  datatools::multi_properties config;
+  config.set_key_label("name");
+  config.set_meta_label("type");
+  config.add_section("geometry", "geomtools::geometry_service")
+      .store_path("manager.configuration_file", snemo::geometry::default_geometry_tag());
+  services.load(config);
+  services.initialize();
+
+  std::string databasePath =
+      "@falaise:snemo/demonstrator/reconstruction/db/calorimeter_regime_database_v0.db";
+  datatools::fetch_path_with_env(databasePath);
+  const std::vector<regime_entry> reference = read_reference_regimes(databasePath);
+  REQUIRE(!reference.empty());
+
+  const std::string cacheDirectory{"test_snemo_processing_calorimeter_regime_cache.d"};
+  boost::filesystem::remove_all(cacheDirectory);
+  boost::filesystem::create_directories(cacheDirectory);
+
+  datatools::properties moduleConfig;
+  moduleConfig.store_string("calorimeter_regime_database_path", databasePath);
+  datatools::properties cachedConfig{moduleConfig};
+  cachedConfig.store_string("calorimeter_regime_cache_directory", cacheDirectory);
+  dpp::module_handle_dict_type noModules;
+
+  // Database path, first job writing the cache, next job reading it
+  snemo::processing::mock_calorimeter_s2c_module fromDatabase;
+  fromDatabase.initialize(moduleConfig, services, noModules);
+  REQUIRE(count_cache_files(cacheDirectory) == 0);
+  snemo::processing::mock_calorimeter_s2c_module writingCache;
+  writingCache.initialize(cachedConfig, services, noModules);
+  REQUIRE(count_cache_files(cacheDirectory) == 1);
+  snemo::processing::mock_calorimeter_s2c_module readingCache;
+  readingCache.initialize(cachedConfig, services, noModules);
+  REQUIRE(count_cache_files(cacheDirectory) == 1);
+
+  for (const regime_entry& entry : reference) {
+    const geomtools::geom_id& gid = entry.first;
+    INFO("geom_id " << gid);
+    REQUIRE(same_parameters(fromDatabase.get_calorimeter_regime(gid).getParameters(), entry.second));
+    REQUIRE(same_parameters(writingCache.get_calorimeter_regime(gid).getParameters(), entry.second));
+    REQUIRE(same_parameters(readingCache.get_calorimeter_regime(gid).getParameters(), entry.second));
+  }
+
+  // IDs without regime are still rejected
+  geomtools::geom_id unknown = reference.front().first;
+  unknown.set(0, 99);
+  REQUIRE_THROWS(readingCache.get_calorimeter_regime(unknown));
+
+  boost::filesystem::remove_all(cacheDirectory);
+}
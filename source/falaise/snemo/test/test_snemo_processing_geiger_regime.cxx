@@ -0,0 +1,140 @@
+// Catch
+#include "catch.hpp"
+
+// Standard library
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "falaise/snemo/processing/geiger_regime.h"
+
+#include "bayeux/datatools/clhep_units.h"
+#include "bayeux/datatools/properties.h"
+#include "bayeux/mygsl/rng.h"
+
+namespace {
+snemo::processing::geiger_regime makeRegime(bool lookupTables) {
+  datatools::properties config;
+  config.store_boolean("drift_lookup_tables", lookupTables);
+  return snemo::processing::geiger_regime{config};
+}
+}  // namespace
+
+TEST_CASE("Drift radius table agrees with the analytic relation", "[falaise][processing]") {
+  const snemo::processing::geiger_regime tabulated = makeRegime(true);
+  const snemo::processing::geiger_regime analytic = makeRegime(false);
+  REQUIRE(tabulated.isUsingLookupTables());
+  REQUIRE_FALSE(analytic.isUsingLookupTables());
+
+  const double bound = tabulated.getDriftRadiusTableError();
+  REQUIRE(bound <= 1.0 * CLHEP::micrometer);
+
+  // Dense scan of the calibrated times, with both sides of the transition time
+  const double tCut = tabulated.getMaximumDriftTime();
+  const double tTransition = tabulated.getDriftTimeForCellRadius();
+  std::vector<double> times{tTransition, std::nextafter(tTransition, tCut)};
+  const size_t nscan = 200000;
+  for (size_t i = 0; i < nscan; i++) {
+    times.push_back(tCut * i / nscan);
+  }
+
+  double maxError = 0.0;
+  double maxSigmaError = 0.0;
+  for (double t : times) {
+    double r1 = 0.0;
+    double sr1 = 0.0;
+    double r2 = 0.0;
+    double sr2 = 0.0;
+    tabulated.calibrateRadiusFromTime(t, r1, sr1);
+    analytic.calibrateRadiusFromTime(t, r2, sr2);
+    maxError = std::max(maxError, std::abs(r1 - r2));
+    maxSigmaError = std::max(maxSigmaError, std::abs(sr1 - sr2));
+  }
+  INFO("max error = " << maxError / CLHEP::micrometer << " um, bound = "
+                      << bound / CLHEP::micrometer << " um");
+  REQUIRE(maxError <= 1.001 * bound + 1e-9 * CLHEP::mm);
+  REQUIRE(maxSigmaError <= 1.0e-3 * CLHEP::mm);
+}
+
+TEST_CASE("Mean drift time table agrees with the tabulated relation", "[falaise][processing]") {
+  const snemo::processing::geiger_regime tabulated = makeRegime(true);
+  const snemo::processing::geiger_regime analytic = makeRegime(false);
+
+  const double bound = tabulated.getMeanDriftTimeTableError();
+  REQUIRE(bound <= 1.0 * CLHEP::ns);
+
+  // Radii up to the last point of the radius->time function
+  const double rMax = analytic.getDriftRadius(tabulated.getMaximumDriftTime());
+  const size_t nscan = 200000;
+  double maxError = 0.0;
+  for (size_t i = 0; i <= nscan; i++) {
+    const double r = rMax * i / nscan;
+    maxError = std::max(maxError, std::abs(tabulated.getMeanDriftTime(r) -
+                                           analytic.getMeanDriftTime(r)));
+  }
+  INFO("max error = " << maxError / CLHEP::ns << " ns, bound = " << bound / CLHEP::ns << " ns");
+  REQUIRE(maxError <= 1.001 * bound + 1e-9 * CLHEP::ns);
+
+  // Randomized drift times follow the tables within their error
+  mygsl::rng ran1("mt19937", 314159);
+  mygsl::rng ran2("mt19937", 314159);
+  const double rDiagonal = tabulated.getMaximumRadius();
+  double maxRandomError = 0.0;
+  for (size_t i = 0; i <= 10000; i++) {
+    const double r = rDiagonal * i / 10000;
+    maxRandomError = std::max(maxRandomError, std::abs(tabulated.getRandomTimeGivenRadius(ran1, r) -
+                                                       analytic.getRandomTimeGivenRadius(ran2, r)));
+  }
+  // Gaussian smearing scales the mean and width errors by a few units
+  REQUIRE(maxRandomError <= 20.0 * bound + 1e-6 * CLHEP::ns);
+}
+
+TEST_CASE("Drift relation lookup benchmark", "[.][benchmark]") {
+  const snemo::processing::geiger_regime tabulated = makeRegime(true);
+  const snemo::processing::geiger_regime analytic = makeRegime(false);
+
+  const size_t ncalls = 2000000;
+  std::mt19937 rng(271828);
+  std::uniform_real_distribution<double> flat(0.0, 1.0);
+  std::vector<double> times(ncalls);
+  std::vector<double> radii(ncalls);
+  for (size_t i = 0; i < ncalls; i++) {
+    times[i] = flat(rng) * tabulated.getMaximumDriftTime();
+    radii[i] = flat(rng) * tabulated.getMaximumRadius();
+  }
+
+  using clock = std::chrono::steady_clock;
+  auto timeCalibration = [&](const snemo::processing::geiger_regime& regime) {
+    double sum = 0.0;
+    const clock::time_point start = clock::now();
+    for (double t : times) {
+      double r = 0.0;
+      double sr = 0.0;
+      regime.calibrateRadiusFromTime(t, r, sr);
+      sum += r + sr;
+    }
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    REQUIRE(sum > 0.0);
+    return elapsed.count() / ncalls;
+  };
+  auto timeDigitization = [&](const snemo::processing::geiger_regime& regime) {
+    mygsl::rng ran("mt19937", 314159);
+    double sum = 0.0;
+    const clock::time_point start = clock::now();
+    for (double r : radii) {
+      sum += regime.getRandomTimeGivenRadius(ran, r);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    REQUIRE(sum > 0.0);
+    return elapsed.count() / ncalls;
+  };
+
+  std::cout << "calibrateRadiusFromTime  : " << timeCalibration(analytic) << " ns/call (analytic), "
+            << timeCalibration(tabulated) << " ns/call (tables)" << std::endl;
+  std::cout << "getRandomTimeGivenRadius : " << timeDigitization(analytic)
+            << " ns/call (analytic), " << timeDigitization(tabulated) << " ns/call (tables)"
+            << std::endl;
+}
@@ -0,0 +1,164 @@
+// Catch
+#include "catch.hpp"
+
+// Standard library
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "falaise/snemo/processing/detail/tracker_hit_clustering.h"
+
+namespace {
+using snemo::processing::detail::cluster_cell;
+using snemo::processing::detail::make_tracker_hit_clusters;
+using snemo::processing::detail::tracker_cell_grid;
+
+using cluster_list = std::vector<std::vector<int>>;
+
+/// Reference clusterisation: the loop formerly run by udd2pcd_module, comparing each
+/// hit with the hits of every existing cluster and merging the matching clusters
+cluster_list reference_clusters(const std::vector<cluster_cell>& cells, double radius2_threshold,
+                                double deltat_threshold) {
+  cluster_list clusters;
+  for (size_t hit_index = 0; hit_index < cells.size(); hit_index++) {
+    const cluster_cell& hit = cells[hit_index];
+    std::vector<size_t> matching_cluster_indexes;
+    for (size_t cluster_index = 0; cluster_index < clusters.size(); cluster_index++) {
+      for (const int& cluster_hit_index : clusters[cluster_index]) {
+        const cluster_cell& cluster_hit = cells[cluster_hit_index];
+        if (hit.side != cluster_hit.side) continue;
+        const int delta_row = cluster_hit.row - hit.row;
+        const int delta_layer = cluster_hit.layer - hit.layer;
+        const float delta_radius = delta_row * delta_row + delta_layer * delta_layer;
+        if (delta_radius > radius2_threshold) continue;
+        const double delta_anode_time = cluster_hit.anode_time - hit.anode_time;
+        if (std::abs(delta_anode_time) > deltat_threshold) continue;
+        matching_cluster_indexes.push_back(cluster_index);
+        break;
+      }
+    }
+    if (matching_cluster_indexes.empty()) {
+      clusters.push_back(std::vector<int>{static_cast<int>(hit_index)});
+    } else {
+      const size_t matching_cluster_index = matching_cluster_indexes.front();
+      clusters[matching_cluster_index].push_back(hit_index);
+      for (size_t cluster_i = matching_cluster_indexes.size() - 1; cluster_i > 0; --cluster_i) {
+        const size_t cluster_index = matching_cluster_indexes[cluster_i];
+        for (const int& tracker_index : clusters[cluster_index]) {
+          clusters[matching_cluster_index].push_back(tracker_index);
+        }
+        clusters.erase(clusters.begin() + cluster_index);
+      }
+    }
+  }
+  // The hits are listed in increasing order by make_tracker_hit_clusters
+  for (auto& cluster : clusters) {
+    std::sort(cluster.begin(), cluster.end());
+  }
+  return clusters;
+}
+
+/// Hits in a small region of the tracker, so that clusters are frequent, with
+/// integer anode times so that time differences can equal the threshold, and
+/// some addresses outside the tracker grid
+std::vector<cluster_cell> random_cells(std::mt19937& rng, size_t nhits, double outlier_fraction) {
+  std::uniform_int_distribution<uint32_t> side(0, tracker_cell_grid::NSIDES - 1);
+  std::uniform_int_distribution<uint32_t> layer(0, tracker_cell_grid::NLAYERS - 1);
+  std::uniform_int_distribution<uint32_t> row(40, 70);
+  std::uniform_int_distribution<int> time(0, 40);
+  std::bernoulli_distribution outlier(outlier_fraction);
+  std::uniform_int_distribution<int> outlier_kind(0, 2);
+  std::vector<cluster_cell> cells(nhits);
+  for (auto& cell : cells) {
+    cell.side = side(rng);
+    cell.layer = layer(rng);
+    cell.row = row(rng);
+    cell.anode_time = time(rng);
+    if (outlier(rng)) {
+      switch (outlier_kind(rng)) {
+        case 0:
+          cell.side = tracker_cell_grid::NSIDES;
+          break;
+        case 1:
+          cell.layer = tracker_cell_grid::NLAYERS + 1;
+          break;
+        default:
+          cell.row = tracker_cell_grid::NROWS + 50;
+      }
+    }
+  }
+  return cells;
+}
+}  // namespace
+
+TEST_CASE("Cell grid numbering", "") {
+  using grid = tracker_cell_grid;
+  REQUIRE(grid::NCELLS == 2034);
+  REQUIRE(grid::index(0, 0, 0) == 0);
+  REQUIRE(grid::index(0, 0, 1) == 1);
+  REQUIRE(grid::index(0, 1, 0) == grid::NROWS);
+  REQUIRE(grid::index(1, 0, 0) == grid::NLAYERS * grid::NROWS);
+  REQUIRE(grid::index(1, 8, 112) == grid::NCELLS - 1);
+  REQUIRE(grid::contains(1, 8, 112));
+  REQUIRE_FALSE(grid::contains(2, 0, 0));
+  REQUIRE_FALSE(grid::contains(0, 9, 0));
+  REQUIRE_FALSE(grid::contains(0, 0, 113));
+}
+
+TEST_CASE("Clusters match the original loop", "") {
+  std::mt19937 rng(123456);
+  // Exact squared distances and a time difference equal to the threshold are kept
+  const double radius_thresholds[] = {1.0, std::sqrt(2.0), 2.0, 3.0, 200.0};
+  const double deltat_thresholds[] = {0.0, 5.0, 15.0};
+  // Around the 32 hits below which all pairs are compared
+  const size_t nhits_values[] = {0, 1, 2, 5, 31, 32, 33, 60, 150, 400};
+  for (double radius : radius_thresholds) {
+    for (double deltat : deltat_thresholds) {
+      for (size_t nhits : nhits_values) {
+        for (double outliers : {0.0, 0.1}) {
+          for (int trial = 0; trial < 5; trial++) {
+            const std::vector<cluster_cell> cells = random_cells(rng, nhits, outliers);
+            const double radius2 = radius * radius;
+            REQUIRE(make_tracker_hit_clusters(cells, radius2, deltat) ==
+                    reference_clusters(cells, radius2, deltat));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Neighbours exactly at the thresholds are clustered", "") {
+  // Hits on a line of rows, 3 rows apart, anode times 15 apart
+  std::vector<cluster_cell> cells;
+  for (uint32_t ihit = 0; ihit < 40; ihit++) {
+    cells.push_back(cluster_cell{0, 4, 3 * ihit, 15.0 * ihit});
+  }
+  REQUIRE(make_tracker_hit_clusters(cells, 9.0, 15.0).size() == 1);
+  REQUIRE(make_tracker_hit_clusters(cells, 9.0, 14.9).size() == cells.size());
+  REQUIRE(make_tracker_hit_clusters(cells, 8.9, 15.0).size() == cells.size());
+  REQUIRE(make_tracker_hit_clusters(cells, 9.0, 15.0) == reference_clusters(cells, 9.0, 15.0));
+
+  // Diagonal neighbours at a squared distance of 2, in reverse order of the hits
+  std::vector<cluster_cell> diagonal;
+  for (uint32_t ihit = 0; ihit < 40; ihit++) {
+    diagonal.push_back(cluster_cell{1, 8 - ihit % 9, 100 - ihit, 0.0});
+  }
+  REQUIRE(make_tracker_hit_clusters(diagonal, 2.0, 0.0) == reference_clusters(diagonal, 2.0, 0.0));
+}
+
+TEST_CASE("Hits outside the cell grid are compared with all hits", "") {
+  std::vector<cluster_cell> cells;
+  for (uint32_t ihit = 0; ihit < 40; ihit++) {
+    cells.push_back(cluster_cell{ihit % 2, 0, 10 * ihit, 0.0});
+  }
+  // Hits in and next to the cell of the hit in row 120 of side 0, outside the grid
+  cells.push_back(cluster_cell{0, 0, 120, 0.0});
+  cells.push_back(cluster_cell{0, 0, 121, 0.0});
+  const cluster_list clusters = make_tracker_hit_clusters(cells, 1.0, 1.0);
+  REQUIRE(clusters == reference_clusters(cells, 1.0, 1.0));
+  REQUIRE(clusters.size() == 40);
+  REQUIRE(clusters[12] == std::vector<int>{12, 40, 41});
+}
@@ -0,0 +1,129 @@
+// Catch
+#include "catch.hpp"
+
+#include "falaise/snemo/datamodels/data_model.h"
+#include "falaise/snemo/datamodels/event_header.h"
+#include "falaise/snemo/datamodels/precalibrated_data.h"
+#include "falaise/snemo/datamodels/unified_digitized_data.h"
+#include "falaise/snemo/processing/udd2pcd_module.h"
+
+#include "bayeux/datatools/properties.h"
+#include "bayeux/datatools/service_manager.h"
+#include "bayeux/datatools/things.h"
+#include "bayeux/dpp/base_module.h"
+#include "bayeux/geomtools/geom_id.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+namespace sdm = snemo::datamodel;
+
+// Event with negative pulses of random shape over a noisy baseline, some of them
+// below the discard threshold and without trigger flags
+void fill_event(datatools::things& event, std::mt19937& rng, size_t nhits) {
+  event.add<sdm::event_header>(snedm::labels::event_header());
+  auto& udd = event.add<sdm::unified_digitized_data>(snedm::labels::unified_digitized_data());
+  std::uniform_int_distribution<int> noise(-3, 3);
+  std::uniform_int_distribution<int> peakSample(40, 900);
+  std::uniform_int_distribution<int> width(5, 80);
+  std::uniform_int_distribution<int> amplitude(0, 800);
+  std::uniform_int_distribution<int> flags(0, 3);
+  for (size_t ihit = 0; ihit < nhits; ihit++) {
+    sdm::calorimeter_digitized_hit& hit = udd.add_calorimeter_hit();
+    hit.set_geom_id(geomtools::geom_id(1302, ihit % 2, ihit % 20, ihit % 13));
+    hit.set_timestamp(1234567 + ihit);
+    std::vector<int16_t>& wf = hit.grab_waveform();
+    wf.assign(1024, 0);
+    const int peak = peakSample(rng);
+    const int sigma = width(rng);
+    const int height = amplitude(rng);
+    for (int sample = 0; sample < 1024; sample++) {
+      const int distance = sample - peak;
+      wf[sample] = 2048 + noise(rng) - height * sigma * sigma / (sigma * sigma + distance * distance);
+    }
+    const int flag = flags(rng);
+    hit.set_high_threshold(flag == 1);
+    hit.set_low_threshold_only(flag == 2);
+    hit.set_fwmeas_peak_amplitude(-8 * height);
+  }
+}
+
+sdm::PreCalibratedCalorimeterHitHdlCollection precalibrate(datatools::things& event, int nthreads,
+                                                          const std::string& method = "swmeas") {
+  datatools::properties config;
+  config.store_string("calo_method", method);
+  config.store_boolean("calo_discard_empty_waveform", true);
+  config.store_integer("calo.parallel_threads", nthreads);
+  datatools::service_manager services;
+  dpp::module_handle_dict_type modules;
+
+  snemo::processing::udd2pcd_module udd2pcd;
+  udd2pcd.initialize(config, services, modules);
+  REQUIRE(udd2pcd.process(event) == dpp::base_module::PROCESS_SUCCESS);
+  udd2pcd.reset();
+  return event.get<sdm::precalibrated_data>(snedm::labels::precalibrated_data()).calorimeter_hits();
+}
+
+void check_identical(const sdm::PreCalibratedCalorimeterHitHdlCollection& sequential,
+                     const sdm::PreCalibratedCalorimeterHitHdlCollection& parallel) {
+  REQUIRE(parallel.size() == sequential.size());
+  for (size_t ihit = 0; ihit < sequential.size(); ihit++) {
+    const auto& a = sequential[ihit].get();
+    const auto& b = parallel[ihit].get();
+    REQUIRE(b.get_hit_id() == a.get_hit_id());
+    REQUIRE(b.get_geom_id() == a.get_geom_id());
+    REQUIRE(b.get_baseline() == a.get_baseline());
+    REQUIRE(b.get_sigma_baseline() == a.get_sigma_baseline());
+    REQUIRE(b.get_amplitude() == a.get_amplitude());
+    REQUIRE(b.get_sigma_amplitude() == a.get_sigma_amplitude());
+    REQUIRE(b.get_charge() == a.get_charge());
+    REQUIRE(b.get_sigma_charge() == a.get_sigma_charge());
+    REQUIRE(b.get_time() == a.get_time());
+    REQUIRE(b.get_time_cfd() == a.get_time_cfd());
+    REQUIRE(b.get_pulse_width() == a.get_pulse_width());
+  }
+}
+}  // namespace
+
+TEST_CASE("Parallel swmeas precalibration matches the sequential one", "") {
+  std::mt19937 rng(20221);
+  for (size_t nhits : {0, 1, 2, 7, 150}) {
+    datatools::things sequentialEvent;
+    fill_event(sequentialEvent, rng, nhits);
+    datatools::things parallelEvent;
+    parallelEvent.add<sdm::event_header>(snedm::labels::event_header());
+    parallelEvent.add<sdm::unified_digitized_data>(snedm::labels::unified_digitized_data()) =
+        sequentialEvent.get<sdm::unified_digitized_data>(snedm::labels::unified_digitized_data());
+
+    const auto sequential = precalibrate(sequentialEvent, 1);
+    // Discarded hits leave no hole in the output
+    REQUIRE(sequential.size() <= nhits);
+    for (int nthreads : {2, 4, 7}) {
+      check_identical(sequential, precalibrate(parallelEvent, nthreads));
+    }
+  }
+}
+
+TEST_CASE("Parallel threads are ignored by the fwmeas precalibration", "") {
+  std::mt19937 rng(4096);
+  datatools::things sequentialEvent;
+  fill_event(sequentialEvent, rng, 20);
+  datatools::things parallelEvent;
+  parallelEvent.add<sdm::event_header>(snedm::labels::event_header());
+  parallelEvent.add<sdm::unified_digitized_data>(snedm::labels::unified_digitized_data()) =
+      sequentialEvent.get<sdm::unified_digitized_data>(snedm::labels::unified_digitized_data());
+
+  check_identical(precalibrate(sequentialEvent, 1, "fwmeas"),
+                  precalibrate(parallelEvent, 4, "fwmeas"));
+}
+
+TEST_CASE("Invalid numbers of parallel threads are rejected", "") {
+  datatools::things event;
+  std::mt19937 rng(1);
+  fill_event(event, rng, 1);
+  REQUIRE_THROWS(precalibrate(event, 0));
+  REQUIRE_THROWS(precalibrate(event, -2));
+}
@@ -0,0 +1,104 @@
+// Catch
+#include "catch.hpp"
+
+#include "falaise/snemo/simulation/detail/gg_ionization.h"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+// Reference selection of gg_step_hit_processor when ionizations are shot one by one
+size_t scalar_closest_ionization(const std::vector<double>& fraction, const double* start,
+                                 const double* step, double radius, double length) {
+  size_t closest = fraction.size();
+  double min_drift_distance = std::numeric_limits<double>::quiet_NaN();
+  for (size_t i = 0; i < fraction.size(); i++) {
+    const double x = start[0] + fraction[i] * step[0];
+    const double y = start[1] + fraction[i] * step[1];
+    const double z = start[2] + fraction[i] * step[2];
+    const double drift_distance = std::hypot(x, y);
+    if (!std::isnan(radius) && drift_distance > radius) {
+      continue;
+    }
+    if (!std::isnan(length) && std::abs(z) > 0.5 * length) {
+      continue;
+    }
+    if (std::isnan(min_drift_distance) || drift_distance < min_drift_distance) {
+      min_drift_distance = drift_distance;
+      closest = i;
+    }
+  }
+  return closest;
+}
+
+size_t batched_closest_ionization(const std::vector<double>& fraction, const double* start,
+                                  const double* step, double radius, double length) {
+  const double infinity = std::numeric_limits<double>::infinity();
+  const double max_drift2 = std::isnan(radius) ? infinity : radius * radius;
+  const double max_abs_z = std::isnan(length) ? infinity : 0.5 * length;
+  std::vector<double> drift2(fraction.size());
+  return snemo::simulation::detail::find_closest_ionization(
+      fraction.size(), fraction.data(), start, step, max_drift2, max_abs_z, drift2.data());
+}
+}  // namespace
+
+TEST_CASE("Batched and scalar selections agree on random steps", "") {
+  std::mt19937_64 rng(20211106);
+  std::uniform_real_distribution<double> position(-25.0, 25.0);
+  std::uniform_real_distribution<double> height(-1600.0, 1600.0);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::poisson_distribution<int> ionizations(8.0);
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  for (int istep = 0; istep < 10000; istep++) {
+    const double start[3] = {position(rng), position(rng), height(rng)};
+    const double stop[3] = {position(rng), position(rng), height(rng)};
+    const double step[3] = {stop[0] - start[0], stop[1] - start[1], stop[2] - start[2]};
+    std::vector<double> fraction(ionizations(rng));
+    for (double& f : fraction) {
+      f = uniform(rng);
+    }
+    // With and without the fiducial cuts
+    for (double radius : {nan, 22.0}) {
+      for (double length : {nan, 2900.0}) {
+        REQUIRE(batched_closest_ionization(fraction, start, step, radius, length) ==
+                scalar_closest_ionization(fraction, start, step, radius, length));
+      }
+    }
+  }
+}
+
+TEST_CASE("Ionizations on the fiducial boundaries are accepted", "") {
+  // All ionizations at 5 mm from the wire (3-4-5 triangle), z = 0 to 10 mm
+  const double start[3] = {3.0, 4.0, 0.0};
+  const double step[3] = {0.0, 0.0, 10.0};
+  const std::vector<double> fraction{0.25, 0.5, 1.0};
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  // d2 == r2: accepted, the first of equally close ionizations wins
+  REQUIRE(batched_closest_ionization(fraction, start, step, 5.0, nan) == 0);
+  REQUIRE(scalar_closest_ionization(fraction, start, step, 5.0, nan) == 0);
+  // Just inside the boundary: all rejected
+  const double inside = std::nextafter(5.0, 0.0);
+  REQUIRE(batched_closest_ionization(fraction, start, step, inside, nan) == fraction.size());
+  REQUIRE(scalar_closest_ionization(fraction, start, step, inside, nan) == fraction.size());
+
+  // |z| == length / 2 for the last ionization only
+  REQUIRE(batched_closest_ionization({1.0}, start, step, nan, 20.0) == 0);
+  REQUIRE(scalar_closest_ionization({1.0}, start, step, nan, 20.0) == 0);
+  REQUIRE(batched_closest_ionization({1.0}, start, step, nan, 19.999) == 1);
+  REQUIRE(scalar_closest_ionization({1.0}, start, step, nan, 19.999) == 1);
+
+  // A closer ionization after rejected ones wins
+  const double crossing[3] = {-6.0, 1.0, 0.0};
+  const double across[3] = {12.0, 0.0, 0.0};
+  const std::vector<double> line{0.0, 0.25, 0.5, 0.75, 1.0};
+  REQUIRE(batched_closest_ionization(line, crossing, across, 5.0, nan) == 2);
+  REQUIRE(scalar_closest_ionization(line, crossing, across, 5.0, nan) == 2);
+
+  // Empty batch
+  REQUIRE(batched_closest_ionization({}, start, step, 5.0, 20.0) == 0);
+}
@@ -0,0 +1,88 @@
+#include "catch.hpp"
+
+#include "falaise/async_writer.h"
+#include "falaise/snemo/processing/module.h"
+
+#include "bayeux/datatools/properties.h"
+#include "bayeux/datatools/service_manager.h"
+
+#include <memory>
+
+namespace flp = falaise::processing;
+
+// Output sink checking the order of the written records
+class RecordingSink {
+ public:
+  RecordingSink() = default;
+  RecordingSink(falaise::property_set const& ps, datatools::service_manager& /*unused*/)
+      : failAt(ps.get<int>("fail_at", -1)) {}
+
+  flp::status process(datatools::things& data) {
+    int index = data.get<datatools::properties>("index").fetch_integer("value");
+    if (index == failAt || index != expected) {
+      return flp::status::PROCESS_ERROR;
+    }
+    expected++;
+    return flp::status::PROCESS_OK;
+  }
+
+ private:
+  int failAt = -1;
+  int expected = 0;
+};
+FALAISE_REGISTER_MODULE(RecordingSink)
+
+namespace {
+std::unique_ptr<datatools::things> make_record(int index) {
+  std::unique_ptr<datatools::things> record{new datatools::things};
+  auto& bank = record->add<datatools::properties>("index");
+  bank.store_integer("value", index);
+  return record;
+}
+}  // namespace
+
+TEST_CASE("Records are written in submission order", "") {
+  flp::module<RecordingSink> sink;
+  datatools::properties config{};
+  datatools::service_manager services{};
+  dpp::module_handle_dict_type modules{};
+  sink.initialize(config, services, modules);
+
+  const int N = 1000;
+  falaise::async_writer writer{sink, 4};
+  REQUIRE(writer.capacity() == 4);
+  for (int i = 0; i < N; ++i) {
+    REQUIRE(writer.write(make_record(i)));
+  }
+  REQUIRE(writer.finish());
+  REQUIRE_FALSE(writer.has_failed());
+  REQUIRE(writer.written() == N);
+  REQUIRE(writer.error_message().empty());
+
+  // No more records once finished
+  REQUIRE_FALSE(writer.write(make_record(N)));
+}
+
+TEST_CASE("Output failure is reported at shutdown", "") {
+  flp::module<RecordingSink> sink;
+  datatools::properties config{};
+  config.store_integer("fail_at", 10);
+  datatools::service_manager services{};
+  dpp::module_handle_dict_type modules{};
+  sink.initialize(config, services, modules);
+
+  falaise::async_writer writer{sink, 2};
+  int accepted = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (!writer.write(make_record(i))) {
+      break;
+    }
+    accepted++;
+  }
+  REQUIRE_FALSE(writer.finish());
+  REQUIRE(writer.has_failed());
+  REQUIRE(writer.written() == 10);
+  REQUIRE_FALSE(writer.error_message().empty());
+  // The producer is stopped shortly after the failure
+  REQUIRE(accepted < 100);
+}
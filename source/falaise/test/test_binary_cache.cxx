@@ -0,0 +1,82 @@
+#include "catch.hpp"
+
+#include "falaise/binary_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("FNV-1a hash matches the reference values", "") {
+  // Reference values of the 64-bit FNV-1a specification
+  REQUIRE(falaise::fnv1a_hash{}.value() == 0xcbf29ce484222325ULL);
+  falaise::fnv1a_hash a;
+  a.add("a", 1);
+  REQUIRE(a.value() == 0xaf63dc4c8601ec8cULL);
+
+  // Strings are separated
+  falaise::fnv1a_hash ab_c;
+  ab_c.add(std::string{"ab"});
+  ab_c.add(std::string{"c"});
+  falaise::fnv1a_hash a_bc;
+  a_bc.add(std::string{"a"});
+  a_bc.add(std::string{"bc"});
+  REQUIRE(ab_c.value() != a_bc.value());
+}
+
+TEST_CASE("Files are written atomically and mapped back", "") {
+  const std::string path{"test_binary_cache.bin"};
+  std::remove(path.c_str());
+
+  falaise::write_file_atomically(path, [](std::ostream& out) { out << "0123456789"; });
+  {
+    falaise::mapped_file file{path};
+    REQUIRE(file.data() != nullptr);
+    REQUIRE(file.size() == 10);
+    REQUIRE(std::string(file.data(), file.size()) == "0123456789");
+  }
+
+  // A failing writer leaves the previous file untouched and no temporary file
+  REQUIRE_THROWS_AS(falaise::write_file_atomically(path,
+                                                   [](std::ostream& out) {
+                                                     out << "partial";
+                                                     throw std::runtime_error("failure");
+                                                   }),
+                    std::runtime_error);
+  {
+    falaise::mapped_file file{path};
+    REQUIRE(std::string(file.data(), file.size()) == "0123456789");
+  }
+
+  // Missing file
+  falaise::mapped_file missing{path + ".missing"};
+  REQUIRE(missing.data() == nullptr);
+  REQUIRE(missing.size() == 0);
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("File identity follows the file content", "") {
+  const std::string path{"test_binary_cache_identity.txt"};
+  {
+    std::ofstream out(path);
+    out << "first version\n";
+  }
+  falaise::fnv1a_hash first;
+  first.add_file(path);
+  falaise::fnv1a_hash same;
+  same.add_file(path);
+  REQUIRE(first.value() == same.value());
+
+  {
+    std::ofstream out(path, std::ios::app);
+    out << "edited\n";
+  }
+  falaise::fnv1a_hash edited;
+  edited.add_file(path);
+  REQUIRE(edited.value() != first.value());
+
+  REQUIRE(falaise::cache_file_path("/tmp", "bfield", 0x2a, ".bmap") ==
+          "/tmp/bfield-000000000000002a.bmap");
+  std::remove(path.c_str());
+}
@@ -0,0 +1,80 @@
+#include "catch.hpp"
+
+#include "falaise/bounded_queue.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Zero capacity is rejected", "") {
+  REQUIRE_THROWS_AS(falaise::bounded_queue<int>{0}, std::invalid_argument);
+}
+
+TEST_CASE("Single thread FIFO semantics", "") {
+  falaise::bounded_queue<int> q{3};
+  REQUIRE(q.capacity() == 3);
+  REQUIRE(q.size() == 0);
+
+  REQUIRE(q.push(1));
+  REQUIRE(q.push(2));
+  REQUIRE(q.size() == 2);
+
+  int x = 0;
+  REQUIRE(q.pop(x));
+  REQUIRE(x == 1);
+  REQUIRE(q.pop(x));
+  REQUIRE(x == 2);
+  REQUIRE(q.size() == 0);
+}
+
+TEST_CASE("Closed queue drains then reports end", "") {
+  falaise::bounded_queue<int> q{2};
+  REQUIRE(q.push(42));
+  q.close();
+  REQUIRE(q.is_closed());
+
+  // No more pushes
+  REQUIRE_FALSE(q.push(3));
+
+  // Remaining items are still delivered
+  int x = 0;
+  REQUIRE(q.pop(x));
+  REQUIRE(x == 42);
+  REQUIRE_FALSE(q.pop(x));
+}
+
+TEST_CASE("Producer/consumer preserve order under back-pressure", "") {
+  const int N = 10000;
+  falaise::bounded_queue<std::unique_ptr<int>> q{4};
+
+  std::thread producer{[&q] {
+    for (int i = 0; i < N; ++i) {
+      q.push(std::unique_ptr<int>{new int{i}});
+    }
+    q.close();
+  }};
+
+  std::vector<int> received;
+  std::unique_ptr<int> item;
+  while (q.pop(item)) {
+    received.push_back(*item);
+    REQUIRE(q.size() <= q.capacity());
+  }
+  producer.join();
+
+  REQUIRE(received.size() == N);
+  for (int i = 0; i < N; ++i) {
+    REQUIRE(received[i] == i);
+  }
+}
+
+TEST_CASE("Closing wakes up a blocked producer", "") {
+  falaise::bounded_queue<int> q{1};
+  REQUIRE(q.push(0));
+
+  bool accepted = true;
+  std::thread producer{[&q, &accepted] { accepted = q.push(1); }};
+  q.close();
+  producer.join();
+  REQUIRE_FALSE(accepted);
+}
@@ -0,0 +1,140 @@
+#include "catch.hpp"
+
+#include "falaise/ordered_workers.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+//! Item recording the worker that processed it
+struct item {
+  int value = 0;
+  int worker = -1;
+};
+
+//! Pass n items through the pool, retrieving them as soon as it is full
+std::vector<item> run(falaise::ordered_workers<item>& pool, int n) {
+  std::vector<item> done;
+  item x;
+  for (int i = 0; i < n; ++i) {
+    if (pool.in_flight() == pool.capacity()) {
+      REQUIRE(pool.next(x));
+      done.push_back(x);
+    }
+    x = item{};
+    x.value = i;
+    REQUIRE(pool.submitted() == static_cast<std::size_t>(i));
+    REQUIRE(pool.submit(std::move(x)) == static_cast<std::size_t>(i));
+  }
+  while (pool.next(x)) {
+    done.push_back(x);
+  }
+  return done;
+}
+}  // namespace
+
+TEST_CASE("Zero workers or depth are rejected", "") {
+  auto task = [](std::size_t, item&) {};
+  REQUIRE_THROWS_AS(falaise::ordered_workers<item>(0, 2, task), std::invalid_argument);
+  REQUIRE_THROWS_AS(falaise::ordered_workers<item>(2, 0, task), std::invalid_argument);
+}
+
+TEST_CASE("Items are delivered in submission order", "") {
+  const int N = 2000;
+  for (std::size_t nworkers : {1, 2, 3, 8}) {
+    // Random processing times shuffle the completion order
+    falaise::ordered_workers<item> pool{nworkers, 2, [](std::size_t worker, item& x) {
+                                          thread_local std::mt19937 rng{std::random_device{}()};
+                                          std::uniform_int_distribution<int> delay{0, 50};
+                                          std::this_thread::sleep_for(
+                                              std::chrono::microseconds{delay(rng)});
+                                          x.worker = static_cast<int>(worker);
+                                          x.value *= 3;
+                                        }};
+    REQUIRE(pool.size() == nworkers);
+    REQUIRE(pool.capacity() == 2 * nworkers);
+
+    const std::vector<item> done = run(pool, N);
+    REQUIRE(done.size() == static_cast<std::size_t>(N));
+    for (int i = 0; i < N; ++i) {
+      REQUIRE(done[i].value == 3 * i);
+      // Item i always goes to the same worker
+      REQUIRE(done[i].worker == static_cast<int>(i % nworkers));
+    }
+    REQUIRE(pool.in_flight() == 0);
+  }
+}
+
+TEST_CASE("Too many items in flight are rejected", "") {
+  falaise::ordered_workers<item> pool{2, 1, [](std::size_t, item&) {}};
+  REQUIRE(pool.submit(item{}) == 0);
+  REQUIRE(pool.submit(item{}) == 1);
+  REQUIRE_THROWS_AS(pool.submit(item{}), std::logic_error);
+  item x;
+  REQUIRE(pool.next(x));
+  REQUIRE(pool.submit(item{}) == 2);
+}
+
+TEST_CASE("Task exceptions are rethrown in order", "") {
+  falaise::ordered_workers<item> pool{3, 2, [](std::size_t, item& x) {
+                                        if (x.value % 5 == 2) {
+                                          throw std::runtime_error("bad item");
+                                        }
+                                        x.value = -x.value;
+                                      }};
+  for (int i = 0; i < 6; ++i) {
+    item x;
+    x.value = i;
+    pool.submit(std::move(x));
+  }
+  item x;
+  REQUIRE(pool.next(x));
+  REQUIRE(x.value == 0);
+  REQUIRE(pool.next(x));
+  REQUIRE(x.value == -1);
+  // The failed item is consumed and the following ones are still delivered
+  REQUIRE_THROWS_AS(pool.next(x), std::runtime_error);
+  for (int i = 3; i < 6; ++i) {
+    REQUIRE(pool.next(x));
+    REQUIRE(x.value == -i);
+  }
+  REQUIRE_FALSE(pool.next(x));
+}
+
+TEST_CASE("Stopped workers deliver the queued items unprocessed", "") {
+  std::atomic<bool> started{false};
+  std::atomic<bool> release{false};
+  falaise::ordered_workers<item> pool{1, 4, [&started, &release](std::size_t, item& x) {
+                                        started = true;
+                                        while (!release) {
+                                          std::this_thread::yield();
+                                        }
+                                        x.worker = 0;
+                                      }};
+  for (int i = 0; i < 4; ++i) {
+    item x;
+    x.value = i;
+    pool.submit(std::move(x));
+  }
+  // Stop while the first item is being processed
+  while (!started) {
+    std::this_thread::yield();
+  }
+  std::thread stopper{[&pool] { pool.stop(); }};
+  std::this_thread::sleep_for(std::chrono::milliseconds{100});
+  release = true;
+  stopper.join();
+
+  item x;
+  for (int i = 0; i < 4; ++i) {
+    REQUIRE(pool.next(x));
+    REQUIRE(x.value == i);
+    REQUIRE(x.worker == (i == 0 ? 0 : -1));
+  }
+  REQUIRE_FALSE(pool.next(x));
+  REQUIRE_THROWS_AS(pool.submit(item{}), std::logic_error);
+}